@@ -8,6 +8,7 @@ GEO_SRC_DIR = $(SRC)/Geo
 GEO_SOURCES := \
 	$(GEO_SRC_DIR)/Boost/RangeBox.cpp \
 	$(GEO_SRC_DIR)/ConvexHull/GrahamScan.cpp \
+	$(GEO_SRC_DIR)/ConvexHull/IncrementalConvexHull.cpp \
 	$(GEO_SRC_DIR)/ConvexHull/PolygonInterior.cpp \
 	$(GEO_SRC_DIR)/Memento/DistanceMemento.cpp \
 	$(GEO_SRC_DIR)/Memento/GeoVectorMemento.cpp \
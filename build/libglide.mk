@@ -6,6 +6,8 @@ GLIDE_SOURCES = \
 	$(GLIDE_SRC_DIR)/GlueGlideState.cpp \
 	$(GLIDE_SRC_DIR)/GlidePolar.cpp \
 	$(GLIDE_SRC_DIR)/GlideResult.cpp \
+	$(GLIDE_SRC_DIR)/GlideResultCache.cpp \
+	$(GLIDE_SRC_DIR)/GlideBatch.cpp \
 	$(GLIDE_SRC_DIR)/MacCready.cpp \
 	$(GLIDE_SRC_DIR)/InstantSpeed.cpp
 
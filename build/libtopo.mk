@@ -1,5 +1,6 @@
 TOPO_SOURCES = \
 	$(SRC)/Topography/ShapeFile.cpp \
+	$(SRC)/Topography/MappedShapeFile.cpp \
 	$(SRC)/Topography/TopographyFile.cpp \
 	$(SRC)/Topography/TopographyStore.cpp \
 	$(SRC)/Topography/TopographyFileRenderer.cpp \
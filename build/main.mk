@@ -228,6 +228,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/FLARM/Id.cpp \
 	$(SRC)/FLARM/Error.cpp \
 	$(SRC)/FLARM/List.cpp \
+	$(SRC)/FLARM/TrafficStore.cpp \
 	$(SRC)/FLARM/FlarmNetRecord.cpp \
 	$(SRC)/FLARM/FlarmNetDatabase.cpp \
 	$(SRC)/FLARM/FlarmNetReader.cpp \
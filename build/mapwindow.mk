@@ -32,6 +32,7 @@ LIBMAPWINDOW_SOURCES = \
 
 ifeq ($(OPENGL),y)
 LIBMAPWINDOW_SOURCES += \
+	$(SRC)/MapWindow/LayerCache.cpp \
 	$(SRC)/MapWindow/OverlayBitmap.cpp
 endif
 
@@ -76,6 +76,9 @@ TEST_NAMES = \
 	test_pressure \
 	test_task \
 	TestOverwritingRingBuffer \
+	TestBoundedMPSCQueue \
+	TestWorkerPool \
+	TestJobGraph \
 	TestDateTime TestRoughTime TestWrapClock \
 	TestPolylineDecoder \
 	TestTransponderCode \
@@ -90,12 +93,15 @@ TEST_NAMES = \
 	TestLogger TestGRecord TestClimbAvCalc \
 	TestWaypointReader TestThermalBase \
 	TestFlarmNet \
+	TestTrafficList \
 	TestColorRamp TestGeoPoint TestDiffFilter \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
 	TestMacCready TestOrderedTask TestAATPoint TestTaskSave\
 	TestPlanes \
 	TestTaskPoint \
+	TestSampledTaskPoint \
+	TestTaskDijkstra \
 	TestTaskWaypoint \
 	TestTeamCode \
 	TestZeroFinder \
@@ -163,6 +169,24 @@ TEST_OVERWRITING_RING_BUFFER_SOURCES = \
 TEST_OVERWRITING_RING_BUFFER_DEPENDS = MATH
 $(eval $(call link-program,TestOverwritingRingBuffer,TEST_OVERWRITING_RING_BUFFER))
 
+TEST_BOUNDED_MPSC_QUEUE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestBoundedMPSCQueue.cpp
+TEST_BOUNDED_MPSC_QUEUE_DEPENDS = THREAD
+$(eval $(call link-program,TestBoundedMPSCQueue,TEST_BOUNDED_MPSC_QUEUE))
+
+TEST_WORKER_POOL_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestWorkerPool.cpp
+TEST_WORKER_POOL_DEPENDS = THREAD
+$(eval $(call link-program,TestWorkerPool,TEST_WORKER_POOL))
+
+TEST_JOB_GRAPH_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestJobGraph.cpp
+TEST_JOB_GRAPH_DEPENDS = THREAD
+$(eval $(call link-program,TestJobGraph,TEST_JOB_GRAPH))
+
 TEST_IGC_PARSER_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -290,6 +314,18 @@ TEST_TASKPOINT_SOURCES = \
 TEST_TASKPOINT_DEPENDS = IO OS TASK GEO MATH
 $(eval $(call link-program,TestTaskPoint,TEST_TASKPOINT))
 
+TEST_SAMPLED_TASKPOINT_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSampledTaskPoint.cpp
+TEST_SAMPLED_TASKPOINT_DEPENDS = TASK GEO MATH
+$(eval $(call link-program,TestSampledTaskPoint,TEST_SAMPLED_TASKPOINT))
+
+TEST_TASK_DIJKSTRA_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTaskDijkstra.cpp
+TEST_TASK_DIJKSTRA_DEPENDS = TASK GEO MATH
+$(eval $(call link-program,TestTaskDijkstra,TEST_TASK_DIJKSTRA))
+
 TEST_TASKWAYPOINT_SOURCES = \
 	$(ENGINE_SRC_DIR)/Waypoint/Waypoint.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -405,9 +441,17 @@ TEST_FLARM_NET_SOURCES = \
 	$(SRC)/FLARM/FlarmNetDatabase.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestFlarmNet.cpp
-TEST_FLARM_NET_DEPENDS = IO OS MATH UTIL
+TEST_FLARM_NET_DEPENDS = IO OS MATH UTIL FMT
 $(eval $(call link-program,TestFlarmNet,TEST_FLARM_NET))
 
+TEST_TRAFFIC_LIST_SOURCES = \
+	$(SRC)/FLARM/Id.cpp \
+	$(SRC)/FLARM/TrafficStore.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTrafficList.cpp
+TEST_TRAFFIC_LIST_DEPENDS = MATH UTIL FMT
+$(eval $(call link-program,TestTrafficList,TEST_TRAFFIC_LIST))
+
 TEST_GEO_CLIP_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestGeoClip.cpp
@@ -519,8 +563,10 @@ TEST_POLARS_DEPENDS = IO OS MATH UTIL UNITS
 $(eval $(call link-program,TestPolars,TEST_POLARS))
 
 TEST_GLIDE_POLAR_SOURCES = \
+	$(ENGINE_SRC_DIR)/GlideSolvers/GlideBatch.cpp \
 	$(ENGINE_SRC_DIR)/GlideSolvers/GlidePolar.cpp \
 	$(ENGINE_SRC_DIR)/GlideSolvers/GlideResult.cpp \
+	$(ENGINE_SRC_DIR)/GlideSolvers/GlideSettings.cpp \
 	$(ENGINE_SRC_DIR)/GlideSolvers/GlideState.cpp \
 	$(ENGINE_SRC_DIR)/GlideSolvers/MacCready.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -714,6 +760,8 @@ DEBUG_PROGRAM_NAMES = \
 	FlightTable \
 	BenchmarkProjection \
 	BenchmarkFAITriangleSector \
+	BenchmarkWaypoints \
+	BenchmarkAAT \
 	DumpTextInflate \
 	DumpHexColor \
 	RunXMLParser \
@@ -755,6 +803,7 @@ DEBUG_PROGRAM_NAMES += \
 	RunCirclingWind RunWindEKF RunWindComputer \
 	RunExternalWind \
 	RunTask \
+	BenchmarkReplay \
 	LoadImage ViewImage \
 	RunCanvas RunMapWindow \
 	RunListControl \
@@ -785,12 +834,16 @@ endif
 ifeq ($(TARGET),UNIX)
 DEBUG_PROGRAM_NAMES += \
 	AnalyseFlight \
-	FeedFlyNetData
+	FeedFlyNetData \
+	FeedFlarmTraffic \
+	RunCloudLoad \
+	BenchmarkCloudClients
 endif
 
 ifeq ($(TARGET),PC)
 DEBUG_PROGRAM_NAMES += \
-  FeedFlyNetData
+  FeedFlyNetData \
+  FeedFlarmTraffic
 endif
 
 ifeq ($(HAVE_HTTP)$(TARGET_IS_ANDROID),yn)
@@ -879,6 +932,43 @@ BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 BENCHMARK_FAI_TRIANGLE_SECTOR_DEPENDS = GEO MATH
 $(eval $(call link-program,BenchmarkFAITriangleSector,BENCHMARK_FAI_TRIANGLE_SECTOR))
 
+BENCHMARK_WAYPOINTS_SOURCES = \
+	$(TEST_SRC_DIR)/BenchmarkWaypoints.cpp
+BENCHMARK_WAYPOINTS_DEPENDS = WAYPOINT GEO MATH UTIL
+$(eval $(call link-program,BenchmarkWaypoints,BENCHMARK_WAYPOINTS))
+
+$(eval $(call link-harness-program,BenchmarkAAT))
+
+BENCHMARK_REPLAY_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/TransponderCode.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(TEST_SRC_DIR)/BenchmarkReplay.cpp
+BENCHMARK_REPLAY_DEPENDS = TASKFILE WAYPOINTFILE ROUTE TERRAIN AIRSPACE CONTEST TASK WAYPOINT GLIDE OPERATION $(DEBUG_REPLAY_DEPENDS) ZZIP GEO MATH UTIL UNITS
+$(eval $(call link-program,BenchmarkReplay,BENCHMARK_REPLAY))
+
+BENCHMARK_DATA_DIR = $(topdir)/test/data
+BENCHMARK_REPLAY_FILES = \
+	$(BENCHMARK_DATA_DIR)/01lz1hq1.igc \
+	$(BENCHMARK_DATA_DIR)/0asljd01.igc \
+	$(BENCHMARK_DATA_DIR)/9crx3101.igc \
+	$(BENCHMARK_DATA_DIR)/apf-bug554.igc
+
+# replay the test flights through the task engine and write the cost
+# of each component per fix to $(OUT)/test/benchmark.jsonl
+benchmark: $(call name-to-bin,BenchmarkReplay) | $(OUT)/test/dirstamp
+	@$(NQ)echo "  BENCH   $(OUT)/test/benchmark.jsonl"
+	$(Q)$< $(BENCHMARK_DATA_DIR)/benalla9.xcm \
+		$(BENCHMARK_DATA_DIR)/AirspaceAus-DAA.txt \
+		$(BENCHMARK_REPLAY_FILES) >$(OUT)/test/benchmark.jsonl
+
 DUMP_TEXT_FILE_SOURCES = \
 	$(TEST_SRC_DIR)/DumpTextFile.cpp
 DUMP_TEXT_FILE_DEPENDS = IO OS ZZIP UTIL
@@ -2350,6 +2440,33 @@ FEED_FLYNET_DATA_DEPENDS = PORT ASYNC LIBNET OPERATION IO OS THREAD TIME UTIL
 
 $(eval $(call link-program,FeedFlyNetData,FEED_FLYNET_DATA))
 
+FEED_FLARM_TRAFFIC_SOURCES = \
+	$(SRC)/Device/Port/ConfiguredPort.cpp \
+	$(SRC)/Device/Config.cpp \
+	$(SRC)/Device/Util/NMEAWriter.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/DebugPort.cpp \
+	$(TEST_SRC_DIR)/FeedFlarmTraffic.cpp
+FEED_FLARM_TRAFFIC_DEPENDS = PORT ASYNC LIBNET OPERATION IO OS THREAD TIME MATH UTIL
+$(eval $(call link-program,FeedFlarmTraffic,FEED_FLARM_TRAFFIC))
+
+RUN_CLOUD_LOAD_SOURCES = \
+	$(SRC)/Tracking/SkyLines/Assemble.cpp \
+	$(TEST_SRC_DIR)/RunCloudLoad.cpp
+RUN_CLOUD_LOAD_DEPENDS = ASYNC LIBNET IO OS GEO MATH UTIL
+$(eval $(call link-program,RunCloudLoad,RUN_CLOUD_LOAD))
+
+BENCHMARK_CLOUD_CLIENTS_SOURCES = \
+	$(SRC)/Tracking/SkyLines/Assemble.cpp \
+	$(SRC)/Cloud/Serialiser.cpp \
+	$(SRC)/Cloud/Client.cpp \
+	$(TEST_SRC_DIR)/BenchmarkCloudClients.cpp
+BENCHMARK_CLOUD_CLIENTS_DEPENDS = LIBNET IO OS GEO MATH UTIL
+$(eval $(call link-program,BenchmarkCloudClients,BENCHMARK_CLOUD_CLIENTS))
+
 TASK_INFO_SOURCES = \
 	$(SRC)/Engine/Util/Gradient.cpp \
 	$(SRC)/Task/ValidationErrorStrings.cpp \
@@ -2375,7 +2492,7 @@ DUMP_FLARM_NET_SOURCES = \
 	$(SRC)/FLARM/FlarmNetRecord.cpp \
 	$(SRC)/FLARM/FlarmNetDatabase.cpp \
 	$(TEST_SRC_DIR)/DumpFlarmNet.cpp
-DUMP_FLARM_NET_DEPENDS = IO OS MATH UTIL
+DUMP_FLARM_NET_DEPENDS = IO OS MATH UTIL FMT
 $(eval $(call link-program,DumpFlarmNet,DUMP_FLARM_NET))
 
 IGC2NMEA_SOURCES = \
@@ -63,7 +63,7 @@ LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
 {
   try {
     TopoInput input({data, size});
-    TopographyFile file(nullptr, input.name.c_str(),
+    TopographyFile file(nullptr, {}, input.name.c_str(),
                         1, 1, 1,
                         {});
   } catch (...) {
@@ -0,0 +1,250 @@
+MAKE_RESOURCE(IDB_ABORT, mode_abort_96, 100);
+MAKE_RESOURCE(IDB_ABORT_HD, mode_abort_160, 101);
+MAKE_RESOURCE(IDB_ABORT_UHD, mode_abort_300, 102);
+#define IDB_ABORT_ALL IDB_ABORT, IDB_ABORT_HD, IDB_ABORT_UHD
+MAKE_RESOURCE(IDB_AIRPORT_REACHABLE, alt_reachable_airport_96, 103);
+MAKE_RESOURCE(IDB_AIRPORT_REACHABLE_HD, alt_reachable_airport_160, 104);
+MAKE_RESOURCE(IDB_AIRPORT_REACHABLE_UHD, alt_reachable_airport_300, 105);
+#define IDB_AIRPORT_REACHABLE_ALL IDB_AIRPORT_REACHABLE, IDB_AIRPORT_REACHABLE_HD, IDB_AIRPORT_REACHABLE_UHD
+MAKE_RESOURCE(IDB_AIRPORT_MARGINAL, alt_marginal_airport_96, 106);
+MAKE_RESOURCE(IDB_AIRPORT_MARGINAL_HD, alt_marginal_airport_160, 107);
+MAKE_RESOURCE(IDB_AIRPORT_MARGINAL_UHD, alt_marginal_airport_300, 108);
+#define IDB_AIRPORT_MARGINAL_ALL IDB_AIRPORT_MARGINAL, IDB_AIRPORT_MARGINAL_HD, IDB_AIRPORT_MARGINAL_UHD
+MAKE_RESOURCE(IDB_AIRPORT_UNREACHABLE, alt_landable_airport_96, 109);
+MAKE_RESOURCE(IDB_AIRPORT_UNREACHABLE_HD, alt_landable_airport_160, 110);
+MAKE_RESOURCE(IDB_AIRPORT_UNREACHABLE_UHD, alt_landable_airport_300, 111);
+#define IDB_AIRPORT_UNREACHABLE_ALL IDB_AIRPORT_UNREACHABLE, IDB_AIRPORT_UNREACHABLE_HD, IDB_AIRPORT_UNREACHABLE_UHD
+MAKE_RESOURCE(IDB_AIRPORT_MARGINAL2, alt2_marginal_airport_96, 112);
+MAKE_RESOURCE(IDB_AIRPORT_MARGINAL2_HD, alt2_marginal_airport_160, 113);
+MAKE_RESOURCE(IDB_AIRPORT_MARGINAL2_UHD, alt2_marginal_airport_300, 114);
+#define IDB_AIRPORT_MARGINAL2_ALL IDB_AIRPORT_MARGINAL2, IDB_AIRPORT_MARGINAL2_HD, IDB_AIRPORT_MARGINAL2_UHD
+MAKE_RESOURCE(IDB_AIRPORT_UNREACHABLE2, alt2_landable_airport_96, 115);
+MAKE_RESOURCE(IDB_AIRPORT_UNREACHABLE2_HD, alt2_landable_airport_160, 116);
+MAKE_RESOURCE(IDB_AIRPORT_UNREACHABLE2_UHD, alt2_landable_airport_300, 117);
+#define IDB_AIRPORT_UNREACHABLE2_ALL IDB_AIRPORT_UNREACHABLE2, IDB_AIRPORT_UNREACHABLE2_HD, IDB_AIRPORT_UNREACHABLE2_UHD
+MAKE_RESOURCE(IDB_AIRSPACEI, airspace_intercept_96, 118);
+MAKE_RESOURCE(IDB_AIRSPACEI_HD, airspace_intercept_160, 119);
+MAKE_RESOURCE(IDB_AIRSPACEI_UHD, airspace_intercept_300, 120);
+#define IDB_AIRSPACEI_ALL IDB_AIRSPACEI, IDB_AIRSPACEI_HD, IDB_AIRSPACEI_UHD
+MAKE_RESOURCE(IDB_CRUISE, mode_cruise_96, 121);
+MAKE_RESOURCE(IDB_CRUISE_HD, mode_cruise_160, 122);
+MAKE_RESOURCE(IDB_CRUISE_UHD, mode_cruise_300, 123);
+#define IDB_CRUISE_ALL IDB_CRUISE, IDB_CRUISE_HD, IDB_CRUISE_UHD
+MAKE_RESOURCE(IDB_CLIMB, mode_climb_96, 124);
+MAKE_RESOURCE(IDB_CLIMB_HD, mode_climb_160, 125);
+MAKE_RESOURCE(IDB_CLIMB_UHD, mode_climb_300, 126);
+#define IDB_CLIMB_ALL IDB_CLIMB, IDB_CLIMB_HD, IDB_CLIMB_UHD
+MAKE_RESOURCE(IDB_CLIMBSMALL, climb_12, 127);
+MAKE_RESOURCE(IDB_CLIMBSMALLINV, climb_12inv, 128);
+MAKE_RESOURCE(IDB_FOLDER, folder_96, 129);
+MAKE_RESOURCE(IDB_FOLDER_HD, folder_160, 130);
+MAKE_RESOURCE(IDB_FOLDER_UHD, folder_300, 131);
+#define IDB_FOLDER_ALL IDB_FOLDER, IDB_FOLDER_HD, IDB_FOLDER_UHD
+MAKE_RESOURCE(IDB_SETTINGS, settings_96, 132);
+MAKE_RESOURCE(IDB_SETTINGS_HD, settings_160, 133);
+MAKE_RESOURCE(IDB_SETTINGS_UHD, settings_300, 134);
+#define IDB_SETTINGS_ALL IDB_SETTINGS, IDB_SETTINGS_HD, IDB_SETTINGS_UHD
+MAKE_RESOURCE(IDB_TASK, task_96, 135);
+MAKE_RESOURCE(IDB_TASK_HD, task_160, 136);
+MAKE_RESOURCE(IDB_TASK_UHD, task_300, 137);
+#define IDB_TASK_ALL IDB_TASK, IDB_TASK_HD, IDB_TASK_UHD
+MAKE_RESOURCE(IDB_CALCULATOR, calculator_96, 138);
+MAKE_RESOURCE(IDB_CALCULATOR_HD, calculator_160, 139);
+MAKE_RESOURCE(IDB_CALCULATOR_UHD, calculator_300, 140);
+#define IDB_CALCULATOR_ALL IDB_CALCULATOR, IDB_CALCULATOR_HD, IDB_CALCULATOR_UHD
+MAKE_RESOURCE(IDB_WRENCH, wrench_96, 141);
+MAKE_RESOURCE(IDB_WRENCH_HD, wrench_160, 142);
+MAKE_RESOURCE(IDB_WRENCH_UHD, wrench_300, 143);
+#define IDB_WRENCH_ALL IDB_WRENCH, IDB_WRENCH_HD, IDB_WRENCH_UHD
+MAKE_RESOURCE(IDB_GLOBE, globe_96, 144);
+MAKE_RESOURCE(IDB_GLOBE_HD, globe_160, 145);
+MAKE_RESOURCE(IDB_GLOBE_UHD, globe_300, 146);
+#define IDB_GLOBE_ALL IDB_GLOBE, IDB_GLOBE_HD, IDB_GLOBE_UHD
+MAKE_RESOURCE(IDB_DEVICE, device_96, 147);
+MAKE_RESOURCE(IDB_DEVICE_HD, device_160, 148);
+MAKE_RESOURCE(IDB_DEVICE_UHD, device_300, 149);
+#define IDB_DEVICE_ALL IDB_DEVICE, IDB_DEVICE_HD, IDB_DEVICE_UHD
+MAKE_RESOURCE(IDB_RULES, rules_96, 150);
+MAKE_RESOURCE(IDB_RULES_HD, rules_160, 151);
+MAKE_RESOURCE(IDB_RULES_UHD, rules_300, 152);
+#define IDB_RULES_ALL IDB_RULES, IDB_RULES_HD, IDB_RULES_UHD
+MAKE_RESOURCE(IDB_CLOCK, clock_96, 153);
+MAKE_RESOURCE(IDB_CLOCK_HD, clock_160, 154);
+MAKE_RESOURCE(IDB_CLOCK_UHD, clock_300, 155);
+#define IDB_CLOCK_ALL IDB_CLOCK, IDB_CLOCK_HD, IDB_CLOCK_UHD
+MAKE_RESOURCE(IDB_DIALOGTITLE, dialog_title_red, 156);
+MAKE_RESOURCE(IDB_FINALGLIDE, mode_finalglide_96, 157);
+MAKE_RESOURCE(IDB_FINALGLIDE_HD, mode_finalglide_160, 158);
+MAKE_RESOURCE(IDB_FINALGLIDE_UHD, mode_finalglide_300, 159);
+#define IDB_FINALGLIDE_ALL IDB_FINALGLIDE, IDB_FINALGLIDE_HD, IDB_FINALGLIDE_UHD
+MAKE_RESOURCE(IDB_TRAFFIC_SAFE, flarm_traffic_96, 160);
+MAKE_RESOURCE(IDB_TRAFFIC_SAFE_HD, flarm_traffic_160, 161);
+MAKE_RESOURCE(IDB_TRAFFIC_SAFE_UHD, flarm_traffic_300, 162);
+#define IDB_TRAFFIC_SAFE_ALL IDB_TRAFFIC_SAFE, IDB_TRAFFIC_SAFE_HD, IDB_TRAFFIC_SAFE_UHD
+MAKE_RESOURCE(IDB_TRAFFIC_WARNING, flarm_warning_96, 163);
+MAKE_RESOURCE(IDB_TRAFFIC_WARNING_HD, flarm_warning_160, 164);
+MAKE_RESOURCE(IDB_TRAFFIC_WARNING_UHD, flarm_warning_300, 165);
+#define IDB_TRAFFIC_WARNING_ALL IDB_TRAFFIC_WARNING, IDB_TRAFFIC_WARNING_HD, IDB_TRAFFIC_WARNING_UHD
+MAKE_RESOURCE(IDB_TRAFFIC_ALARM, flarm_alarm_96, 166);
+MAKE_RESOURCE(IDB_TRAFFIC_ALARM_HD, flarm_alarm_160, 167);
+MAKE_RESOURCE(IDB_TRAFFIC_ALARM_UHD, flarm_alarm_300, 168);
+#define IDB_TRAFFIC_ALARM_ALL IDB_TRAFFIC_ALARM, IDB_TRAFFIC_ALARM_HD, IDB_TRAFFIC_ALARM_UHD
+MAKE_RESOURCE(IDB_GPSSTATUS1, gps_acquiring_96, 169);
+MAKE_RESOURCE(IDB_GPSSTATUS1_HD, gps_acquiring_160, 170);
+MAKE_RESOURCE(IDB_GPSSTATUS1_UHD, gps_acquiring_300, 171);
+#define IDB_GPSSTATUS1_ALL IDB_GPSSTATUS1, IDB_GPSSTATUS1_HD, IDB_GPSSTATUS1_UHD
+MAKE_RESOURCE(IDB_GPSSTATUS2, gps_disconnected_96, 172);
+MAKE_RESOURCE(IDB_GPSSTATUS2_HD, gps_disconnected_160, 173);
+MAKE_RESOURCE(IDB_GPSSTATUS2_UHD, gps_disconnected_300, 174);
+#define IDB_GPSSTATUS2_ALL IDB_GPSSTATUS2, IDB_GPSSTATUS2_HD, IDB_GPSSTATUS2_UHD
+MAKE_RESOURCE(IDB_LANDABLE, winpilot_landable_96, 175);
+MAKE_RESOURCE(IDB_LANDABLE_HD, winpilot_landable_160, 176);
+MAKE_RESOURCE(IDB_LANDABLE_UHD, winpilot_landable_300, 177);
+#define IDB_LANDABLE_ALL IDB_LANDABLE, IDB_LANDABLE_HD, IDB_LANDABLE_UHD
+MAKE_RESOURCE(IDB_LAUNCHER1, launcher_red_640_1, 178);
+MAKE_RESOURCE(IDB_LAUNCHER2, launcher_red_640_2, 179);
+MAKE_RESOURCE(IDB_MAPSCALE_LEFT, scalearrow_left_96, 180);
+MAKE_RESOURCE(IDB_MAPSCALE_LEFT_HD, scalearrow_left_160, 181);
+MAKE_RESOURCE(IDB_MAPSCALE_LEFT_UHD, scalearrow_left_300, 182);
+#define IDB_MAPSCALE_LEFT_ALL IDB_MAPSCALE_LEFT, IDB_MAPSCALE_LEFT_HD, IDB_MAPSCALE_LEFT_UHD
+MAKE_RESOURCE(IDB_MAPSCALE_RIGHT, scalearrow_right_96, 183);
+MAKE_RESOURCE(IDB_MAPSCALE_RIGHT_HD, scalearrow_right_160, 184);
+MAKE_RESOURCE(IDB_MAPSCALE_RIGHT_UHD, scalearrow_right_300, 185);
+#define IDB_MAPSCALE_RIGHT_ALL IDB_MAPSCALE_RIGHT, IDB_MAPSCALE_RIGHT_HD, IDB_MAPSCALE_RIGHT_UHD
+MAKE_RESOURCE(IDB_MARK, map_flag_96, 186);
+MAKE_RESOURCE(IDB_MARK_HD, map_flag_160, 187);
+MAKE_RESOURCE(IDB_MARK_UHD, map_flag_300, 188);
+#define IDB_MARK_ALL IDB_MARK, IDB_MARK_HD, IDB_MARK_UHD
+MAKE_RESOURCE(IDB_OBSTACLE, map_obstacle_96, 189);
+MAKE_RESOURCE(IDB_OBSTACLE_HD, map_obstacle_160, 190);
+MAKE_RESOURCE(IDB_OBSTACLE_UHD, map_obstacle_300, 191);
+#define IDB_OBSTACLE_ALL IDB_OBSTACLE, IDB_OBSTACLE_HD, IDB_OBSTACLE_UHD
+MAKE_RESOURCE(IDB_OUTFIELD_REACHABLE, alt_reachable_field_96, 192);
+MAKE_RESOURCE(IDB_OUTFIELD_REACHABLE_HD, alt_reachable_field_160, 193);
+MAKE_RESOURCE(IDB_OUTFIELD_REACHABLE_UHD, alt_reachable_field_300, 194);
+#define IDB_OUTFIELD_REACHABLE_ALL IDB_OUTFIELD_REACHABLE, IDB_OUTFIELD_REACHABLE_HD, IDB_OUTFIELD_REACHABLE_UHD
+MAKE_RESOURCE(IDB_OUTFIELD_MARGINAL, alt_marginal_field_96, 195);
+MAKE_RESOURCE(IDB_OUTFIELD_MARGINAL_HD, alt_marginal_field_160, 196);
+MAKE_RESOURCE(IDB_OUTFIELD_MARGINAL_UHD, alt_marginal_field_300, 197);
+#define IDB_OUTFIELD_MARGINAL_ALL IDB_OUTFIELD_MARGINAL, IDB_OUTFIELD_MARGINAL_HD, IDB_OUTFIELD_MARGINAL_UHD
+MAKE_RESOURCE(IDB_OUTFIELD_UNREACHABLE, alt_landable_field_96, 198);
+MAKE_RESOURCE(IDB_OUTFIELD_UNREACHABLE_HD, alt_landable_field_160, 199);
+MAKE_RESOURCE(IDB_OUTFIELD_UNREACHABLE_UHD, alt_landable_field_300, 200);
+#define IDB_OUTFIELD_UNREACHABLE_ALL IDB_OUTFIELD_UNREACHABLE, IDB_OUTFIELD_UNREACHABLE_HD, IDB_OUTFIELD_UNREACHABLE_UHD
+MAKE_RESOURCE(IDB_OUTFIELD_MARGINAL2, alt2_marginal_field_96, 201);
+MAKE_RESOURCE(IDB_OUTFIELD_MARGINAL2_HD, alt2_marginal_field_160, 202);
+MAKE_RESOURCE(IDB_OUTFIELD_MARGINAL2_UHD, alt2_marginal_field_300, 203);
+#define IDB_OUTFIELD_MARGINAL2_ALL IDB_OUTFIELD_MARGINAL2, IDB_OUTFIELD_MARGINAL2_HD, IDB_OUTFIELD_MARGINAL2_UHD
+MAKE_RESOURCE(IDB_OUTFIELD_UNREACHABLE2, alt2_landable_field_96, 204);
+MAKE_RESOURCE(IDB_OUTFIELD_UNREACHABLE2_HD, alt2_landable_field_160, 205);
+MAKE_RESOURCE(IDB_OUTFIELD_UNREACHABLE2_UHD, alt2_landable_field_300, 206);
+#define IDB_OUTFIELD_UNREACHABLE2_ALL IDB_OUTFIELD_UNREACHABLE2, IDB_OUTFIELD_UNREACHABLE2_HD, IDB_OUTFIELD_UNREACHABLE2_UHD
+MAKE_RESOURCE(IDB_MOUNTAIN_PASS, map_pass_96, 207);
+MAKE_RESOURCE(IDB_MOUNTAIN_PASS_HD, map_pass_160, 208);
+MAKE_RESOURCE(IDB_MOUNTAIN_PASS_UHD, map_pass_300, 209);
+#define IDB_MOUNTAIN_PASS_ALL IDB_MOUNTAIN_PASS, IDB_MOUNTAIN_PASS_HD, IDB_MOUNTAIN_PASS_UHD
+MAKE_RESOURCE(IDB_PROGRESSBORDER, progress_border_red, 210);
+MAKE_RESOURCE(IDB_REACHABLE, winpilot_reachable_96, 211);
+MAKE_RESOURCE(IDB_REACHABLE_HD, winpilot_reachable_160, 212);
+MAKE_RESOURCE(IDB_REACHABLE_UHD, winpilot_reachable_300, 213);
+#define IDB_REACHABLE_ALL IDB_REACHABLE, IDB_REACHABLE_HD, IDB_REACHABLE_UHD
+MAKE_RESOURCE(IDB_MARGINAL, winpilot_marginal_96, 214);
+MAKE_RESOURCE(IDB_MARGINAL_HD, winpilot_marginal_160, 215);
+MAKE_RESOURCE(IDB_MARGINAL_UHD, winpilot_marginal_300, 216);
+#define IDB_MARGINAL_ALL IDB_MARGINAL, IDB_MARGINAL_HD, IDB_MARGINAL_UHD
+MAKE_RESOURCE(IDB_SMALL, map_small_96, 217);
+MAKE_RESOURCE(IDB_SMALL_HD, map_small_160, 218);
+MAKE_RESOURCE(IDB_SMALL_UHD, map_small_300, 219);
+#define IDB_SMALL_ALL IDB_SMALL, IDB_SMALL_HD, IDB_SMALL_UHD
+MAKE_RESOURCE(IDB_LOGO_HD, logo_red_160, 220);
+MAKE_RESOURCE(IDB_LOGO, logo_red_80, 221);
+MAKE_RESOURCE(IDB_TARGET, map_target_96, 222);
+MAKE_RESOURCE(IDB_TARGET_HD, map_target_160, 223);
+MAKE_RESOURCE(IDB_TARGET_UHD, map_target_300, 224);
+#define IDB_TARGET_ALL IDB_TARGET, IDB_TARGET_HD, IDB_TARGET_UHD
+MAKE_RESOURCE(IDB_TEAMMATE_POS, map_teammate_96, 225);
+MAKE_RESOURCE(IDB_TEAMMATE_POS_HD, map_teammate_160, 226);
+MAKE_RESOURCE(IDB_TEAMMATE_POS_UHD, map_teammate_300, 227);
+#define IDB_TEAMMATE_POS_ALL IDB_TEAMMATE_POS, IDB_TEAMMATE_POS_HD, IDB_TEAMMATE_POS_UHD
+MAKE_RESOURCE(IDB_TERRAINWARNING, map_terrainw_96, 228);
+MAKE_RESOURCE(IDB_TERRAINWARNING_HD, map_terrainw_160, 229);
+MAKE_RESOURCE(IDB_TERRAINWARNING_UHD, map_terrainw_300, 230);
+#define IDB_TERRAINWARNING_ALL IDB_TERRAINWARNING, IDB_TERRAINWARNING_HD, IDB_TERRAINWARNING_UHD
+MAKE_RESOURCE(IDB_THERMALSOURCE, map_thermal_source_96, 231);
+MAKE_RESOURCE(IDB_THERMALSOURCE_HD, map_thermal_source_160, 232);
+MAKE_RESOURCE(IDB_THERMALSOURCE_UHD, map_thermal_source_300, 233);
+#define IDB_THERMALSOURCE_ALL IDB_THERMALSOURCE, IDB_THERMALSOURCE_HD, IDB_THERMALSOURCE_UHD
+MAKE_RESOURCE(IDB_TOWN, map_town_96, 234);
+MAKE_RESOURCE(IDB_TOWN_HD, map_town_160, 235);
+MAKE_RESOURCE(IDB_TOWN_UHD, map_town_300, 236);
+#define IDB_TOWN_ALL IDB_TOWN, IDB_TOWN_HD, IDB_TOWN_UHD
+MAKE_RESOURCE(IDB_TURNPOINT, map_turnpoint_96, 237);
+MAKE_RESOURCE(IDB_TURNPOINT_HD, map_turnpoint_160, 238);
+MAKE_RESOURCE(IDB_TURNPOINT_UHD, map_turnpoint_300, 239);
+#define IDB_TURNPOINT_ALL IDB_TURNPOINT, IDB_TURNPOINT_HD, IDB_TURNPOINT_UHD
+MAKE_RESOURCE(IDB_TASKTURNPOINT, map_taskturnpoint_96, 240);
+MAKE_RESOURCE(IDB_TASKTURNPOINT_HD, map_taskturnpoint_160, 241);
+MAKE_RESOURCE(IDB_TASKTURNPOINT_UHD, map_taskturnpoint_300, 242);
+#define IDB_TASKTURNPOINT_ALL IDB_TASKTURNPOINT, IDB_TASKTURNPOINT_HD, IDB_TASKTURNPOINT_UHD
+MAKE_RESOURCE(IDB_MOUNTAIN_TOP, map_mountain_top_96, 243);
+MAKE_RESOURCE(IDB_MOUNTAIN_TOP_HD, map_mountain_top_160, 244);
+MAKE_RESOURCE(IDB_MOUNTAIN_TOP_UHD, map_mountain_top_300, 245);
+#define IDB_MOUNTAIN_TOP_ALL IDB_MOUNTAIN_TOP, IDB_MOUNTAIN_TOP_HD, IDB_MOUNTAIN_TOP_UHD
+MAKE_RESOURCE(IDB_BRIDGE, map_bridge_96, 246);
+MAKE_RESOURCE(IDB_BRIDGE_HD, map_bridge_160, 247);
+MAKE_RESOURCE(IDB_BRIDGE_UHD, map_bridge_300, 248);
+#define IDB_BRIDGE_ALL IDB_BRIDGE, IDB_BRIDGE_HD, IDB_BRIDGE_UHD
+MAKE_RESOURCE(IDB_TUNNEL, map_tunnel_96, 249);
+MAKE_RESOURCE(IDB_TUNNEL_HD, map_tunnel_160, 250);
+MAKE_RESOURCE(IDB_TUNNEL_UHD, map_tunnel_300, 251);
+#define IDB_TUNNEL_ALL IDB_TUNNEL, IDB_TUNNEL_HD, IDB_TUNNEL_UHD
+MAKE_RESOURCE(IDB_TOWER, map_tower_96, 252);
+MAKE_RESOURCE(IDB_TOWER_HD, map_tower_160, 253);
+MAKE_RESOURCE(IDB_TOWER_UHD, map_tower_300, 254);
+#define IDB_TOWER_ALL IDB_TOWER, IDB_TOWER_HD, IDB_TOWER_UHD
+MAKE_RESOURCE(IDB_POWER_PLANT, map_power_plant_96, 255);
+MAKE_RESOURCE(IDB_POWER_PLANT_HD, map_power_plant_160, 256);
+MAKE_RESOURCE(IDB_POWER_PLANT_UHD, map_power_plant_300, 257);
+#define IDB_POWER_PLANT_ALL IDB_POWER_PLANT, IDB_POWER_PLANT_HD, IDB_POWER_PLANT_UHD
+MAKE_RESOURCE(IDB_THERMAL_HOTSPOT, map_thermal_hotspot_96, 258);
+MAKE_RESOURCE(IDB_THERMAL_HOTSPOT_HD, map_thermal_hotspot_160, 259);
+MAKE_RESOURCE(IDB_THERMAL_HOTSPOT_UHD, map_thermal_hotspot_300, 260);
+#define IDB_THERMAL_HOTSPOT_ALL IDB_THERMAL_HOTSPOT, IDB_THERMAL_HOTSPOT_HD, IDB_THERMAL_HOTSPOT_UHD
+MAKE_RESOURCE(IDB_VOR, map_vor_96, 261);
+MAKE_RESOURCE(IDB_VOR_HD, map_vor_160, 262);
+MAKE_RESOURCE(IDB_VOR_UHD, map_vor_300, 263);
+#define IDB_VOR_ALL IDB_VOR, IDB_VOR_HD, IDB_VOR_UHD
+MAKE_RESOURCE(IDB_NDB, map_ndb_96, 264);
+MAKE_RESOURCE(IDB_NDB_HD, map_ndb_160, 265);
+MAKE_RESOURCE(IDB_NDB_UHD, map_ndb_300, 266);
+#define IDB_NDB_ALL IDB_NDB, IDB_NDB_HD, IDB_NDB_UHD
+MAKE_RESOURCE(IDB_DAM, map_dam_96, 267);
+MAKE_RESOURCE(IDB_DAM_HD, map_dam_160, 268);
+MAKE_RESOURCE(IDB_DAM_UHD, map_dam_300, 269);
+#define IDB_DAM_ALL IDB_DAM, IDB_DAM_HD, IDB_DAM_UHD
+MAKE_RESOURCE(IDB_CASTLE, map_castle_96, 270);
+MAKE_RESOURCE(IDB_CASTLE_HD, map_castle_160, 271);
+MAKE_RESOURCE(IDB_CASTLE_UHD, map_castle_300, 272);
+#define IDB_CASTLE_ALL IDB_CASTLE, IDB_CASTLE_HD, IDB_CASTLE_UHD
+MAKE_RESOURCE(IDB_INTERSECTION, map_intersection_96, 273);
+MAKE_RESOURCE(IDB_INTERSECTION_HD, map_intersection_160, 274);
+MAKE_RESOURCE(IDB_INTERSECTION_UHD, map_intersection_300, 275);
+#define IDB_INTERSECTION_ALL IDB_INTERSECTION, IDB_INTERSECTION_HD, IDB_INTERSECTION_UHD
+MAKE_RESOURCE(IDB_REPORTING_POINT, map_reporting_point_96, 276);
+MAKE_RESOURCE(IDB_REPORTING_POINT_HD, map_reporting_point_160, 277);
+MAKE_RESOURCE(IDB_REPORTING_POINT_UHD, map_reporting_point_300, 278);
+#define IDB_REPORTING_POINT_ALL IDB_REPORTING_POINT, IDB_REPORTING_POINT_HD, IDB_REPORTING_POINT_UHD
+MAKE_RESOURCE(IDB_PGTAKEOFF, map_pgtakeoff_96, 279);
+MAKE_RESOURCE(IDB_PGTAKEOFF_HD, map_pgtakeoff_160, 280);
+MAKE_RESOURCE(IDB_PGTAKEOFF_UHD, map_pgtakeoff_300, 281);
+#define IDB_PGTAKEOFF_ALL IDB_PGTAKEOFF, IDB_PGTAKEOFF_HD, IDB_PGTAKEOFF_UHD
+MAKE_RESOURCE(IDB_PGLANDING, map_pglanding_96, 282);
+MAKE_RESOURCE(IDB_PGLANDING_HD, map_pglanding_160, 283);
+MAKE_RESOURCE(IDB_PGLANDING_UHD, map_pglanding_300, 284);
+#define IDB_PGLANDING_ALL IDB_PGLANDING, IDB_PGLANDING_HD, IDB_PGLANDING_UHD
+MAKE_RESOURCE(IDB_TITLE, title_red_110, 285);
+MAKE_RESOURCE(IDB_TITLE_HD, title_red_320, 286);
+MAKE_RESOURCE(IDB_WEATHER_STATION, map_weather_station_96, 287);
+MAKE_RESOURCE(IDB_WEATHER_STATION_HD, map_weather_station_160, 288);
+MAKE_RESOURCE(IDB_WEATHER_STATION_UHD, map_weather_station_300, 289);
+#define IDB_WEATHER_STATION_ALL IDB_WEATHER_STATION, IDB_WEATHER_STATION_HD, IDB_WEATHER_STATION_UHD
@@ -24,6 +24,9 @@ DeviceBlackboard::DeviceBlackboard() noexcept
 
   std::fill(per_device_data.begin(), per_device_data.end(), gps_info);
 
+  for (auto &i : per_device_traffic)
+    i.Clear();
+
   real_data = simulator_data = replay_data = gps_info;
 
   simulator.Init(simulator_data);
@@ -186,15 +189,27 @@ DeviceBlackboard::Merge() noexcept
   NMEAInfo &basic = SetBasic();
 
   real_data.Reset();
-  for (auto &basic : per_device_data) {
-    if (!basic.alive)
+  merged_traffic.Clear();
+  for (unsigned i = 0; i < NUMDEV; ++i) {
+    auto &basic = per_device_data[i];
+    auto &traffic = per_device_traffic[i];
+
+    if (!basic.alive) {
+      traffic.Clear();
       continue;
+    }
 
     basic.UpdateClock();
     basic.Expire();
     real_data.Complement(basic);
+
+    traffic.Expire(basic.clock);
+    merged_traffic.Complement(traffic);
   }
 
+  if (merged_traffic.modified)
+    merged_traffic.CopyNearest(real_data.flarm.traffic);
+
   real_clock.Normalise(real_data);
 
   if (replay_data.alive) {
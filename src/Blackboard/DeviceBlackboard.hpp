@@ -7,6 +7,7 @@
 #include "Blackboard/ComputerSettingsBlackboard.hpp"
 #include "Device/Simulator.hpp"
 #include "Device/Features.hpp"
+#include "FLARM/TrafficStore.hpp"
 #include "thread/Mutex.hxx"
 #include "time/WrapClock.hpp"
 
@@ -35,6 +36,20 @@ class DeviceBlackboard
    */
   std::array<NMEAInfo, NUMDEV> per_device_data;
 
+  /**
+   * All FLARM traffic from each physical device.  The NMEA parser
+   * writes here instead of NMEAInfo::flarm::traffic, which has room
+   * only for the nearest targets.
+   */
+  std::array<TrafficStore, NUMDEV> per_device_traffic;
+
+  /**
+   * Merged traffic from the physical devices; Merge() publishes the
+   * most relevant targets in #real_data.  Only used by the
+   * MergeThread.
+   */
+  TrafficStore merged_traffic;
+
   /**
    * Merged data from the physical devices.
    */
@@ -94,6 +109,14 @@ public:
     return per_device_data[i];
   }
 
+  /**
+   * The #TrafficStore of the specified device.  It is protected by
+   * #mutex, just like the device's #NMEAInfo.
+   */
+  TrafficStore &SetRealTraffic(unsigned i) noexcept {
+    return per_device_traffic[i];
+  }
+
   /**
    * Return a copy of a device's data after updating its clock via
    * NMEAInfo::UpdateClock().  The method takes care for locking and
@@ -133,7 +156,8 @@ public:
    */
   [[gnu::pure]]
   bool IsFLARM(unsigned i) const noexcept {
-    return RealState(i).flarm.IsDetected();
+    return RealState(i).flarm.IsDetected() ||
+      !per_device_traffic[i].IsEmpty();
   }
 
   void SetStartupLocation(const GeoPoint &loc, double alt) noexcept;
@@ -10,9 +10,19 @@
 #include "net/AddressInfo.hxx"
 #include "net/Resolver.hxx"
 
-#include <boost/geometry/algorithms/distance.hpp>
-#include <boost/geometry/algorithms/intersection.hpp>
-#include <boost/geometry/strategies/strategies.hpp>
+#include <algorithm>
+#include <cassert>
+
+/**
+ * The size of a grid cell in degrees of latitude and longitude.  In
+ * latitude, this is about the traffic range (50 km), which means a
+ * query for that range visits no more than 3x3 cells (except close to
+ * the poles).
+ */
+static constexpr double GRID_CELL_DEGREES = 0.5;
+
+static constexpr unsigned GRID_WIDTH = 360 / GRID_CELL_DEGREES;
+static constexpr unsigned GRID_HEIGHT = 180 / GRID_CELL_DEGREES;
 
 CloudClientContainer::CloudClientContainer()
   :key_set(typename KeySet::bucket_traits(key_buckets, N_KEY_BUCKETS)) {}
@@ -68,6 +78,52 @@ CloudClientContainer::Refresh(CloudClient &client,
   list.push_front(client);
 }
 
+[[gnu::const]]
+static unsigned
+ToGridX(Angle longitude) noexcept
+{
+  const unsigned x = (longitude.AsDelta().Degrees() + 180) / GRID_CELL_DEGREES;
+  return std::min(x, GRID_WIDTH - 1);
+}
+
+[[gnu::const]]
+static unsigned
+ToGridY(Angle latitude) noexcept
+{
+  const double y = (latitude.Degrees() + 90) / GRID_CELL_DEGREES;
+  return std::min(unsigned(std::max(y, 0.)), GRID_HEIGHT - 1);
+}
+
+[[gnu::const]]
+static uint32_t
+ToGridCell(unsigned x, unsigned y) noexcept
+{
+  return y * GRID_WIDTH + x;
+}
+
+[[gnu::const]]
+static uint32_t
+ToGridCell(GeoPoint location) noexcept
+{
+  return ToGridCell(ToGridX(location.longitude),
+                    ToGridY(location.latitude));
+}
+
+/**
+ * Move the last element of the vector to the given position and
+ * update its #CloudClient::grid_index.
+ */
+static void
+EraseFromGridCell(std::vector<CloudClientPtr> &cell, uint32_t i) noexcept
+{
+  if (i + 1 < cell.size()) {
+    cell[i] = std::move(cell.back());
+    cell[i]->grid_index = i;
+  }
+
+  cell.pop_back();
+}
+
 void
 CloudClientContainer::Refresh(CloudClient &client,
                               SocketAddress address,
@@ -75,14 +131,26 @@ CloudClientContainer::Refresh(CloudClient &client,
 {
   Refresh(client, address);
 
-  if (location != client.location) {
-    auto ptr = client.shared_from_this();
-    rtree.remove(ptr);
-    client.location = location;
-    rtree.insert(ptr);
-  }
-
+  client.location = location;
   client.altitude = altitude;
+
+  const uint32_t new_cell = ToGridCell(location);
+  if (new_cell != client.grid_cell) {
+    /* the client has crossed a cell boundary: move it to the new
+       cell */
+    auto old_cell = grid.find(client.grid_cell);
+    assert(old_cell != grid.end());
+
+    auto ptr = std::move(old_cell->second[client.grid_index]);
+    EraseFromGridCell(old_cell->second, client.grid_index);
+    if (old_cell->second.empty())
+      grid.erase(old_cell);
+
+    auto &cell = grid[new_cell];
+    client.grid_cell = new_cell;
+    client.grid_index = cell.size();
+    cell.push_back(std::move(ptr));
+  }
 }
 
 void
@@ -91,7 +159,11 @@ CloudClientContainer::Insert(CloudClient &client)
   list.push_front(client);
   key_set.insert(client);
   id_set.push_back(client);
-  rtree.insert(client.shared_from_this());
+
+  auto &cell = grid[ToGridCell(client.location)];
+  client.grid_cell = ToGridCell(client.location);
+  client.grid_index = cell.size();
+  cell.push_back(client.shared_from_this());
 }
 
 void
@@ -100,7 +172,14 @@ CloudClientContainer::Remove(CloudClient &client)
   list.erase(list.iterator_to(client));
   key_set.erase(key_set.iterator_to(client));
   id_set.erase(id_set.iterator_to(client));
-  rtree.remove(client.shared_from_this());
+
+  auto cell = grid.find(client.grid_cell);
+  assert(cell != grid.end());
+
+  /* this may delete the client */
+  EraseFromGridCell(cell->second, client.grid_index);
+  if (cell->second.empty())
+    grid.erase(cell);
 }
 
 void
@@ -110,11 +189,78 @@ CloudClientContainer::Expire(std::chrono::steady_clock::time_point before)
     Remove(list.back());
 }
 
+CloudClientContainer::query_iterator::query_iterator(const Grid &_grid,
+                                                     GeoPoint _south_west,
+                                                     GeoPoint _north_east) noexcept
+  :grid(&_grid), south_west(_south_west), north_east(_north_east),
+   x_first(ToGridX(south_west.longitude)),
+   x_last(ToGridX(north_east.longitude)),
+   y_last(ToGridY(north_east.latitude)),
+   x(x_first), y(ToGridY(south_west.latitude))
+{
+  LoadCell();
+  FindNext();
+}
+
+inline bool
+CloudClientContainer::query_iterator::IsInside(GeoPoint p) const noexcept
+{
+  if (p.latitude < south_west.latitude || p.latitude > north_east.latitude)
+    return false;
+
+  if (south_west.longitude <= north_east.longitude)
+    return p.longitude >= south_west.longitude &&
+      p.longitude <= north_east.longitude;
+  else
+    /* the box wraps around at the antimeridian */
+    return p.longitude >= south_west.longitude ||
+      p.longitude <= north_east.longitude;
+}
+
+inline void
+CloudClientContainer::query_iterator::LoadCell() noexcept
+{
+  if (auto c = grid->find(ToGridCell(x, y)); c != grid->end()) {
+    i = c->second.data();
+    end = i + c->second.size();
+  } else
+    i = end = nullptr;
+}
+
+inline bool
+CloudClientContainer::query_iterator::NextCell() noexcept
+{
+  if (x != x_last) {
+    /* wrap around at the antimeridian */
+    x = (x + 1) % GRID_WIDTH;
+  } else if (y < y_last) {
+    x = x_first;
+    ++y;
+  } else {
+    /* end of query */
+    ++y;
+    return false;
+  }
+
+  LoadCell();
+  return true;
+}
+
+void
+CloudClientContainer::query_iterator::FindNext() noexcept
+{
+  do {
+    for (; i != end; ++i)
+      if (IsInside((*i)->location))
+        return;
+  } while (NextCell());
+}
+
 CloudClientContainer::query_iterator_range
 CloudClientContainer::QueryWithinRange(GeoPoint location, double range) const
 {
-  const auto q = boost::geometry::index::intersects(BoostRangeBox(location, range));
-  return {rtree.qbegin(q), rtree.qend()};
+  const auto box = BoostRangeBox(location, range);
+  return {query_iterator{grid, box.min_corner(), box.max_corner()}};
 }
 
 inline Serialiser &
@@ -190,11 +336,12 @@ CloudClient::Load(Deserialiser &s)
 }
 
 void
-CloudClientContainer::Save(Serialiser &s) const
+CloudClientContainer::Save(Serialiser &s, unsigned next_id,
+                           std::span<const CloudClient> clients)
 {
   s.Write32(next_id);
 
-  for (const auto &client : list) {
+  for (const auto &client : clients) {
     s.Write8(1);
     client.Save(s);
   }
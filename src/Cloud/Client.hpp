@@ -3,16 +3,19 @@
 
 #pragma once
 
-#include "Geo/Boost/GeoPoint.hpp"
+#include "Geo/GeoPoint.hpp"
 #include "net/AllocatedSocketAddress.hxx"
 
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/intrusive/unordered_set.hpp>
-#include <boost/geometry/index/rtree.hpp>
-#include <boost/range/iterator_range_core.hpp>
 #include <memory>
 #include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <unordered_map>
+#include <vector>
 
 class Serialiser;
 class Deserialiser;
@@ -74,6 +77,13 @@ struct CloudClient
    */
   int altitude;
 
+  /**
+   * The #CloudClientContainer grid cell containing this client, and
+   * its position in that cell's vector.
+   */
+  uint32_t grid_cell;
+  uint32_t grid_index;
+
   struct KeyHash {
     constexpr std::size_t operator()(uint64_t key) const {
       return key;
@@ -128,21 +138,17 @@ struct CloudClient
 
 using CloudClientPtr = std::shared_ptr<CloudClient>;
 
-/**
- * Helper for boost::geometry::index::rtree.
- */
-struct CloudClientIndexable {
-  typedef GeoPoint result_type;
-
-  [[gnu::pure]]
-  result_type operator()(const CloudClientPtr &client) const {
-    return client->location;
-  }
-};
-
 class CloudClientContainer {
-  typedef boost::geometry::index::rtree<CloudClientPtr, boost::geometry::index::rstar<16>,
-                                        CloudClientIndexable> Tree;
+  /**
+   * All clients inside one grid cell, in no particular order.
+   */
+  using GridCell = std::vector<CloudClientPtr>;
+
+  /**
+   * Map grid cell number to the clients inside it.  Empty cells are
+   * removed.
+   */
+  using Grid = std::unordered_map<uint32_t, GridCell>;
 
   typedef boost::intrusive::list<CloudClient,
                                  boost::intrusive::constant_time_size<false>> List;
@@ -157,10 +163,12 @@ class CloudClientContainer {
                                 boost::intrusive::constant_time_size<false>> IdSet;
 
   /**
-   * A geospatial container of all clients, for fast geographic
-   * lookups.
+   * A geospatial index of all clients, for fast geographic lookups;
+   * this also owns the #CloudClient instances.  Unlike an R-tree,
+   * this is cheap to update when a client moves: usually, the client
+   * stays in its cell, and nothing needs to be done.
    */
-  Tree rtree;
+  Grid grid;
 
   /**
    * A linked list of clients, sorted by last fix, with fresh items at
@@ -196,6 +204,10 @@ public:
     return list.empty();
   }
 
+  unsigned GetNextId() const noexcept {
+    return next_id;
+  }
+
   /**
    * For iteration over the list of all clients in unspecified order.
    * The iterators get invalidated by all modifying calls.
@@ -238,12 +250,69 @@ public:
 
   void Expire(std::chrono::steady_clock::time_point before);
 
-  typedef Tree::const_query_iterator query_iterator;
-  typedef boost::iterator_range<query_iterator> query_iterator_range;
+  /**
+   * Iterates over all clients inside a bounding box, visiting all
+   * grid cells it overlaps.  The end is marked by
+   * std::default_sentinel.
+   */
+  class query_iterator {
+    const Grid *grid;
+
+    GeoPoint south_west, north_east;
+
+    unsigned x_first, x_last, y_last;
+    unsigned x, y;
+
+    const CloudClientPtr *i, *end;
+
+  public:
+    query_iterator(const Grid &_grid,
+                   GeoPoint _south_west, GeoPoint _north_east) noexcept;
+
+    const CloudClientPtr &operator*() const noexcept {
+      return *i;
+    }
+
+    query_iterator &operator++() noexcept {
+      ++i;
+      FindNext();
+      return *this;
+    }
+
+    bool operator==(std::default_sentinel_t) const noexcept {
+      return y > y_last;
+    }
+
+  private:
+    [[gnu::pure]]
+    bool IsInside(GeoPoint p) const noexcept;
+
+    void LoadCell() noexcept;
+    bool NextCell() noexcept;
+    void FindNext() noexcept;
+  };
+
+  struct query_iterator_range {
+    query_iterator first;
+
+    query_iterator begin() const noexcept {
+      return first;
+    }
+
+    static constexpr std::default_sentinel_t end() noexcept {
+      return {};
+    }
+  };
 
   [[gnu::pure]]
   query_iterator_range QueryWithinRange(GeoPoint location, double range) const;
 
-  void Save(Serialiser &s) const;
+  /**
+   * Serialise the given clients (usually a copy of this container's
+   * items) in the format understood by Load().
+   */
+  static void Save(Serialiser &s, unsigned next_id,
+                   std::span<const CloudClient> clients);
+
   void Load(Deserialiser &s);
 };
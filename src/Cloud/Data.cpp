@@ -31,16 +31,31 @@ CloudData::DumpClients()
 }
 
 void
-CloudData::Save(Serialiser &s) const
+CloudSnapshot::Save(Serialiser &s) const
 {
   s.Write32(CLOUD_MAGIC);
   s.Write32(CLOUD_VERSION);
-  clients.Save(s);
+  CloudClientContainer::Save(s, next_client_id, clients);
   s.Write8(1);
-  thermals.Save(s);
+  CloudThermalContainer::Save(s, thermals);
   s.Write8(0);
 }
 
+CloudSnapshot
+CloudData::MakeSnapshot() const
+{
+  CloudSnapshot snapshot;
+  snapshot.next_client_id = clients.GetNextId();
+
+  for (const auto &client : clients)
+    snapshot.clients.push_back(client);
+
+  for (const auto &thermal : thermals)
+    snapshot.thermals.push_back(thermal);
+
+  return snapshot;
+}
+
 void
 CloudData::Load(Deserialiser &s)
 {
@@ -6,15 +6,39 @@
 #include "Client.hpp"
 #include "Thermal.hpp"
 
+#include <vector>
+
 class Serialiser;
 class Deserialiser;
 
+/**
+ * A copy of all #CloudData items which can be saved (e.g. in another
+ * thread) while the original is being modified.
+ */
+struct CloudSnapshot {
+  unsigned next_client_id;
+
+  std::vector<CloudClient> clients;
+  std::vector<CloudThermal> thermals;
+
+  void Save(Serialiser &s) const;
+};
+
 struct CloudData {
   CloudClientContainer clients;
   CloudThermalContainer thermals;
 
   void DumpClients();
 
-  void Save(Serialiser &s) const;
+  /**
+   * Copy all items.  This is much quicker than Save(), because it
+   * does no I/O and no serialisation.
+   */
+  CloudSnapshot MakeSnapshot() const;
+
+  void Save(Serialiser &s) const {
+    MakeSnapshot().Save(s);
+  }
+
   void Load(Deserialiser &s);
 };
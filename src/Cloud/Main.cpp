@@ -4,6 +4,7 @@
 #include "Data.hpp"
 #include "Dump.hpp"
 #include "Sender.hpp"
+#include "Saver.hpp"
 #include "Serialiser.hpp"
 #include "Tracking/SkyLines/Server.hpp"
 #include "Tracking/SkyLines/Protocol.hpp"
@@ -12,16 +13,23 @@
 #include "event/CoarseTimerEvent.hxx"
 #include "event/SignalMonitor.hxx"
 #include "net/IPv4Address.hxx"
-#include "io/FileOutputStream.hxx"
 #include "io/FileReader.hxx"
+#include "thread/SharedMutex.hpp"
+#include "thread/Thread.hpp"
+#include "system/Args.hpp"
+#include "util/NumberParser.hpp"
 #include "util/PrintException.hxx"
 #include "util/Exception.hxx"
 #include "util/Compiler.h"
 #include "util/ScopeExit.hxx"
 
 #include <array>
+#include <forward_list>
+#include <mutex>
+#include <shared_mutex>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 
 #include <signal.h>
 
@@ -34,22 +42,58 @@ static constexpr std::chrono::steady_clock::duration MAX_THERMAL_AGE = std::chro
 
 static constexpr std::chrono::steady_clock::duration REQUEST_EXPIRY = std::chrono::minutes(5);
 
+/**
+ * The default time to collect traffic records for a client before
+ * sending them in one packet.  Clients submit fixes only every few
+ * seconds, so this delay is negligible.
+ */
+static constexpr unsigned DEFAULT_TRAFFIC_WINDOW_MS = 250;
+
 using std::cout;
 using std::cerr;
 using std::endl;
 
-class CloudServer final
-  : public SkyLinesTracking::Server, CloudData
+using Client = SkyLinesTracking::Server::Client;
+
+/**
+ * Write a log line to #cout with one call, so lines of different
+ * threads do not interleave, and without flushing.  The line is
+ * formatted by the caller in its own stream, because the handlers run
+ * in several threads at once and must not share the format flags of
+ * #cout.  Must not be called while holding the #CloudServer mutex.
+ */
+static void
+WriteLine(std::ostringstream &line) noexcept
+{
+  line << '\n';
+  cout << line.view();
+}
+
+/**
+ * The cloud database shared by all #CloudListener instances.
+ *
+ * Modifications require an exclusive lock on #mutex.  Sending
+ * traffic and thermals to interested clients (which is where most of
+ * the time is spent) needs only a shared lock, therefore all threads
+ * can do this concurrently.
+ */
+class CloudServer final : CloudData
 {
   const AllocatedPath db_path;
 
+  EventLoop &event_loop;
+
+  mutable SharedMutex mutex;
+
+  CloudSaver saver;
+
   CoarseTimerEvent save_timer, expire_timer;
 
 public:
-  CloudServer(AllocatedPath &&_db_path, EventLoop &event_loop,
-              SocketAddress bind_address)
-    :SkyLinesTracking::Server(event_loop, bind_address),
-     db_path(std::move(_db_path)),
+  CloudServer(AllocatedPath &&_db_path, EventLoop &_event_loop)
+    :db_path(std::move(_db_path)),
+     event_loop(_event_loop),
+     saver(Path{db_path}),
      save_timer(event_loop, BIND_THIS_METHOD(OnSaveTimer)),
      expire_timer(event_loop, BIND_THIS_METHOD(OnExpireTimer))
   {
@@ -63,12 +107,64 @@ public:
 #endif
 
     ScheduleSave();
+    ScheduleExpire();
   }
 
   void Load();
-  void Save();
+
+  /**
+   * Save a snapshot of the database in background.
+   */
+  void Save() noexcept;
+
+  /**
+   * Wait until Save() has finished writing the database file.
+   */
+  void FlushSave() noexcept {
+    saver.Flush();
+  }
+
+  /**
+   * Stop the main #EventLoop.  This method is thread-safe.
+   */
+  void Quit() noexcept {
+    event_loop.InjectBreak();
+  }
+
+  void OnFix(TrafficResponseQueue &traffic_queue, const Client &client,
+             std::chrono::milliseconds time_of_day,
+             const ::GeoPoint &location, int altitude);
+
+  void OnTrafficRequest(SkyLinesTracking::Server &server,
+                        const Client &client, bool near);
+
+  void OnWaveSubmit(const Client &client,
+                    std::chrono::milliseconds time_of_day,
+                    const ::GeoPoint &a, const ::GeoPoint &b,
+                    int bottom_altitude,
+                    int top_altitude,
+                    double lift);
+
+  void OnThermalSubmit(SkyLinesTracking::Server &server,
+                       const Client &client,
+                       std::chrono::milliseconds time_of_day,
+                       const ::GeoPoint &bottom_location,
+                       int bottom_altitude,
+                       const ::GeoPoint &top_location,
+                       int top_altitude,
+                       double lift);
+
+  void OnThermalRequest(SkyLinesTracking::Server &server,
+                        const Client &client);
 
 private:
+  CloudSnapshot LockMakeSnapshot() const {
+    const std::shared_lock lock{mutex};
+    return MakeSnapshot();
+  }
+
+  void DumpSaveStats() noexcept;
+
   void OnSaveTimer() noexcept {
     Save();
     ScheduleSave();
@@ -79,30 +175,84 @@ private:
   }
 
   void OnExpireTimer() noexcept {
-    clients.Expire(GetEventLoop().SteadyNow() - std::chrono::minutes(10));
-    if (!clients.empty())
-      ScheduleExpire();
+    {
+      const std::scoped_lock lock{mutex};
+      clients.Expire(event_loop.SteadyNow() - std::chrono::minutes(10));
+    }
+
+    /* always reschedule: new clients may be added by other threads
+       which cannot access this timer */
+    ScheduleExpire();
   }
 
   void ScheduleExpire() {
     expire_timer.Schedule(std::chrono::minutes(5));
   }
 
+#ifndef _WIN32
+  void OnQuitSignal() noexcept {
+    event_loop.Break();
+  }
+
+  void OnReloadSignal() noexcept {
+    Save();
+  }
+
+  void OnDumpSignal() noexcept {
+    {
+      const std::shared_lock lock{mutex};
+      DumpClients();
+    }
+
+    DumpSaveStats();
+  }
+#endif
+};
+
+/**
+ * One UDP socket receiving datagrams for the #CloudServer.  There is
+ * one per thread, all bound to the same port.
+ */
+class CloudListener final : public SkyLinesTracking::Server
+{
+  CloudServer &cloud;
+
+  TrafficResponseQueue traffic_queue;
+
+public:
+  /**
+   * @param traffic_window the time to collect traffic records before
+   * sending them (see #TrafficResponseQueue)
+   */
+  CloudListener(CloudServer &_cloud, EventLoop &event_loop,
+                SocketAddress bind_address, bool reuse_port,
+                Event::Duration traffic_window)
+    :SkyLinesTracking::Server(event_loop, bind_address, reuse_port),
+     cloud(_cloud),
+     traffic_queue(*this, traffic_window) {}
+
 protected:
   /* virtual methods from class SkyLinesTracking::Server */
   void OnFix(const Client &client,
              std::chrono::milliseconds time_of_day,
-             const ::GeoPoint &location, int altitude) override;
+             const ::GeoPoint &location, int altitude) override {
+    cloud.OnFix(traffic_queue, client, time_of_day, location, altitude);
+  }
 
   void OnTrafficRequest(const Client &client,
-                        bool near) override;
+                        bool near) override {
+    cloud.OnTrafficRequest(*this, client, near);
+  }
 
   void OnWaveSubmit(const Client &client,
                     std::chrono::milliseconds time_of_day,
                     const ::GeoPoint &a, const ::GeoPoint &b,
                     int bottom_altitude,
                     int top_altitude,
-                    double lift) override;
+                    double lift) override {
+    cloud.OnWaveSubmit(client, time_of_day, a, b,
+                       bottom_altitude, top_altitude, lift);
+  }
 
   void OnThermalSubmit(const Client &client,
                        std::chrono::milliseconds time_of_day,
@@ -110,9 +260,15 @@ protected:
                        int bottom_altitude,
                        const ::GeoPoint &top_location,
                        int top_altitude,
-                       double lift) override;
+                       double lift) override {
+    cloud.OnThermalSubmit(*this, client, time_of_day,
+                          bottom_location, bottom_altitude,
+                          top_location, top_altitude, lift);
+  }
 
-  void OnThermalRequest(const Client &client) override;
+  void OnThermalRequest(const Client &client) override {
+    cloud.OnThermalRequest(*this, client);
+  }
 
   void OnSendError(SocketAddress address,
                    std::exception_ptr e) noexcept override {
@@ -123,55 +279,97 @@ protected:
 
   void OnError(std::exception_ptr e) override {
     cerr << GetFullMessage(e) << endl;
-    GetEventLoop().Break();
+    cloud.Quit();
   }
+};
 
-#ifndef _WIN32
-  void OnQuitSignal() noexcept {
-    GetEventLoop().Break();
+/**
+ * An additional thread with its own #EventLoop and #CloudListener.
+ */
+class CloudWorker final : Thread
+{
+  EventLoop event_loop{ThreadId::Null()};
+
+  CloudListener listener;
+
+public:
+  CloudWorker(CloudServer &cloud, SocketAddress bind_address,
+              Event::Duration traffic_window)
+    :Thread("cloud"),
+     listener(cloud, event_loop, bind_address, true, traffic_window) {}
+
+  /**
+   * Throws on error.
+   */
+  void Start() {
+    event_loop.SetAlive(true);
+    Thread::Start();
   }
 
-  void OnReloadSignal() noexcept {
-    Save();
+  void Stop() noexcept {
+    if (!IsDefined())
+      return;
+
+    event_loop.InjectBreak();
+    Join();
+
+    /* the #CloudListener will be destructed in the main thread */
+    event_loop.SetAlive(false);
   }
 
-  void OnDumpSignal() noexcept {
-    DumpClients();
+private:
+  /* virtual methods from class Thread */
+  void Run() noexcept override {
+    event_loop.Run();
   }
-#endif
 };
 
 void
-CloudServer::OnFix(const Client &c,
+CloudServer::OnFix(TrafficResponseQueue &traffic_queue, const Client &c,
                    std::chrono::milliseconds time_of_day,
                    const ::GeoPoint &location, int altitude)
 {
   (void)time_of_day; // TODO: use this parameter
 
-  CloudClient *client;
-  if (location.IsValid()) {
-    bool was_empty = clients.empty();
+  unsigned id;
+  ::GeoPoint client_location;
+  int client_altitude;
 
-    client = &clients.Make(c.address, c.key, location, altitude);
+  {
+    const std::scoped_lock lock{mutex};
 
-    cout << "FIX\t"
-         << client->address << '\t'
-         << std::hex << client->key << std::dec << '\t'
-         << client->id << '\t'
-         << client->location << '\t'
-         << client->altitude << 'm'
-         << endl;
+    CloudClient *client;
+    if (location.IsValid()) {
+      client = &clients.Make(c.address, c.key, location, altitude);
+    } else {
+      client = clients.Find(c.key);
+      if (client == nullptr)
+        return;
 
-    if (was_empty)
-      ScheduleExpire();
-  } else {
-    client = clients.Find(c.key);
-    if (client != nullptr)
       clients.Refresh(*client, c.address);
+    }
+
+    /* copy the attributes, because the client may be expired as
+       soon as the lock is released */
+    id = client->id;
+    client_location = client->location;
+    client_altitude = client->altitude;
+  }
+
+  if (location.IsValid()) {
+    std::ostringstream line;
+    line << "FIX\t"
+         << SocketAddress(c.address) << '\t'
+         << std::hex << c.key << std::dec << '\t'
+         << id << '\t'
+         << client_location << '\t'
+         << client_altitude << 'm';
+    WriteLine(line);
   }
 
-  /* send this new traffic location to all interested clients
-     immediately */
+  /* send this new traffic location to all interested clients (after
+     the coalescing window) */
+  const std::shared_lock lock{mutex};
   const auto now = std::chrono::steady_clock::now();
   for (const auto &i : clients.QueryWithinRange(location, TRAFFIC_RANGE)) {
     if (i->key == c.key)
@@ -183,38 +381,46 @@ CloudServer::OnFix(const Client &c,
       /* not interested (anymore) */
       continue;
 
-    TrafficResponseSender s(*this, i->address, i->key);
-    s.Add(client->id, 0, //TODO: time?
-          client->location, client->altitude);
-    s.Flush();
+    traffic_queue.Add(i->address, i->key,
+                      id, client_location, client_altitude);
   }
 }
 
 void
-CloudServer::OnTrafficRequest(const Client &c, bool near)
+CloudServer::OnTrafficRequest(SkyLinesTracking::Server &server,
+                              const Client &c, bool near)
 {
   if (!near)
     /* "near" is the only selection flag we know */
     return;
 
-  auto *client = clients.Find(c.key);
-  if (client == nullptr)
-    /* we don't send our data to clients who didn't sent anything to
-       us yet */
-    return;
-
   const auto now = std::chrono::steady_clock::now();
 
-  client->wants_traffic = now + REQUEST_EXPIRY;
+  ::GeoPoint location;
+
+  {
+    const std::scoped_lock lock{mutex};
+
+    auto *client = clients.Find(c.key);
+    if (client == nullptr)
+      /* we don't send our data to clients who didn't sent anything
+         to us yet */
+      return;
+
+    client->wants_traffic = now + REQUEST_EXPIRY;
+    location = client->location;
+  }
 
   const auto min_stamp = now - MAX_TRAFFIC_AGE;
 
-  TrafficResponseSender s(*this, c.address, c.key);
+  TrafficResponseSender s(server, c.address, c.key);
+
+  const std::shared_lock lock{mutex};
 
   unsigned n = 0;
-  for (const auto &traffic : clients.QueryWithinRange(client->location,
+  for (const auto &traffic : clients.QueryWithinRange(location,
                                                       TRAFFIC_RANGE)) {
-    if (traffic.get() == client)
+    if (traffic->key == c.key)
       continue;
 
     if (traffic->stamp < min_stamp)
@@ -239,25 +445,37 @@ CloudServer::OnWaveSubmit(const Client &c,
                           int top_altitude,
                           double lift)
 {
-  auto *client = clients.Find(c.key);
-  if (client == nullptr)
-    /* we don't trust the client if he didn't sent anything to us
-       yet */
-    return;
+  StaticSocketAddress address;
+  unsigned id;
+
+  {
+    const std::shared_lock lock{mutex};
+
+    auto *client = clients.Find(c.key);
+    if (client == nullptr)
+      /* we don't trust the client if he didn't sent anything to us
+         yet */
+      return;
+
+    address = client->address;
+    id = client->id;
+  }
 
-  cout << "WAVE\t"
-       << client->address << '\t'
-       << std::hex << client->key << std::dec << '\t'
-       << client->id << '\t'
+  std::ostringstream line;
+  line << "WAVE\t"
+       << SocketAddress(address) << '\t'
+       << std::hex << c.key << std::dec << '\t'
+       << id << '\t'
        << a << '\t'
        << b << '\t'
        << bottom_altitude << '-' << top_altitude << "m\t"
-       << lift << "m/s"
-       << endl;
+       << lift << "m/s";
+  WriteLine(line);
 }
 
 void
-CloudServer::OnThermalSubmit(const Client &c,
+CloudServer::OnThermalSubmit(SkyLinesTracking::Server &server,
+                             const Client &c,
                              [[maybe_unused]] std::chrono::milliseconds time_of_day,
                              const ::GeoPoint &bottom_location,
                              int bottom_altitude,
@@ -265,28 +483,42 @@ CloudServer::OnThermalSubmit(const Client &c,
                              int top_altitude,
                              double lift)
 {
-  auto *client = clients.Find(c.key);
-  if (client == nullptr)
-    /* we don't trust the client if he didn't sent anything to us
-       yet */
-    return;
+  SkyLinesTracking::Thermal packed;
+  StaticSocketAddress address;
+  unsigned id;
+
+  {
+    const std::scoped_lock lock{mutex};
+
+    auto *client = clients.Find(c.key);
+    if (client == nullptr)
+      /* we don't trust the client if he didn't sent anything to us
+         yet */
+      return;
+
+    address = client->address;
+    id = client->id;
+
+    const auto &thermal =
+      thermals.Make(c.key,
+                    AGeoPoint(bottom_location, bottom_altitude),
+                    AGeoPoint(top_location, top_altitude),
+                    lift);
+    packed = thermal.Pack();
+  }
 
-  cout << "THERMAL\t"
-       << client->address << '\t'
-       << std::hex << client->key << std::dec << '\t'
-       << client->id << '\t'
+  std::ostringstream line;
+  line << "THERMAL\t"
+       << SocketAddress(address) << '\t'
+       << std::hex << c.key << std::dec << '\t'
+       << id << '\t'
        << top_location << '\t'
        << bottom_altitude << '-' << top_altitude << "m\t"
-       << lift << "m/s"
-       << endl;
-
-  const auto &thermal =
-    thermals.Make(c.key,
-                  AGeoPoint(bottom_location, bottom_altitude),
-                  AGeoPoint(top_location, top_altitude),
-                  lift);
+       << lift << "m/s";
+  WriteLine(line);
 
   /* send this new thermal to all interested clients immediately */
+  const std::shared_lock lock{mutex};
   const auto now = std::chrono::steady_clock::now();
   for (const auto &i : clients.QueryWithinRange(bottom_location,
                                                 THERMAL_RANGE)) {
@@ -299,31 +531,41 @@ CloudServer::OnThermalSubmit(const Client &c,
       /* not interested (anymore) */
       continue;
 
-    ThermalResponseSender s(*this, i->address, i->key);
-    s.Add(thermal.Pack());
+    ThermalResponseSender s(server, i->address, i->key);
+    s.Add(packed);
     s.Flush();
   }
 }
 
 void
-CloudServer::OnThermalRequest(const Client &c)
+CloudServer::OnThermalRequest(SkyLinesTracking::Server &server,
+                              const Client &c)
 {
-  auto *client = clients.Find(c.key);
-  if (client == nullptr)
-    /* we don't send our data to clients who didn't sent anything to
-       us yet */
-    return;
-
   const auto now = std::chrono::steady_clock::now();
 
-  client->wants_thermals = now + REQUEST_EXPIRY;
+  ::GeoPoint location;
+
+  {
+    const std::scoped_lock lock{mutex};
+
+    auto *client = clients.Find(c.key);
+    if (client == nullptr)
+      /* we don't send our data to clients who didn't sent anything
+         to us yet */
+      return;
+
+    client->wants_thermals = now + REQUEST_EXPIRY;
+    location = client->location;
+  }
 
   const auto min_time = now - MAX_THERMAL_AGE;
 
-  ThermalResponseSender s(*this, c.address, c.key);
+  ThermalResponseSender s(server, c.address, c.key);
+
+  const std::shared_lock lock{mutex};
 
   unsigned n = 0;
-  for (const auto &thermal : thermals.QueryWithinRange(client->location,
+  for (const auto &thermal : thermals.QueryWithinRange(location,
                                                        THERMAL_RANGE)) {
     if (thermal->client_key == c.key)
       /* ignore this client's own submissions - he knows them
@@ -352,37 +594,69 @@ CloudServer::Load()
 }
 
 void
-CloudServer::Save()
+CloudServer::Save() noexcept
 {
   cout << "Saving data to " << db_path.c_str() << endl;
 
-  FileOutputStream fos(db_path);
+  /* only copying the data blocks the other threads; serialising and
+     writing is done by the CloudSaver thread */
+  const auto start = std::chrono::steady_clock::now();
+  auto snapshot = LockMakeSnapshot();
+  const auto pause = std::chrono::steady_clock::now() - start;
 
-  {
-    Serialiser s(fos);
-    CloudData::Save(s);
-    s.Flush();
+  try {
+    saver.Submit(std::move(snapshot), pause);
+  } catch (...) {
+    PrintException(std::current_exception());
   }
+}
 
-  fos.Commit();
+void
+CloudServer::DumpSaveStats() noexcept
+{
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  using std::chrono::milliseconds;
+
+  const auto stats = saver.GetStats();
+
+  cout << "# saved " << stats.n_saved
+       << " times (" << stats.n_failed << " failed)\n"
+       << "# save pause "
+       << duration_cast<microseconds>(stats.last_pause).count()
+       << "us (max "
+       << duration_cast<microseconds>(stats.max_pause).count()
+       << "us)\n"
+       << "# save duration "
+       << duration_cast<milliseconds>(stats.last_duration).count()
+       << "ms (max "
+       << duration_cast<milliseconds>(stats.max_duration).count()
+       << "ms)"
+       << endl;
 }
 
 int
 main(int argc, char **argv)
 try {
-  if (argc != 2) {
-    cerr << "Usage: " << argv[0] << " DBPATH" << endl;
+  Args args(argc, argv, "DBPATH [THREADS [TRAFFIC_WINDOW_MS]]");
+  const Path db_path(args.ExpectNext());
+  const unsigned n_threads = args.IsEmpty()
+    ? 1 : ParseUnsigned(args.ExpectNext());
+  const std::chrono::milliseconds traffic_window(args.IsEmpty()
+                                                 ? DEFAULT_TRAFFIC_WINDOW_MS
+                                                 : ParseUnsigned(args.ExpectNext()));
+  args.ExpectEnd();
+
+  if (n_threads == 0) {
+    cerr << "Invalid number of threads" << endl;
     return EXIT_FAILURE;
   }
 
-  const Path db_path(argv[1]);
-
   EventLoop event_loop;
   SignalMonitorInit(event_loop);
   AtScopeExit() { SignalMonitorFinish(); };
 
-  CloudServer server(db_path, event_loop,
-                     IPv4Address(CloudServer::GetDefaultPort()));
+  CloudServer server(db_path, event_loop);
 
   try {
     server.Load();
@@ -391,9 +665,33 @@ try {
     PrintException(e);
   }
 
+  /* with more than one thread, each one gets its own socket, and
+     the kernel distributes the clients among them (SO_REUSEPORT) */
+  const IPv4Address bind_address(SkyLinesTracking::Server::GetDefaultPort());
+  const bool reuse_port = n_threads > 1;
+
+  CloudListener listener(server, event_loop, bind_address, reuse_port,
+                         traffic_window);
+
+  std::forward_list<CloudWorker> workers;
+  for (unsigned i = 1; i < n_threads; ++i)
+    workers.emplace_front(server, bind_address, traffic_window);
+
+  AtScopeExit(&workers) {
+    for (auto &worker : workers)
+      worker.Stop();
+  };
+
+  for (auto &worker : workers)
+    worker.Start();
+
   event_loop.Run();
 
+  for (auto &worker : workers)
+    worker.Stop();
+
   server.Save();
+  server.FlushSave();
 
   return EXIT_SUCCESS;
 } catch (const std::exception &exception) {
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Saver.hpp"
+#include "Serialiser.hpp"
+#include "io/FileOutputStream.hxx"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+
+void
+CloudSaver::Submit(CloudSnapshot &&snapshot,
+                   std::chrono::steady_clock::duration pause)
+{
+  const std::lock_guard lock{mutex};
+
+  pending = std::move(snapshot);
+
+  stats.last_pause = pause;
+  stats.max_pause = std::max(stats.max_pause, pause);
+
+  Trigger();
+}
+
+void
+CloudSaver::Save(Path path, const CloudSnapshot &snapshot)
+{
+  /* FileOutputStream writes to a temporary file and renames it in
+     Commit() */
+  FileOutputStream fos(path);
+
+  {
+    Serialiser s(fos);
+    snapshot.Save(s);
+    s.Flush();
+  }
+
+  fos.Commit();
+}
+
+void
+CloudSaver::Tick() noexcept
+{
+  if (!pending)
+    return;
+
+  /* move the snapshot to this stack frame, to allow submitting the
+     next one while this one is being saved; it is also freed in this
+     thread */
+  const CloudSnapshot snapshot = std::move(*pending);
+  pending.reset();
+
+  bool success = true;
+  std::chrono::steady_clock::duration duration;
+
+  {
+    const ScopeUnlock unlock(mutex);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    try {
+      Save(path, snapshot);
+    } catch (...) {
+      PrintException(std::current_exception());
+      success = false;
+    }
+
+    duration = std::chrono::steady_clock::now() - start;
+  }
+
+  if (success)
+    ++stats.n_saved;
+  else
+    ++stats.n_failed;
+
+  stats.last_duration = duration;
+  stats.max_duration = std::max(stats.max_duration, duration);
+}
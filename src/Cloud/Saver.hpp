@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Data.hpp"
+#include "thread/StandbyThread.hpp"
+#include "system/Path.hpp"
+
+#include <chrono>
+#include <optional>
+
+struct CloudSaveStats {
+  unsigned n_saved = 0, n_failed = 0;
+
+  /**
+   * How long was the #CloudData locked for creating the snapshot?
+   */
+  std::chrono::steady_clock::duration last_pause{}, max_pause{};
+
+  /**
+   * How long did it take to write the snapshot to the file?
+   */
+  std::chrono::steady_clock::duration last_duration{}, max_duration{};
+};
+
+/**
+ * Writes #CloudSnapshot instances to the database file in a separate
+ * thread, so the server can continue handling packets meanwhile.
+ */
+class CloudSaver final : StandbyThread {
+  const AllocatedPath path;
+
+  /**
+   * The snapshot to be saved next.  If the thread is too slow, older
+   * snapshots are discarded.  Protected by the mutex.
+   */
+  std::optional<CloudSnapshot> pending;
+
+  /**
+   * Protected by the mutex.
+   */
+  CloudSaveStats stats;
+
+public:
+  explicit CloudSaver(AllocatedPath &&_path) noexcept
+    :StandbyThread("CloudSaver"), path(std::move(_path)) {}
+
+  /**
+   * Stops the thread.  Snapshots which have not been saved yet are
+   * discarded; call Flush() first to avoid that.
+   */
+  ~CloudSaver() noexcept {
+    LockStop();
+  }
+
+  /**
+   * Save the snapshot in background.
+   *
+   * Throws on error.
+   *
+   * @param pause the time it took to create the snapshot (for
+   * statistics only)
+   */
+  void Submit(CloudSnapshot &&snapshot,
+              std::chrono::steady_clock::duration pause);
+
+  /**
+   * Wait until all submitted snapshots have been saved.
+   */
+  void Flush() noexcept {
+    LockWaitDone();
+  }
+
+  CloudSaveStats GetStats() noexcept {
+    const std::lock_guard lock{mutex};
+    return stats;
+  }
+
+  /**
+   * Write the snapshot to the file.  The file is replaced atomically,
+   * i.e. after a crash, there is either the old or the new file, but
+   * never a partial one.
+   *
+   * Throws on error.
+   */
+  static void Save(Path path, const CloudSnapshot &snapshot);
+
+private:
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override;
+};
@@ -6,6 +6,8 @@
 #include "Geo/GeoPoint.hpp"
 #include "util/CRC16CCITT.hpp"
 
+#include <algorithm>
+
 void
 TrafficResponseSender::Add(uint32_t pilot_id, uint32_t time,
                            GeoPoint location, int altitude)
@@ -40,6 +42,53 @@ TrafficResponseSender::Flush()
   server.SendBuffer(address, {(const std::byte *)&data, size});
 }
 
+void
+TrafficResponseQueue::Add(SocketAddress address, uint64_t key,
+                          uint32_t pilot_id, GeoPoint location,
+                          int altitude) noexcept
+{
+  if (window <= Event::Duration::zero()) {
+    TrafficResponseSender s(server, address, key);
+    s.Add(pilot_id, 0, //TODO: time?
+          location, altitude);
+    s.Flush();
+    return;
+  }
+
+  auto &recipient = recipients[key];
+  recipient.address = address;
+
+  auto i = std::find_if(recipient.traffic.begin(), recipient.traffic.end(),
+                        [pilot_id](const Traffic &t){
+                          return t.pilot_id == pilot_id;
+                        });
+  if (i != recipient.traffic.end()) {
+    /* a newer fix of this pilot replaces the pending one */
+    i->location = location;
+    i->altitude = altitude;
+  } else
+    recipient.traffic.push_back({pilot_id, location, altitude});
+
+  if (!timer.IsPending())
+    timer.Schedule(window);
+}
+
+void
+TrafficResponseQueue::Flush() noexcept
+{
+  timer.Cancel();
+
+  for (const auto &[key, recipient] : recipients) {
+    TrafficResponseSender s(server, recipient.address, key);
+    for (const auto &t : recipient.traffic)
+      s.Add(t.pilot_id, 0, //TODO: time?
+            t.location, t.altitude);
+    s.Flush();
+  }
+
+  recipients.clear();
+}
+
 void
 ThermalResponseSender::Add(SkyLinesTracking::Thermal t)
 {
@@ -5,12 +5,14 @@
 
 #include "Tracking/SkyLines/Server.hpp"
 #include "Tracking/SkyLines/Protocol.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "event/FineTimerEvent.hxx"
 #include "util/ByteOrder.hxx"
 #include "net/StaticSocketAddress.hxx"
 
 #include <array>
-
-struct GeoPoint;
+#include <unordered_map>
+#include <vector>
 
 class TrafficResponseSender {
   SkyLinesTracking::Server &server;
@@ -45,6 +47,61 @@ public:
   void Flush();
 };
 
+/**
+ * Collects traffic records for each recipient during a short window
+ * and then sends them with one #TrafficResponseSender per recipient.
+ * This replaces one tiny datagram per fix and recipient with one
+ * larger datagram per window and recipient.
+ *
+ * This object may only be used in the thread of the server's
+ * #EventLoop.
+ */
+class TrafficResponseQueue {
+  SkyLinesTracking::Server &server;
+
+  /**
+   * How long to collect traffic records before sending them?  Zero
+   * disables coalescing.
+   */
+  const Event::Duration window;
+
+  FineTimerEvent timer;
+
+  struct Traffic {
+    uint32_t pilot_id;
+    GeoPoint location;
+    int altitude;
+  };
+
+  struct Recipient {
+    StaticSocketAddress address;
+    std::vector<Traffic> traffic;
+  };
+
+  /**
+   * Pending records, indexed by the recipient's key.
+   */
+  std::unordered_map<uint64_t, Recipient> recipients;
+
+public:
+  TrafficResponseQueue(SkyLinesTracking::Server &_server,
+                       Event::Duration _window) noexcept
+    :server(_server), window(_window),
+     timer(server.GetEventLoop(), BIND_THIS_METHOD(Flush)) {}
+
+  /**
+   * Queue a traffic record for the given recipient.  If there is
+   * already a pending record for this pilot, it is replaced.
+   */
+  void Add(SocketAddress address, uint64_t key,
+           uint32_t pilot_id, GeoPoint location, int altitude) noexcept;
+
+  /**
+   * Send all pending records now.
+   */
+  void Flush() noexcept;
+};
+
 class ThermalResponseSender {
   SkyLinesTracking::Server &server;
   const SocketAddress address;
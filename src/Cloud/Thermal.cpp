@@ -111,11 +111,12 @@ CloudThermal::Load(Deserialiser &s)
 }
 
 void
-CloudThermalContainer::Save(Serialiser &s) const
+CloudThermalContainer::Save(Serialiser &s,
+                            std::span<const CloudThermal> thermals)
 {
   s.Write8(1);
 
-  for (const auto &thermal : list) {
+  for (const auto &thermal : thermals) {
     s.Write8(1);
     thermal.Save(s);
   }
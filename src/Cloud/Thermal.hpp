@@ -10,6 +10,7 @@
 #include <boost/range/iterator_range_core.hpp>
 #include <memory>
 #include <chrono>
+#include <span>
 
 class Serialiser;
 class Deserialiser;
@@ -129,6 +130,11 @@ public:
   [[gnu::pure]]
   query_iterator_range QueryWithinRange(GeoPoint location, double range) const;
 
-  void Save(Serialiser &s) const;
+  /**
+   * Serialise the given thermals (usually a copy of this container's
+   * items) in the format understood by Load().
+   */
+  static void Save(Serialiser &s, std::span<const CloudThermal> thermals);
+
   void Load(Deserialiser &s);
 };
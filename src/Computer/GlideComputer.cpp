@@ -18,7 +18,8 @@ GlideComputer::GlideComputer(const ComputerSettings &_settings,
                              GlideComputerTaskEvents& events)
   :air_data_computer(_way_points),
    warning_computer(_settings.airspace.warnings, _airspace_database),
-   task_computer(task, _airspace_database, &warning_computer.GetManager()),
+   task_computer(task, _airspace_database, &warning_computer.GetManager(),
+                 _way_points),
    idle_condition_monitors(warning_computer.GetManager()),
    waypoints(_way_points),
    retrospective(_way_points),
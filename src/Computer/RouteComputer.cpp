@@ -11,8 +11,10 @@
 #include <algorithm>
 
 RouteComputer::RouteComputer(const Airspaces &airspace_database,
-                             const ProtectedAirspaceWarningManager *warnings)
-  :protected_route_planner(route_planner, airspace_database, warnings),
+                             const ProtectedAirspaceWarningManager *warnings,
+                             const Waypoints &_waypoints)
+  :waypoints(_waypoints),
+   protected_route_planner(route_planner, airspace_database, warnings),
    terrain(NULL)
 {}
 
@@ -32,7 +34,8 @@ RouteComputer::ProcessRoute(const MoreData &basic, DerivedInfo &calculated,
                             const GlideSettings &settings,
                             const RoutePlannerConfig &config,
                             const GlidePolar &glide_polar,
-                            const GlidePolar &safety_polar)
+                            const GlidePolar &safety_polar,
+                            double safety_height_arrival)
 {
   if (!basic.location_available || !basic.NavAltitudeAvailable())
     return;
@@ -42,7 +45,7 @@ RouteComputer::ProcessRoute(const MoreData &basic, DerivedInfo &calculated,
                                     calculated.GetWindOrZero(),
                                     calculated.common_stats.height_min_working);
 
-  Reach(basic, calculated, config);
+  Reach(basic, calculated, config, safety_height_arrival);
   TerrainWarning(basic, calculated, config);
 }
 
@@ -106,7 +109,8 @@ RouteComputer::TerrainWarning(const MoreData &basic,
 
 inline void
 RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
-                     const RoutePlannerConfig &config)
+                     const RoutePlannerConfig &config,
+                     double safety_height_arrival)
 {
   if (!calculated.terrain_valid) {
     /* without valid terrain information, we cannot calculate
@@ -131,6 +135,10 @@ RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
       calculated.terrain_base_valid = true;
     }
   }
+
+  protected_route_planner.UpdateLandableReach(waypoints, state.location,
+                                              LANDABLE_REACH_RANGE,
+                                              safety_height_arrival);
 }
 
 void
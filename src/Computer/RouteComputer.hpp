@@ -15,10 +15,19 @@ struct RoutePlannerConfig;
 class ProtectedAirspaceWarningManager;
 class RasterTerrain;
 class GlidePolar;
+class Waypoints;
 
 class RouteComputer {
   static constexpr std::chrono::steady_clock::duration PERIOD = std::chrono::seconds(5);
 
+  /**
+   * Landables within this distance [m] get their arrival height
+   * precalculated for the renderer.
+   */
+  static constexpr double LANDABLE_REACH_RANGE = 100000;
+
+  const Waypoints &waypoints;
+
   RoutePlannerGlue route_planner;
   ProtectedRoutePlanner protected_route_planner;
 
@@ -32,7 +41,8 @@ class RouteComputer {
 
 public:
   RouteComputer(const Airspaces &airspace_database,
-                const ProtectedAirspaceWarningManager *warnings);
+                const ProtectedAirspaceWarningManager *warnings,
+                const Waypoints &_waypoints);
 
   const ProtectedRoutePlanner &GetProtectedRoutePlanner() const {
     return protected_route_planner;
@@ -51,7 +61,8 @@ public:
                     const GlideSettings &settings,
                     const RoutePlannerConfig &config,
                     const GlidePolar &glide_polar,
-                    const GlidePolar &safety_polar);
+                    const GlidePolar &safety_polar,
+                    double safety_height_arrival);
 
   void set_terrain(const RasterTerrain* _terrain);
 
@@ -61,5 +72,6 @@ private:
                       const RoutePlannerConfig &config);
 
   void Reach(const MoreData &basic, DerivedInfo &calculated,
-             const RoutePlannerConfig &config);
+             const RoutePlannerConfig &config,
+             double safety_height_arrival);
 };
@@ -20,9 +20,10 @@ using namespace std::chrono;
 
 TaskComputer::TaskComputer(ProtectedTaskManager &_task,
                            const Airspaces &airspace_database,
-                           const ProtectedAirspaceWarningManager *warnings)
+                           const ProtectedAirspaceWarningManager *warnings,
+                           const Waypoints &waypoints)
   :task(_task),
-   route(airspace_database, warnings),
+   route(airspace_database, warnings, waypoints),
    contest(trace.GetFull(), trace.GetContest(), trace.GetSprint())
 {
   task.SetRoutePlanner(&route.GetProtectedRoutePlanner());
@@ -92,7 +93,8 @@ TaskComputer::ProcessMoreTask(const MoreData &basic,
   route.ProcessRoute(basic, calculated,
                      settings_computer.task.glide,
                      settings_computer.task.route_planner,
-                     glide_polar, safety_polar);
+                     glide_polar, safety_polar,
+                     settings_computer.task.safety_height_arrival);
 
   if (settings_computer.features.block_stf_enabled)
     calculated.V_stf = calculated.common_stats.V_block;
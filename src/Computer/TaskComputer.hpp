@@ -33,7 +33,8 @@ class TaskComputer
 public:
   TaskComputer(ProtectedTaskManager &_task,
                const Airspaces &airspace_database,
-               const ProtectedAirspaceWarningManager *warnings);
+               const ProtectedAirspaceWarningManager *warnings,
+               const Waypoints &waypoints);
 
   const ProtectedTaskManager &GetProtectedTaskManager() const {
     return task;
@@ -65,6 +65,7 @@ DeviceDescriptor::DeviceDescriptor(DeviceBlackboard &_blackboard,
    port_listener(_port_listener)
 {
   config.Clear();
+  parser.SetTrafficStore(&blackboard.SetRealTraffic(index));
 }
 
 DeviceDescriptor::~DeviceDescriptor() noexcept
@@ -7,6 +7,7 @@
 #include "FLARM/Version.hpp"
 #include "FLARM/Status.hpp"
 #include "FLARM/List.hpp"
+#include "FLARM/TrafficStore.hpp"
 #include "util/Macros.hpp"
 #include "util/StringAPI.hxx"
 
@@ -63,8 +64,9 @@ ParsePFLAU(NMEAInputLine &line, FlarmStatus &flarm, TimeStamp clock) noexcept
     line.Read((int)FlarmTraffic::AlarmType::NONE);
 }
 
-void
-ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock) noexcept
+template<typename List>
+static void
+ParseTraffic(NMEAInputLine &line, List &flarm, TimeStamp clock) noexcept
 {
   flarm.modified.Update(clock);
 
@@ -141,14 +143,11 @@ ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock) noexcept
 
   FlarmTraffic *flarm_slot = flarm.FindTraffic(traffic.id);
   if (flarm_slot == nullptr) {
-    flarm_slot = flarm.AllocateTraffic();
+    flarm_slot = flarm.AllocateTraffic(traffic.id);
     if (flarm_slot == nullptr)
       // no more slots available
       return;
 
-    flarm_slot->Clear();
-    flarm_slot->id = traffic.id;
-
     flarm.new_traffic.Update(clock);
   }
 
@@ -157,3 +156,15 @@ ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock) noexcept
 
   flarm_slot->Update(traffic);
 }
+
+void
+ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock) noexcept
+{
+  ParseTraffic(line, flarm, clock);
+}
+
+void
+ParsePFLAA(NMEAInputLine &line, TrafficStore &flarm, TimeStamp clock) noexcept
+{
+  ParseTraffic(line, flarm, clock);
+}
@@ -14,6 +14,7 @@ struct FlarmError;
 struct FlarmVersion;
 struct FlarmStatus;
 struct TrafficList;
+struct TrafficStore;
 
 /**
  * Parses a PFLAE sentence (self-test results).
@@ -60,3 +61,10 @@ ParsePFLAU(NMEAInputLine &line, FlarmStatus &flarm, TimeStamp clock) noexcept;
  */
 void
 ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock) noexcept;
+
+/**
+ * Parses a PFLAA sentence into a #TrafficStore, which has room for
+ * more targets than a #TrafficList.
+ */
+void
+ParsePFLAA(NMEAInputLine &line, TrafficStore &flarm, TimeStamp clock) noexcept;
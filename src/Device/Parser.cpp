@@ -86,7 +86,10 @@ NMEAParser::ParseLine(const char *string, NMEAInfo &info)
     }
 
     if (type2 == "PFLAA"sv) {
-      ParsePFLAA(line, info.flarm.traffic, info.clock);
+      if (traffic_store != nullptr)
+        ParsePFLAA(line, *traffic_store, info.clock);
+      else
+        ParsePFLAA(line, info.flarm.traffic, info.clock);
       return true;
     }
 
@@ -6,6 +6,7 @@
 #include "time/Stamp.hpp"
 
 struct NMEAInfo;
+struct TrafficStore;
 class NMEAInputLine;
 struct GeoPoint;
 struct BrokenDate;
@@ -15,6 +16,12 @@ class NMEAParser
 {
   TimeStamp last_time;
 
+  /**
+   * If set, FLARM traffic is stored here instead of in
+   * NMEAInfo::flarm.
+   */
+  TrafficStore *traffic_store = nullptr;
+
 public:
   bool real;
 
@@ -36,6 +43,16 @@ public:
     use_geoid = false;
   }
 
+  /**
+   * Store FLARM traffic in the given object instead of the (small)
+   * #TrafficList in #NMEAInfo.  The caller is responsible for
+   * protecting it with the same lock as the #NMEAInfo passed to
+   * ParseLine().
+   */
+  void SetTrafficStore(TrafficStore *_traffic_store) noexcept {
+    traffic_store = _traffic_store;
+  }
+
   /**
    * Parses a provided NMEA String into a NMEA_INFO struct
    * @param line NMEA string
@@ -34,10 +34,15 @@
 #include "Blackboard/BlackboardListener.hpp"
 #include "Language/Language.hpp"
 #include "Components.hpp"
+#include "BackendComponents.hpp"
 #include "DataComponents.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Task/ProtectedRoutePlanner.hpp"
+#include "Task/LandableReach.hpp"
 
 #include <algorithm>
 #include <list>
+#include <memory>
 
 #include <cassert>
 #include <stdio.h>
@@ -118,6 +123,13 @@ class WaypointListWidget final
   OrderedTask *const ordered_task;
   const unsigned ordered_task_index;
 
+  /**
+   * The arrival heights calculated by the #CalculationThread, used
+   * to draw the reachability of landables; nullptr if there is no
+   * terrain reach.
+   */
+  std::shared_ptr<const LandableReachTable> landable_reach;
+
 public:
   WaypointListWidget(Waypoints &_way_points, WndForm &_dialog,
                      WaypointFilterWidget &_filter_widget,
@@ -132,6 +144,13 @@ public:
 
   void UpdateList();
 
+  /**
+   * Obtain the latest #LandableReachTable.
+   *
+   * @return true if it has changed
+   */
+  bool UpdateLandableReach() noexcept;
+
   void OnWaypointListEnter();
 
   WaypointPtr GetCursorObject() const {
@@ -172,6 +191,12 @@ public:
 private:
   /* virtual methods from BlackboardListener */
   void OnGPSUpdate([[maybe_unused]] const MoreData &basic) override;
+
+  void OnCalculatedUpdate([[maybe_unused]] const MoreData &basic,
+                          [[maybe_unused]] const DerivedInfo &calculated) override {
+    if (UpdateLandableReach())
+      GetList().Invalidate();
+  }
 };
 
 class WaypointFilterWidget : public RowFormWidget {
@@ -285,9 +310,55 @@ FillLastUsedList(WaypointList &list,
   }
 }
 
+bool
+WaypointListWidget::UpdateLandableReach() noexcept
+{
+  auto table = backend_components != nullptr &&
+    backend_components->glide_computer
+    ? backend_components->glide_computer->GetProtectedRoutePlanner()
+      .GetLandableReach(CommonInterface::GetComputerSettings().task.safety_height_arrival)
+    : nullptr;
+
+  if (table == landable_reach)
+    return false;
+
+  landable_reach = std::move(table);
+  return true;
+}
+
+/**
+ * Determine the reachability of a landable waypoint from the table
+ * calculated by the #CalculationThread.  This does the same as the
+ * map's #WaypointRenderer.
+ */
+[[gnu::pure]]
+static WaypointReachability
+GetReachability(const LandableReachTable *table, const Waypoint &waypoint,
+                const RoutePlannerConfig &config) noexcept
+{
+  if (table == nullptr ||
+      !(waypoint.IsLandable() || waypoint.flags.watched))
+    return WaypointReachability::INVALID;
+
+  const auto *item = table->Find(waypoint.id);
+  if (item == nullptr || !item->reach)
+    /* unknown (out of range) or not reachable */
+    return WaypointReachability::INVALID;
+
+  const ReachResult &reach = *item->reach;
+  if (!reach.IsReachableDirect())
+    return WaypointReachability::UNREACHABLE;
+  else if (config.IsReachEnabled() && !reach.IsReachableTerrain())
+    return WaypointReachability::STRAIGHT;
+  else
+    return WaypointReachability::TERRAIN;
+}
+
 void
 WaypointListWidget::UpdateList()
 {
+  UpdateLandableReach();
+
   items.clear();
 
   if (dialog_state.type_index == TypeFilter::LAST_USED)
@@ -439,7 +510,10 @@ WaypointListWidget::OnPaintItem(Canvas &canvas, const PixelRect rc,
                              info.GetVector(location),
                              row_renderer,
                              UIGlobals::GetMapLook().waypoint,
-                             CommonInterface::GetMapSettings().waypoint);
+                             CommonInterface::GetMapSettings().waypoint,
+                             GetReachability(landable_reach.get(),
+                                             *info.waypoint,
+                                             CommonInterface::GetComputerSettings().task.route_planner));
 }
 
 void
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "GlideBatch.hpp"
+#include "GlideState.hpp"
+#include "Math/Util.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+void
+GlideBatch::reserve(std::size_t n) noexcept
+{
+  distance.reserve(n);
+  bearing.reserve(n);
+  min_arrival_altitude.reserve(n);
+  effective_wind_angle.reserve(n);
+  head_wind.reserve(n);
+}
+
+void
+GlideBatch::Add(const GeoVector &vector, double _min_arrival_altitude) noexcept
+{
+  distance.push_back(vector.distance);
+  bearing.push_back(vector.bearing);
+  min_arrival_altitude.push_back(_min_arrival_altitude);
+
+  /* see GlideState::CalcSpeedups() */
+  if (wind.IsNonZero()) {
+    const Angle angle = wind.bearing.Reciprocal() - vector.bearing;
+    effective_wind_angle.push_back(angle);
+    head_wind.push_back(-wind.norm * angle.cos());
+  } else {
+    effective_wind_angle.push_back(Angle::Zero());
+    head_wind.push_back(0);
+  }
+}
+
+GlideState
+GlideBatch::GetState(std::size_t i) const noexcept
+{
+  assert(i < size());
+
+  GlideState state;
+  state.vector = GeoVector(distance[i], bearing[i]);
+  state.min_arrival_altitude = min_arrival_altitude[i];
+  state.altitude_difference = altitude - min_arrival_altitude[i];
+  state.effective_wind_angle = effective_wind_angle[i];
+  state.head_wind = head_wind[i];
+
+  if (wind.IsNonZero()) {
+    state.wind = wind;
+    state.wind_speed_squared = Square(wind.norm);
+  } else {
+    state.wind = SpeedVector::Zero();
+    state.wind_speed_squared = 0;
+  }
+
+  return state;
+}
+
+void
+GlideBatch::CalcAverageSpeed(const double v_eff,
+                             std::span<double> dest) const noexcept
+{
+  assert(dest.size() == size());
+
+  if (wind.IsZero()) {
+    std::fill(dest.begin(), dest.end(), v_eff);
+    return;
+  }
+
+  /* the same quadratic equation as in GlideState::CalcAverageSpeed(),
+     without branches so this loop can be vectorised */
+  const auto c = Square(wind.norm) - Square(v_eff);
+  const double *hw = head_wind.data();
+  double *d = dest.data();
+  const std::size_t n = size();
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto b = 2 * hw[i];
+    const auto denom = Square(b) - 4 * c;
+    d[i] = denom >= 0 ? (-b + sqrt(std::max(denom, 0.))) / 2 : -1.;
+  }
+}
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/GeoVector.hpp"
+#include "Geo/SpeedVector.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+struct GlideState;
+
+/**
+ * Glide tasks from one aircraft position to many destinations, all
+ * sharing the aircraft altitude and the wind.  The destinations are
+ * stored as a structure of arrays, so the batch overloads of
+ * MacCready::Solve() and MacCready::SolveStraight() can process them
+ * in tight loops which the compiler can vectorise.
+ *
+ * The wind components of each destination are calculated by Add(),
+ * the same way the #GlideState constructor does.
+ */
+class GlideBatch {
+  double altitude;
+  SpeedVector wind;
+
+  std::vector<double> distance;
+  std::vector<Angle> bearing;
+  std::vector<double> min_arrival_altitude;
+  std::vector<Angle> effective_wind_angle;
+  std::vector<double> head_wind;
+
+public:
+  /**
+   * @param altitude the altitude of the aircraft
+   * @param wind the wind vector
+   */
+  GlideBatch(double _altitude, SpeedVector _wind) noexcept
+    :altitude(_altitude), wind(_wind) {}
+
+  std::size_t size() const noexcept {
+    return distance.size();
+  }
+
+  bool empty() const noexcept {
+    return distance.empty();
+  }
+
+  void reserve(std::size_t n) noexcept;
+
+  /**
+   * Add a destination.
+   *
+   * @param vector the vector from the aircraft to the destination
+   * @param min_arrival_altitude the minimum arrival altitude at the
+   * destination (m above MSL)
+   */
+  void Add(const GeoVector &vector, double min_arrival_altitude) noexcept;
+
+  /**
+   * Construct the #GlideState of one destination, without
+   * recalculating its wind components.
+   */
+  [[gnu::pure]]
+  GlideState GetState(std::size_t i) const noexcept;
+
+  /**
+   * Calculate the average speed over ground to each destination
+   * (see GlideState::CalcAverageSpeed()).
+   *
+   * @param v_eff Effective cruise speed (m/s)
+   * @param dest receives the speed for each destination, or a
+   * negative value if the wind is too strong
+   */
+  void CalcAverageSpeed(double v_eff, std::span<double> dest) const noexcept;
+};
@@ -10,9 +10,16 @@
 #include "Navigation/Aircraft.hpp"
 
 #include <algorithm>
+#include <atomic>
 
 #include <cassert>
 
+/**
+ * The source of GlidePolar::serial values.  A wraparound is harmless
+ * unless a cache misses all of the 2^32 modifications in between.
+ */
+static std::atomic<unsigned> next_serial{1};
+
 GlidePolar::GlidePolar(const double _mc, const double _bugs,
                        const double _ballast) noexcept
   :mc(_mc),
@@ -35,13 +42,22 @@ GlidePolar::GlidePolar(const double _mc, const double _bugs,
   SetMC(mc);
 }
 
+void
+GlidePolar::Modified() noexcept
+{
+  serial = next_serial.fetch_add(1, std::memory_order_relaxed);
+}
+
 void
 GlidePolar::Update() noexcept
 {
+  Modified();
+
   assert(bugs > 0);
 
   if (!reference_polar.IsValid()) {
     Vmin = Vmax = 0;
+    glide_speed_step = 0;
     return;
   }
 
@@ -56,6 +72,7 @@ GlidePolar::Update() noexcept
 
   UpdateSMax();
   UpdateSMin();
+  UpdateGlideSpeedTable();
 }
 
 void
@@ -93,6 +110,7 @@ void
 GlidePolar::SetMC(const double _mc) noexcept
 {
   mc = _mc;
+  Modified();
 
   if (mc > 0)
     inv_mc = 1. / mc;
@@ -228,6 +246,120 @@ GlidePolar::UpdateSMin() noexcept
   UpdateBestLD();
 }
 
+/**
+ * Finds the airspeed for the best glide ratio over ground at
+ * MacCready zero; this is the same function MacCreadyVopt minimises.
+ * Intended to be used temporarily.
+ */
+class GlidePolarGlideSpeed final : public ZeroFinder {
+  static constexpr double TOLERANCE_GLIDE_SPEED = 0.0001;
+
+  const GlidePolar &polar;
+  const double head_wind;
+  const double cross_wind_squared;
+
+public:
+  /**
+   * Constructor.
+   *
+   * @param _polar Glide polar to optimise
+   * @param _head_wind Head wind component (m/s)
+   * @param cross_wind Cross wind component (m/s)
+   * @param vmin Minimum speed to search (m/s)
+   * @param vmax Maximum speed to search (m/s)
+   *
+   * @return Initialised object (no search yet)
+   */
+  GlidePolarGlideSpeed(const GlidePolar &_polar, const double _head_wind,
+                       const double cross_wind, const double vmin,
+                       const double vmax) noexcept
+    :ZeroFinder(vmin, vmax, TOLERANCE_GLIDE_SPEED),
+     polar(_polar),
+     head_wind(_head_wind),
+     cross_wind_squared(Square(cross_wind))
+  {
+  }
+
+  /**
+   * Inverse glide ratio over ground, magnified like in
+   * MacCreadyVopt
+   *
+   * @param V Airspeed (m/s)
+   */
+  double f(const double V) noexcept override {
+    const auto along_track = Square(V) - cross_wind_squared;
+    if (along_track <= 0)
+      return 1000000;
+
+    const auto ground_speed = sqrt(along_track) - head_wind;
+    if (ground_speed <= 0)
+      return 1000000;
+
+    return polar.SinkRate(V) * 1024 / ground_speed;
+  }
+
+  /**
+   * Find the best glide speed
+   *
+   * @return Speed (m/s), or -1 if no glide is possible in this wind
+   */
+  double solve() noexcept {
+    const auto V = find_min(xmin);
+    return f(V) < 1000000 ? V : -1.;
+  }
+};
+
+void
+GlidePolar::UpdateGlideSpeedTable() noexcept
+{
+  assert(polar.IsValid());
+
+  /* cover winds up to 40% of the maximum speed; stronger winds are
+     left to MacCready's search */
+  constexpr unsigned calm_row = GLIDE_SPEED_HEAD_WIND_STEPS / 2;
+  glide_speed_step = 0.4 * Vmax / calm_row;
+
+  for (unsigned i = 0; i < GLIDE_SPEED_HEAD_WIND_STEPS; ++i) {
+    const auto head_wind = (int(i) - int(calm_row)) * glide_speed_step;
+    for (unsigned j = 0; j < GLIDE_SPEED_CROSS_WIND_STEPS; ++j) {
+      GlidePolarGlideSpeed gp_gs(*this, head_wind, j * glide_speed_step,
+                                 Vmin, Vmax);
+      glide_speed_table[i][j] = gp_gs.solve();
+    }
+  }
+}
+
+double
+GlidePolar::LookupGlideSpeed(const double head_wind,
+                             const double cross_wind) const noexcept
+{
+  if (glide_speed_step <= 0)
+    return -1;
+
+  constexpr unsigned calm_row = GLIDE_SPEED_HEAD_WIND_STEPS / 2;
+  const auto x = head_wind / glide_speed_step + calm_row;
+  const auto y = fabs(cross_wind) / glide_speed_step;
+  if (!(x >= 0 && x <= GLIDE_SPEED_HEAD_WIND_STEPS - 1 &&
+        y <= GLIDE_SPEED_CROSS_WIND_STEPS - 1))
+    return -1;
+
+  const unsigned i = std::min(unsigned(x), GLIDE_SPEED_HEAD_WIND_STEPS - 2);
+  const unsigned j = std::min(unsigned(y), GLIDE_SPEED_CROSS_WIND_STEPS - 2);
+
+  const auto v00 = glide_speed_table[i][j];
+  const auto v01 = glide_speed_table[i][j + 1];
+  const auto v10 = glide_speed_table[i + 1][j];
+  const auto v11 = glide_speed_table[i + 1][j + 1];
+  if (v00 < 0 || v01 < 0 || v10 < 0 || v11 < 0)
+    /* no glide possible at one of the corners; the optimum is not
+       smooth here */
+    return -1;
+
+  const auto fx = x - i, fy = y - j;
+  return (1 - fx) * ((1 - fy) * v00 + fy * v01) +
+    fx * ((1 - fy) * v10 + fy * v11);
+}
+
 bool
 GlidePolar::IsGlidePossible(const GlideState &task) const noexcept
 {
@@ -406,11 +538,28 @@ GlidePolar::GetLDOverGround(Angle track, SpeedVector wind) const noexcept
   if (wind.IsZero())
     return bestLD;
 
-  const auto c_theta = (wind.bearing.Reciprocal() - track).cos();
+  return GetLDOverGround((wind.bearing.Reciprocal() - track).cos(),
+                         wind.norm);
+}
 
+double
+GlidePolar::GetLDOverGround(const GlideState &task) const noexcept
+{
+  if (task.wind.IsZero())
+    return bestLD;
+
+  /* the head wind component is the negative cosine of the
+     effective wind angle multiplied by the wind speed; this saves a
+     trigonometric function */
+  return GetLDOverGround(-task.head_wind / task.wind.norm, task.wind.norm);
+}
+
+inline double
+GlidePolar::GetLDOverGround(double c_theta, double wind_speed) const noexcept
+{
   /* convert the wind speed into some sort of "virtual L/D" to put it
      in relation to the polar's best L/D */
-  const auto wind_ld = wind.norm / GetSBestLD();
+  const auto wind_ld = wind_speed / GetSBestLD();
 
   Quadratic q(-2 * wind_ld * c_theta,
               Square(wind_ld) - Square(bestLD));
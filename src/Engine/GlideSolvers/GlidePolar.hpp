@@ -39,6 +39,15 @@ class GlidePolar
   static constexpr double TOLERANCE_MIN_SINK = 0.01;
   static constexpr double TOLERANCE_BEST_LD = 0.000001;
 
+  /**
+   * Number of head wind rows of #glide_speed_table; odd, so the
+   * middle row is calm.
+   */
+  static constexpr unsigned GLIDE_SPEED_HEAD_WIND_STEPS = 13;
+
+  /** Number of cross wind columns of #glide_speed_table */
+  static constexpr unsigned GLIDE_SPEED_CROSS_WIND_STEPS = 7;
+
   /** MacCready ring setting (m/s) */
   double mc;
   /** Inverse of MC setting (s/m) */
@@ -84,6 +93,29 @@ class GlidePolar
   /** Reference wing area, m^2 */
   double wing_area;
 
+  /**
+   * Wind component step of #glide_speed_table (m/s); zero if the
+   * table has not been built.
+   */
+  double glide_speed_step;
+
+  /**
+   * Airspeed for the best glide ratio over ground at MacCready zero
+   * (m/s), tabulated over head wind (rows, centered on calm) and
+   * cross wind (columns) in multiples of #glide_speed_step.  A
+   * negative value marks a wind in which no glide is possible.
+   * Built by UpdateGlideSpeedTable() whenever the polar changes.
+   */
+  double glide_speed_table[GLIDE_SPEED_HEAD_WIND_STEPS][GLIDE_SPEED_CROSS_WIND_STEPS];
+
+  /**
+   * Identifies the state of this object: every modification assigns
+   * a new value from a global counter, so two objects with the same
+   * serial have the same contents.  See GetSerial().  Uninitialized
+   * in a default-constructed object, like all other attributes.
+   */
+  unsigned serial;
+
   friend class GlidePolarTest;
 
 public:
@@ -129,6 +161,16 @@ public:
     return Vmin < Vmax;
   }
 
+  /**
+   * Returns a number which changes with each modification of this
+   * object (and of the object it was copied from).  This allows
+   * checking cheaply whether a cached value derived from this polar
+   * is still valid.
+   */
+  constexpr unsigned GetSerial() const noexcept {
+    return serial;
+  }
+
   /**
    * Accesses minimum sink rate
    *
@@ -163,10 +205,12 @@ public:
 
   void SetVMax(double _v_max, bool update = true) noexcept {
     Vmax = _v_max;
+    Modified();
 
     if (update) {
       UpdateSMax();
       UpdateSMin();
+      UpdateGlideSpeedTable();
     }
   }
 
@@ -221,6 +265,21 @@ public:
   [[gnu::pure]]
   double GetBestGlideRatioSpeed(double head_wind) const noexcept;
 
+  /**
+   * Look up the airspeed for the best glide ratio over ground at
+   * MacCready zero (i.e. the speed MacCready::OptimiseGlide()
+   * searches for) in the table built on polar change, interpolating
+   * between the table's wind steps.  The table assumes a cruise
+   * efficiency of 1.
+   *
+   * @param head_wind Head wind component (m/s)
+   * @param cross_wind Cross wind component (m/s)
+   * @return Speed (m/s), or a negative value if the wind is outside
+   * the table
+   */
+  [[gnu::pure]]
+  double LookupGlideSpeed(double head_wind, double cross_wind) const noexcept;
+
   /**
    * Takeoff speed
    * @return Takeoff speed threshold (m/s)
@@ -235,6 +294,7 @@ public:
    */
   void SetCruiseEfficiency(const double _ce) noexcept {
     cruise_efficiency = _ce;
+    Modified();
   }
 
   /**
@@ -464,6 +524,17 @@ public:
   [[gnu::pure]]
   double GetLDOverGround(const AircraftState &state) const noexcept;
 
+  /**
+   * Find LD relative to ground for the direction of the specified
+   * glide task, using its precalculated head wind component
+   *
+   * @param task the glide task (for direction and wind)
+   *
+   * @return LD ratio (distance travelled per unit height loss)
+   */
+  [[gnu::pure]]
+  double GetLDOverGround(const GlideState &task) const noexcept;
+
   /**
    * Calculates the thermal value of next leg that is equivalent (gives the
    * same average speed) to the current MacCready setting.
@@ -483,8 +554,9 @@ public:
   }
 
   /** Sets the wing area in m^2 */
-  constexpr void SetWingArea(double _wing_area) noexcept {
+  void SetWingArea(double _wing_area) noexcept {
     wing_area = _wing_area;
+    Modified();
   }
 
   /** Returns the reference mass in kg */
@@ -498,6 +570,8 @@ public:
 
     if (update)
       Update();
+    else
+      Modified();
   }
 
   /** Returns the dry mass in kg */
@@ -516,6 +590,8 @@ public:
 
     if (update)
       Update();
+    else
+      Modified();
   }
   
   /** Sets the crew mass in kg */
@@ -524,6 +600,8 @@ public:
 
     if (update)
       Update();
+    else
+      Modified();
   }
   
   /** Returns the crew mass in kg */
@@ -537,8 +615,9 @@ public:
   }
 
   /** Sets the ballast ratio */
-  constexpr void SetBallastRatio(double _ballast_ratio) noexcept {
+  void SetBallastRatio(double _ballast_ratio) noexcept {
     ballast_ratio = _ballast_ratio;
+    Modified();
   }
 
   /** Returns the ideal polar coefficients */
@@ -557,6 +636,8 @@ public:
 
     if (update)
       Update();
+    else
+      Modified();
   }
 
   /** Update glide polar coefficients and values depending on them */
@@ -567,6 +648,12 @@ public:
   double GetAverageSpeed() const noexcept;
 
 private:
+  /**
+   * Assign a new #serial.  Must be called by each method which
+   * modifies this object.
+   */
+  void Modified() noexcept;
+
   /** Update sink rate at max. cruise speed */
   void UpdateSMax() noexcept;
 
@@ -575,6 +662,16 @@ private:
 
   /** Solve for min sink rate at current bugs/ballast setting. */
   void UpdateSMin() noexcept;
+
+  /** Rebuild #glide_speed_table for the current polar and #Vmax. */
+  void UpdateGlideSpeedTable() noexcept;
+
+  /**
+   * Find LD relative to ground, given the cosine of the angle
+   * between track and reciprocal wind bearing.
+   */
+  [[gnu::pure]]
+  double GetLDOverGround(double c_theta, double wind_speed) const noexcept;
 };
 
 static_assert(std::is_trivial<GlidePolar>::value, "type is not trivial");
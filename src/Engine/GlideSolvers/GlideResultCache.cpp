@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "GlideResultCache.hpp"
+#include "GlidePolar.hpp"
+#include "GlideState.hpp"
+#include "MacCready.hpp"
+
+#include <bit>
+#include <cstdint>
+
+inline
+GlideResultCache::Key::Key(const GlideState &state) noexcept
+  :distance(state.vector.distance),
+   bearing(state.vector.bearing.Native()),
+   min_arrival_altitude(state.min_arrival_altitude),
+   altitude_difference(state.altitude_difference),
+   wind_norm(state.wind.norm),
+   wind_bearing(state.wind.bearing.Native()) {}
+
+inline unsigned
+GlideResultCache::Key::Hash() const noexcept
+{
+  uint64_t h = std::bit_cast<uint64_t>(distance);
+  h = h * 0x9e3779b97f4a7c15ULL ^ std::bit_cast<uint64_t>(bearing);
+  h = h * 0x9e3779b97f4a7c15ULL ^ std::bit_cast<uint64_t>(altitude_difference);
+  h *= 0x9e3779b97f4a7c15ULL;
+  return unsigned(h >> 32) % SIZE;
+}
+
+GlideResultCache::GlideResultCache() noexcept
+{
+  for (auto &i : items)
+    i.generation = 0;
+}
+
+void
+GlideResultCache::Clear() noexcept
+{
+  if (++generation == 0) {
+    /* wraparound: mark all items unused explicitly */
+    for (auto &i : items)
+      i.generation = 0;
+    generation = 1;
+  }
+}
+
+inline void
+GlideResultCache::CheckParameters(const GlideSettings &_settings,
+                                  const GlidePolar &_glide_polar) noexcept
+{
+  /* the serial changes with every modification of the polar
+     (e.g. by TaskBestMc, which changes the MacCready setting for
+     each iteration) */
+  if (have_parameters &&
+      settings.predict_wind_drift == _settings.predict_wind_drift &&
+      polar_serial == _glide_polar.GetSerial())
+    return;
+
+  Clear();
+  settings = _settings;
+  polar_serial = _glide_polar.GetSerial();
+  have_parameters = true;
+}
+
+GlideResult
+GlideResultCache::Solve(const GlideSettings &_settings,
+                        const GlidePolar &_glide_polar,
+                        const GlideState &state) noexcept
+{
+  CheckParameters(_settings, _glide_polar);
+
+  const Key key(state);
+  Item &item = items[key.Hash()];
+  if (item.generation == generation && item.key == key)
+    return item.result;
+
+  item.key = key;
+  item.result = MacCready::Solve(settings, _glide_polar, state);
+  item.generation = generation;
+  return item.result;
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "GlideResult.hpp"
+#include "GlideSettings.hpp"
+
+#include <array>
+
+class GlidePolar;
+struct GlideState;
+
+/**
+ * A small cache for MacCready::Solve() results.  The task solvers
+ * (TaskMinTarget, TaskOptTarget, TaskBestMc) solve the same legs over
+ * and over, both during one search and in consecutive calculation
+ * cycles; only the legs whose targets have moved need to be solved
+ * again.
+ *
+ * The cache is keyed on the #GlideState (leg vector, altitudes and
+ * wind); it is flushed automatically when the #GlidePolar or the
+ * #GlideSettings change.
+ *
+ * This class is not thread-safe.
+ */
+class GlideResultCache {
+  static constexpr unsigned SIZE = 64;
+
+  struct Key {
+    double distance;
+    double bearing;
+    double min_arrival_altitude;
+    double altitude_difference;
+    double wind_norm;
+    double wind_bearing;
+
+    Key() noexcept = default;
+    explicit Key(const GlideState &state) noexcept;
+
+    [[gnu::pure]]
+    unsigned Hash() const noexcept;
+
+    bool operator==(const Key &other) const noexcept = default;
+  };
+
+  struct Item {
+    Key key;
+    GlideResult result;
+
+    /**
+     * The #generation this item belongs to; a different value means
+     * the item is unused.
+     */
+    unsigned generation;
+  };
+
+  std::array<Item, SIZE> items;
+
+  /**
+   * Incremented by Clear(), which invalidates all items.  Starts at
+   * 1 so zero-initialised items are unused.
+   */
+  unsigned generation = 1;
+
+  /**
+   * The parameters the cached results were calculated with (the
+   * polar is identified by GlidePolar::GetSerial()); only valid if
+   * #have_parameters is set.
+   */
+  unsigned polar_serial;
+  GlideSettings settings;
+  bool have_parameters = false;
+
+public:
+  GlideResultCache() noexcept;
+
+  /**
+   * Forget all cached results.
+   */
+  void Clear() noexcept;
+
+  /**
+   * Returns the result of MacCready::Solve() for the given
+   * parameters, from the cache if possible.
+   */
+  GlideResult Solve(const GlideSettings &settings,
+                    const GlidePolar &glide_polar,
+                    const GlideState &state) noexcept;
+
+private:
+  void CheckParameters(const GlideSettings &_settings,
+                       const GlidePolar &_glide_polar) noexcept;
+};
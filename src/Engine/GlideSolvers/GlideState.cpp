@@ -4,6 +4,8 @@
 #include "GlideState.hpp"
 #include "Math/Quadratic.hpp"
 
+#include <algorithm>
+
 /**
  * Quadratic function solver for MacCready theory constraint equation
  *
@@ -81,23 +83,14 @@ GlideState::DriftedDistance(const FloatDuration time) const
   if (wind.IsZero())
     return vector.distance;
 
-  // Distance that the wine travels in the given #time
+  // Distance that the wind travels in the given #time
   const auto distance_wind = wind.norm * time.count();
-  // Direction of the wind
-  auto sc_wind = wind.bearing.Reciprocal().SinCos();
-  const auto sin_wind = sc_wind.first, cos_wind = sc_wind.second;
-
-  // Distance to the target
-  const auto distance_task = vector.distance;
-  // Direction to the target
-  auto sc_task = vector.bearing.SinCos();
-  const auto sin_task = sc_task.first, cos_task = sc_task.second;
-
-  // X-/Y-Components of the resulting vector
-  const auto dx = distance_task * sin_task - distance_wind * sin_wind;
-  const auto dy = distance_task * cos_task - distance_wind * cos_wind;
 
-  return hypot(dx, dy);
+  /* law of cosines; the cosine of the angle between the task and the
+     wind drift is the head wind component divided by the wind speed,
+     which saves the trigonometric functions */
+  const auto distance_squared = Square(vector.distance) +
+    Square(distance_wind) + 2 * vector.distance * time.count() * head_wind;
 
-  // ??   task.Bearing = RAD_TO_DEG*(atan2(dx,dy));
+  return sqrt(std::max(distance_squared, 0.));
 }
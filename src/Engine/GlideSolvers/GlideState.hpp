@@ -37,6 +37,13 @@ private:
   /** (internal use) */
   double wind_speed_squared;
 
+  friend class GlideBatch;
+
+  /**
+   * Uninitialised state, to be filled by GlideBatch::GetState().
+   */
+  GlideState() noexcept = default;
+
 public:
   /**
    * Dummy task constructor.  Typically used for synthetic glide
@@ -66,6 +73,15 @@ public:
    */
   void CalcSpeedups(const SpeedVector wind);
 
+  /**
+   * Cross wind component (m/s) in cruise; the sign depends on the
+   * side the wind comes from.
+   */
+  [[gnu::pure]]
+  double GetCrossWind() const noexcept {
+    return wind.norm * effective_wind_angle.sin();
+  }
+
   /**
    * Calculates average cross-country speed from effective
    * cross-country speed (accounting for wind)
@@ -2,12 +2,14 @@
 // Copyright The XCSoar Project
 
 #include "MacCready.hpp"
+#include "GlideBatch.hpp"
 #include "GlideState.hpp"
 #include "GlidePolar.hpp"
 #include "GlideResult.hpp"
 #include "Math/ZeroFinder.hpp"
 
 #include <cassert>
+#include <vector>
 
 MacCready::MacCready(const GlideSettings &_settings,
                      const GlidePolar &_glide_polar,
@@ -42,6 +44,7 @@ MacCready::SolveVertical(const GlideState &task) const
     result.height_climb = 0;
     result.height_glide = 0;
     result.time_elapsed = {};
+    result.time_virtual = {};
     result.validity = GlideResult::Validity::OK;
     return result;
   }
@@ -91,8 +94,23 @@ MacCready::SolveSink(const GlideSettings &settings,
   return mac.SolveSink(task, sink_rate);
 }
 
+double
+MacCready::GetCruiseSpeed() const
+{
+  const auto rho = glide_polar.GetSBestLD() * glide_polar.GetInvMC();
+  return glide_polar.GetVBestLD() * cruise_efficiency * (1. / (1 + rho));
+}
+
 GlideResult
 MacCready::SolveCruise(const GlideState &task) const
+{
+  return SolveCruiseAtGroundSpeed(task,
+                                  task.CalcAverageSpeed(GetCruiseSpeed()));
+}
+
+GlideResult
+MacCready::SolveCruiseAtGroundSpeed(const GlideState &task,
+                                    const double estimated_speed) const
 {
   // cruise speed for current MC (m/s)
   const auto mc_speed = glide_polar.GetVBestLD();
@@ -132,8 +150,6 @@ MacCready::SolveCruise(const GlideState &task) const
   // quotient of resulting speed over cruise speed (0 .. 1)
   const auto inv_rho_plus_one = 1. / rho_plus_one;
 
-  const auto estimated_speed =
-      task.CalcAverageSpeed(mc_speed * cruise_efficiency * inv_rho_plus_one);
   if (estimated_speed <= 0) {
     result.validity = GlideResult::Validity::WIND_EXCESSIVE;
     result.vector.distance = 0;
@@ -167,7 +183,7 @@ MacCready::SolveCruise(const GlideState &task) const
 
   result.validity = GlideResult::Validity::OK;
   result.pure_glide_height = task.vector.distance /
-    glide_polar.GetLDOverGround(task.vector.bearing, task.wind);
+    glide_polar.GetLDOverGround(task);
   result.pure_glide_altitude_difference -= result.pure_glide_height;
 
   return result;
@@ -177,15 +193,25 @@ GlideResult
 MacCready::SolveGlide(const GlideState &task, const double v_set,
                       const double sink_rate, const bool allow_partial) const
 {
-  // spend a lot of time in this function, so it should be quick!
-
-  GlideResult result(task, v_set);
-
   // distance relation
   //   V*V=Vn*Vn+W*W-2*Vn*W*cos(theta)
   //     Vn*Vn-2*Vn*W*cos(theta)+W*W-V*V=0  ... (1)
 
-  const auto estimated_speed = task.CalcAverageSpeed(v_set * cruise_efficiency);
+  return SolveGlideAtGroundSpeed(task, v_set, sink_rate,
+                                 task.CalcAverageSpeed(v_set * cruise_efficiency),
+                                 allow_partial);
+}
+
+GlideResult
+MacCready::SolveGlideAtGroundSpeed(const GlideState &task, const double v_set,
+                                   const double sink_rate,
+                                   const double estimated_speed,
+                                   const bool allow_partial) const
+{
+  // spend a lot of time in this function, so it should be quick!
+
+  GlideResult result(task, v_set);
+
   if (estimated_speed <= 0) {
     result.validity = GlideResult::Validity::WIND_EXCESSIVE;
     result.vector.distance = 0;
@@ -298,6 +324,96 @@ MacCready::Solve(const GlideState &task) const
   return result_fg;
 }
 
+void
+MacCready::SolveStraight(const GlideBatch &batch,
+                         std::span<GlideResult> results) const
+{
+  assert(results.size() == batch.size());
+
+  if (!glide_polar.IsValid() || glide_polar.GetMC() <= 0) {
+    /* the speed is not the same for all destinations */
+    for (std::size_t i = 0; i < batch.size(); ++i)
+      results[i] = SolveStraight(batch.GetState(i));
+    return;
+  }
+
+  const auto v = glide_polar.GetVBestLD();
+  const auto sink_rate = glide_polar.SinkRate(v);
+
+  std::vector<double> glide_speed(batch.size());
+  batch.CalcAverageSpeed(v * cruise_efficiency, glide_speed);
+
+  for (std::size_t i = 0; i < batch.size(); ++i) {
+    const GlideState task = batch.GetState(i);
+    results[i] = task.vector.distance <= 0
+      ? SolveVertical(task)
+      : SolveGlideAtGroundSpeed(task, v, sink_rate, glide_speed[i], false);
+  }
+}
+
+void
+MacCready::Solve(const GlideBatch &batch, std::span<GlideResult> results) const
+{
+  assert(results.size() == batch.size());
+
+  if (!glide_polar.IsValid() || glide_polar.GetMC() <= 0) {
+    /* the speed is not the same for all destinations */
+    for (std::size_t i = 0; i < batch.size(); ++i)
+      results[i] = Solve(batch.GetState(i));
+    return;
+  }
+
+  const auto v = glide_polar.GetVBestLD();
+  const auto sink_rate = glide_polar.SinkRate(v);
+
+  /* the wind triangle for the glide and the cruise speed is solved
+     for all destinations at once */
+  const std::size_t n = batch.size();
+  std::vector<double> ground_speed(2 * n);
+  const std::span<double> glide_speed{ground_speed.data(), n};
+  const std::span<double> cruise_speed{ground_speed.data() + n, n};
+  batch.CalcAverageSpeed(v * cruise_efficiency, glide_speed);
+  batch.CalcAverageSpeed(GetCruiseSpeed(), cruise_speed);
+
+  /* the rest is the same as in Solve(const GlideState &) */
+  for (std::size_t i = 0; i < n; ++i) {
+    const GlideState task = batch.GetState(i);
+
+    if (task.vector.distance <= 0) {
+      results[i] = SolveVertical(task);
+      continue;
+    }
+
+    if (task.altitude_difference < 0) {
+      results[i] = SolveCruiseAtGroundSpeed(task, cruise_speed[i]);
+      continue;
+    }
+
+    GlideResult &result_fg = results[i];
+    result_fg = SolveGlideAtGroundSpeed(task, v, sink_rate,
+                                        glide_speed[i], true);
+    if (result_fg.validity == GlideResult::Validity::OK &&
+        task.vector.distance - result_fg.vector.distance <= 0)
+      continue;
+
+    /* the remainder has the same bearing and thus the same cruise
+       ground speed */
+    GlideState sub_task = task;
+    sub_task.vector.distance -= result_fg.vector.distance;
+    sub_task.altitude_difference -= result_fg.height_glide;
+
+    result_fg.Add(SolveCruiseAtGroundSpeed(sub_task, cruise_speed[i]));
+  }
+}
+
+void
+MacCready::Solve(const GlideSettings &settings, const GlidePolar &glide_polar,
+                 const GlideBatch &batch, std::span<GlideResult> results)
+{
+  const MacCready mac(settings, glide_polar);
+  mac.Solve(batch, results);
+}
+
 /**
  * Class used to find VOpt to optimize glide distance, for final glide
  * calculations.  Intended to be used temporarily only.
@@ -367,6 +483,15 @@ MacCready::OptimiseGlide(const GlideState &task, const bool allow_partial) const
 {
   assert(glide_polar.GetMC() <= 0);
 
+  if (cruise_efficiency == 1) {
+    /* the optimum depends only on the polar and the wind components,
+       so GlidePolar keeps a table of it */
+    const auto v = glide_polar.LookupGlideSpeed(task.head_wind,
+                                                task.GetCrossWind());
+    if (v > 0)
+      return SolveGlide(task, v, allow_partial);
+  }
+
   MacCreadyVopt mc_vopt(task, *this,
                        glide_polar.GetVMin(), glide_polar.GetVMax(),
                        allow_partial);
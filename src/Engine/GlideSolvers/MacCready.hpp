@@ -5,10 +5,13 @@
 
 #include "util/Compiler.h"
 
+#include <span>
+
 struct GlideSettings;
 struct GlideState;
 struct GlideResult;
 class GlidePolar;
+class GlideBatch;
 
 /**
  *  Helper class used to calculate times/speeds and altitude differences
@@ -68,6 +71,14 @@ public:
   [[gnu::pure]]
   GlideResult SolveStraight(const GlideState &task) const;
 
+  /**
+   * SolveStraight() for all destinations of a #GlideBatch.
+   *
+   * @param results receives one result per destination
+   */
+  void SolveStraight(const GlideBatch &batch,
+                     std::span<GlideResult> results) const;
+
   /** 
    * Calculates the glide solution for a classical MacCready theory task.
    * Internally different calculations are used depending on the nature of the
@@ -85,6 +96,22 @@ public:
                            const GlidePolar &glide_polar,
                            const GlideState &task);
 
+  /**
+   * Solve() for all destinations of a #GlideBatch.  The results are
+   * the same as solving each destination's #GlideState, but the
+   * parts which depend only on the polar and the wind are calculated
+   * once, and the wind triangle is solved for all destinations in one
+   * loop.
+   *
+   * @param results receives one result per destination
+   */
+  void Solve(const GlideBatch &batch, std::span<GlideResult> results) const;
+
+  static void Solve(const GlideSettings &settings,
+                    const GlidePolar &glide_polar,
+                    const GlideBatch &batch,
+                    std::span<GlideResult> results);
+
   /**
    * Calculates the glide solution for a classical MacCready theory task
    * with no climb component (pure glide).  This is used internally to
@@ -124,6 +151,18 @@ private:
              const double sink_rate,
              const bool allow_partial = false) const;
 
+  /**
+   * Like SolveGlide(), but with the average speed over ground already
+   * calculated by GlideState::CalcAverageSpeed().
+   *
+   * @param estimated_speed Average speed over ground (m/s)
+   */
+  [[gnu::pure]]
+  GlideResult
+  SolveGlideAtGroundSpeed(const GlideState &task, double v_set,
+                          double sink_rate, double estimated_speed,
+                          bool allow_partial) const;
+
   /**
    * Solve a task which is known to be pure glide,
    * seeking optimal speed to fly.
@@ -161,4 +200,21 @@ private:
    */
   [[gnu::pure]]
   GlideResult SolveCruise(const GlideState &task) const;
+
+  /**
+   * Like SolveCruise(), but with the average speed over ground
+   * already calculated from GetCruiseSpeed().
+   *
+   * @param estimated_speed Average speed over ground (m/s)
+   */
+  [[gnu::pure]]
+  GlideResult SolveCruiseAtGroundSpeed(const GlideState &task,
+                                       double estimated_speed) const;
+
+  /**
+   * Effective cruise speed (m/s) including climbs at the current MC
+   * setting, i.e. the average speed in still air.
+   */
+  [[gnu::pure]]
+  double GetCruiseSpeed() const;
 };
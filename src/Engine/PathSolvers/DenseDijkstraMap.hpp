@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "ScanTaskPoint.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * An edge map for #NavDijkstra which stores the edges in an array
+ * indexed by stage and point index, for searches where the number of
+ * points per stage is known in advance (e.g. #TaskDijkstra).
+ *
+ * The array is an arena which is kept across searches: each slot
+ * carries a generation number, and clear() just starts a new
+ * generation instead of destroying the items.  Items never move, so
+ * iterators stay valid until the next clear() or Resize().
+ */
+struct DenseDijkstraMap {
+  template<typename Value>
+  class Bind {
+  public:
+    using value_type = std::pair<ScanTaskPoint, Value>;
+    using iterator = value_type *;
+    using const_iterator = const value_type *;
+
+  private:
+    std::vector<value_type> slots;
+    std::vector<uint32_t> generations;
+
+    uint32_t generation = 1;
+
+    /**
+     * The maximum number of points per stage.
+     */
+    unsigned stride = 0;
+
+  public:
+    /**
+     * Prepare the map for a search with the given dimensions and
+     * clear it.  Memory is only allocated if the map needs to grow.
+     */
+    void Resize(unsigned num_stages, unsigned stage_size) noexcept {
+      const std::size_t size = std::size_t(num_stages) * stage_size;
+      if (size > slots.size()) {
+        slots.resize(size);
+        generations.resize(size, 0);
+      }
+
+      stride = stage_size;
+      clear();
+    }
+
+    void clear() noexcept {
+      if (++generation == 0) {
+        /* wraparound: the old stamps may look current */
+        std::fill(generations.begin(), generations.end(), 0);
+        generation = 1;
+      }
+    }
+
+    iterator end() noexcept {
+      return nullptr;
+    }
+
+    const_iterator end() const noexcept {
+      return nullptr;
+    }
+
+    [[gnu::pure]]
+    iterator find(ScanTaskPoint p) noexcept {
+      const std::size_t i = GetSlot(p);
+      return i < slots.size() && generations[i] == generation
+        ? &slots[i]
+        : nullptr;
+    }
+
+    [[gnu::pure]]
+    const_iterator find(ScanTaskPoint p) const noexcept {
+      const std::size_t i = GetSlot(p);
+      return i < slots.size() && generations[i] == generation
+        ? &slots[i]
+        : nullptr;
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(ScanTaskPoint p,
+                                          Args&&... args) noexcept {
+      const std::size_t i = GetSlot(p);
+      assert(i < slots.size());
+
+      value_type &slot = slots[i];
+      if (generations[i] == generation)
+        return {&slot, false};
+
+      generations[i] = generation;
+      slot.first = p;
+      slot.second = Value(std::forward<Args>(args)...);
+      return {&slot, true};
+    }
+
+  private:
+    [[gnu::pure]]
+    std::size_t GetSlot(ScanTaskPoint p) const noexcept {
+      assert(p.GetPointIndex() < stride);
+
+      return std::size_t(p.GetStageNumber()) * stride + p.GetPointIndex();
+    }
+  };
+};
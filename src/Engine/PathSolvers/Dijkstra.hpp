@@ -24,6 +24,8 @@ public:
 
     value_type value;
 
+    Edge() noexcept = default;
+
     constexpr Edge(Node _parent, value_type _value) noexcept
       :parent(_parent), value(_value) {}
   };
@@ -74,11 +76,13 @@ public:
   Dijkstra() noexcept {
     /* this is a kludge to prevent rehashing, because rehashing would
        invalidate all iterators stored inside the priority queue
-       "q", and would thus lead to use-after-free crashes */
-    // TODO this hard-codes the use of std::unordered_map
-    // TODO come up with a better solution
-    edges.reserve(4093);
-    edges.max_load_factor(1e10);
+       "q", and would thus lead to use-after-free crashes; edge maps
+       which never move their items (e.g. DenseDijkstraMap) don't
+       need it */
+    if constexpr (requires(EdgeMap &m) { m.max_load_factor(1e10); }) {
+      edges.reserve(4093);
+      edges.max_load_factor(1e10);
+    }
   }
 
   Dijkstra(const Dijkstra &) = delete;
@@ -106,6 +110,10 @@ public:
     return edges;
   }
 
+  EdgeMap &GetEdgeMap() noexcept {
+    return edges;
+  }
+
   /**
    * Test whether queue is empty
    *
@@ -10,6 +10,30 @@
 #include <unordered_map>
 #include <cassert>
 
+/**
+ * The default edge map for #NavDijkstra: a hash map which can hold
+ * any #ScanTaskPoint.
+ */
+struct NavDijkstraHashMap {
+  struct Hash {
+    constexpr std::size_t operator()(ScanTaskPoint p) const noexcept {
+      return p.Key();
+    }
+  };
+
+  struct Equal {
+    constexpr bool operator()(ScanTaskPoint a,
+                              ScanTaskPoint b) const noexcept {
+      return a.Key() == b.Key();
+    }
+  };
+
+  template<typename Value>
+  struct Bind : public std::unordered_map<ScanTaskPoint, Value,
+                                          Hash, Equal> {
+  };
+};
+
 /**
  * Abstract class for A* /Dijkstra searches of nav points, managing
  * edges in multiple stages (corresponding to turn points).
@@ -17,33 +41,16 @@
  * Expected running time, see http://www.avglab.com/andrew/pub/neci-tr-96-062.ps
  *
  * NavDijkstra<SearchPoint>
+ *
+ * @param MapTemplate the edge map type, see #NavDijkstraHashMap
  */
-template<typename ValueType=unsigned>
+template<typename ValueType=unsigned,
+         typename MapTemplate=NavDijkstraHashMap>
 class NavDijkstra {
 protected:
   static constexpr unsigned MAX_STAGES = 32;
 
-  struct DijkstraMap {
-    struct Hash {
-      constexpr std::size_t operator()(ScanTaskPoint p) const noexcept {
-        return p.Key();
-      }
-    };
-
-    struct Equal {
-      constexpr bool operator()(ScanTaskPoint a,
-                                ScanTaskPoint b) const noexcept {
-        return a.Key() == b.Key();
-      }
-    };
-
-    template<typename Value>
-    struct Bind : public std::unordered_map<ScanTaskPoint, Value,
-                                            Hash, Equal> {
-    };
-  };
-
-  using Dijkstra = ::Dijkstra<ScanTaskPoint, DijkstraMap, ValueType>;
+  using Dijkstra = ::Dijkstra<ScanTaskPoint, MapTemplate, ValueType>;
   using value_type = typename Dijkstra::value_type;
 
   Dijkstra dijkstra;
@@ -15,6 +15,8 @@ class ScanTaskPoint {
   uint32_t value;
 
 public:
+  ScanTaskPoint() noexcept = default;
+
   constexpr
   ScanTaskPoint(unsigned stage_number, unsigned point_index) noexcept
     :value((stage_number << 16) | point_index) {}
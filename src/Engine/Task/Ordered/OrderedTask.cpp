@@ -197,7 +197,8 @@ OrderedTask::ScanLegStartTime() noexcept
 // DISTANCES
 
 inline bool
-OrderedTask::RunDijsktraMin(const GeoPoint &location) noexcept
+OrderedTask::RunDijsktraMin(const GeoPoint &location,
+                            bool incremental) noexcept
 {
   const unsigned task_size = TaskSize();
   if (task_size < 2)
@@ -208,15 +209,28 @@ OrderedTask::RunDijsktraMin(const GeoPoint &location) noexcept
   TaskDijkstraMin &dijkstra = *dijkstra_min;
 
   const unsigned active_index = GetActiveIndex();
-  dijkstra.SetTaskSize(task_size - active_index);
-  for (unsigned i = active_index; i != task_size; ++i) {
-    const SearchPointVector &boundary = task_points[i]->GetSearchPoints();
-    dijkstra.SetBoundary(i - active_index, boundary);
-  }
-
   SearchPoint ac(location, task_projection);
-  if (!dijkstra.DistanceMin(ac))
-    return false;
+
+  if (incremental && ac.IsValid()) {
+    /* the following task points are unchanged; only the active one
+       may have new samples (which doesn't force a full update) */
+    const SearchPointVector &boundary =
+      task_points[active_index]->GetSearchPoints();
+    if (!dijkstra.DistanceMinIncremental(boundary, ac))
+      incremental = false;
+  } else
+    incremental = false;
+
+  if (!incremental) {
+    dijkstra.SetTaskSize(task_size - active_index);
+    for (unsigned i = active_index; i != task_size; ++i) {
+      const SearchPointVector &boundary = task_points[i]->GetSearchPoints();
+      dijkstra.SetBoundary(i - active_index, boundary);
+    }
+
+    if (!dijkstra.DistanceMin(ac))
+      return false;
+  }
 
   for (unsigned i = active_index; i != task_size; ++i)
     SetPointSearchMin(i, dijkstra.GetSolution(i - active_index));
@@ -227,6 +241,7 @@ OrderedTask::RunDijsktraMin(const GeoPoint &location) noexcept
 inline double
 OrderedTask::ScanDistanceMin(const GeoPoint &location, bool full) noexcept
 {
+  bool moved = false;
   if (!full && location.IsValid() && last_min_location.IsValid() &&
       DistanceIsSignificant(location, last_min_location)) {
     const TaskWaypoint *active = GetActiveTaskPoint();
@@ -243,12 +258,14 @@ OrderedTask::ScanDistanceMin(const GeoPoint &location, bool full) noexcept
       if (last_distance < 2000 || cur_distance < 2000 ||
           last_distance * 20 >= cur_distance * 21 ||
           cur_distance * 20 >= last_distance * 21)
-        full = true;
+        moved = true;
     }
   }
 
-  if (full) {
-    RunDijsktraMin(location);
+  if (full || moved) {
+    /* if only the aircraft has moved, the remaining distances from
+       the following task points are still valid */
+    RunDijsktraMin(location, !full);
     last_min_location = location;
   }
 
@@ -603,7 +620,15 @@ OrderedTask::UpdateIdle(const AircraftState &state,
       TaskOptTarget tot(tps, active_task_point, state,
                         task_behaviour.glide, glide_polar,
                         *ap, task_projection, *taskpoint_start);
-      tot.search(0.5);
+      tot.SetCache(glide_cache);
+
+      if (opt_target_point != active_task_point) {
+        opt_target_point = active_task_point;
+        opt_target_isoline = 0.5;
+      }
+
+      const auto t = tot.search(opt_target_isoline);
+      opt_target_isoline = t >= 0 ? t : 0.5;
     }
     retval = true;
   }
@@ -1040,8 +1065,9 @@ OrderedTask::CalcMinTarget(const AircraftState &aircraft,
     TaskMinTarget bmt(tps, active_task_point, aircraft,
                       task_behaviour.glide, glide_polar,
                       t_rem, *taskpoint_start);
-    auto p = bmt.search(0);
-    return p;
+    bmt.SetCache(glide_cache);
+    min_target_range = bmt.search(min_target_range);
+    return min_target_range;
   }
 
   return 0;
@@ -6,6 +6,7 @@
 #include "Geo/Flat/TaskProjection.hpp"
 #include "Task/AbstractTask.hpp"
 #include "SmartTaskAdvance.hpp"
+#include "GlideSolvers/GlideResultCache.hpp"
 #include "Waypoint/Ptr.hpp"
 #include "util/DereferenceIterator.hxx"
 #include "util/StaticString.hxx"
@@ -72,6 +73,23 @@ private:
   std::unique_ptr<TaskDijkstraMin> dijkstra_min;
   std::unique_ptr<TaskDijkstraMax> dijkstra_max;
 
+  /**
+   * Leg solutions shared by the target optimisers between
+   * calculation cycles.
+   */
+  GlideResultCache glide_cache;
+
+  /**
+   * The solutions of the previous CalcMinTarget() and TaskOptTarget
+   * searches; they are the initial guesses for the next cycle.
+   */
+  double min_target_range = 0, opt_target_isoline = 0.5;
+
+  /**
+   * The task point #opt_target_isoline belongs to.
+   */
+  unsigned opt_target_point = 0;
+
   StaticString<64> name;
 
 public:
@@ -416,9 +434,14 @@ public:
 private:
 
   /**
+   * @param incremental true if only the aircraft location (and the
+   * samples of the active task point) have changed since the last
+   * call, which allows reusing the previous search through the
+   * following task points
    * @return true if a solution was found (and applied)
    */
-  bool RunDijsktraMin(const GeoPoint &location) noexcept;
+  bool RunDijsktraMin(const GeoPoint &location,
+                      bool incremental=false) noexcept;
 
   double ScanDistanceMin(const GeoPoint &ref, bool full) noexcept;
 
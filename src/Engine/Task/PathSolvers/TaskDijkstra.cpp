@@ -4,13 +4,15 @@
 #include "TaskDijkstra.hpp"
 #include "Geo/SearchPointVector.hpp"
 
+#include <algorithm>
+
 TaskDijkstra::TaskDijkstra(bool _is_min) noexcept
   :NavDijkstra(0),
    is_min(_is_min)
 {
 }
 
-inline unsigned
+unsigned
 TaskDijkstra::GetStageSize(const unsigned stage) const noexcept
 {
   assert(stage < num_stages);
@@ -69,6 +71,18 @@ TaskDijkstra::AddStartEdges(unsigned stage,
     LinkStart(destination, CalcDistance(destination, currentLocation));
 }
 
+void
+TaskDijkstra::Prepare() noexcept
+{
+  unsigned max_stage_size = 0;
+  for (unsigned stage = 0; stage < num_stages; ++stage)
+    max_stage_size = std::max(max_stage_size, GetStageSize(stage));
+
+  dijkstra.Clear();
+  dijkstra.GetEdgeMap().Resize(num_stages, max_stage_size);
+  dijkstra.Reserve(256);
+}
+
 bool
 TaskDijkstra::Run() noexcept
 {
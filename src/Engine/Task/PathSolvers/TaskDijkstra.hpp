@@ -4,6 +4,7 @@
 #pragma once
 
 #include "PathSolvers/NavDijkstra.hpp"
+#include "PathSolvers/DenseDijkstraMap.hpp"
 #include "Geo/SearchPoint.hpp"
 
 #include <cassert>
@@ -29,9 +30,10 @@ class SearchPointVector;
  * Before each calculation, set up this object with SetTaskSize() and
  * call SetBoundary() for each task point.
  *
- * This uses a Dijkstra search and so is O(N log(N)).
+ * This uses a Dijkstra search and so is O(N log(N)).  The edges are
+ * stored in a #DenseDijkstraMap, which is kept across searches.
  */
-class TaskDijkstra : protected NavDijkstra<>
+class TaskDijkstra : protected NavDijkstra<unsigned, DenseDijkstraMap>
 {
   const SearchPointVector *boundaries[MAX_STAGES];
 
@@ -69,6 +71,12 @@ protected:
   [[gnu::pure]]
   const SearchPoint &GetPoint(ScanTaskPoint sp) const noexcept;
 
+  /**
+   * Clear the edge map and size it for the current boundaries.  Call
+   * this before adding the start edges.
+   */
+  void Prepare() noexcept;
+
   bool Run() noexcept;
 
   bool Link(const ScanTaskPoint node, const ScanTaskPoint parent,
@@ -124,11 +132,9 @@ protected:
     return CalcDistance(s1, GetPoint(s2));
   }
 
-private:
   [[gnu::pure]]
   unsigned GetStageSize(const unsigned stage) const noexcept;
 
-protected:
   /* methods from NavDijkstra */
   virtual void AddEdges(ScanTaskPoint curNode) noexcept final;
 };
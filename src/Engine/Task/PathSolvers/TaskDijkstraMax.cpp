@@ -6,8 +6,7 @@
 bool
 TaskDijkstraMax::DistanceMax() noexcept
 {
-  dijkstra.Clear();
-  dijkstra.Reserve(256);
+  Prepare();
   AddZeroStartEdges();
   return Run();
 }
@@ -3,11 +3,14 @@
 
 #include "TaskDijkstraMin.hpp"
 
+#include <limits>
+
 bool
 TaskDijkstraMin::DistanceMin(const SearchPoint &currentLocation) noexcept
 {
-  dijkstra.Clear();
-  dijkstra.Reserve(256);
+  remaining_valid = false;
+
+  Prepare();
 
   if (currentLocation.IsValid()) {
     AddStartEdges(0, currentLocation);
@@ -15,6 +18,105 @@ TaskDijkstraMin::DistanceMin(const SearchPoint &currentLocation) noexcept
     AddZeroStartEdges();
   }
 
-  return Run();
+  if (!Run())
+    return false;
+
+  remaining_valid = true;
+  remaining.clear();
+  return true;
+}
+
+void
+TaskDijkstraMin::CalcRemaining() noexcept
+{
+  assert(num_stages > 0);
+
+  unsigned size = 0;
+  for (unsigned stage = 1; stage < num_stages; ++stage) {
+    stage_offset[stage] = size;
+    size += GetStageSize(stage);
+  }
+
+  remaining.resize(size);
+
+  const unsigned last = num_stages - 1;
+  for (unsigned i = 0, n = GetStageSize(last); i < n; ++i)
+    remaining[stage_offset[last] + i] = {0, 0};
+
+  /* dynamic programming from the finish backwards: each stage only
+     needs the one after it */
+  for (unsigned stage = last - 1; stage >= 1; --stage) {
+    const unsigned next_size = GetStageSize(stage + 1);
+    const Remaining *next = remaining.data() + stage_offset[stage + 1];
+
+    for (unsigned i = 0, n = GetStageSize(stage); i < n; ++i) {
+      const ScanTaskPoint p(stage, i);
+
+      Remaining best{std::numeric_limits<value_type>::max(), 0};
+      for (unsigned j = 0; j < next_size; ++j) {
+        const value_type d = CalcDistance(p, ScanTaskPoint(stage + 1, j)) +
+          next[j].distance;
+        if (d < best.distance)
+          best = {d, j};
+      }
+
+      remaining[stage_offset[stage] + i] = best;
+    }
+  }
 }
 
+bool
+TaskDijkstraMin::DistanceMinIncremental(const SearchPointVector &first_boundary,
+                                        const SearchPoint &location) noexcept
+{
+  assert(location.IsValid());
+
+  if (!remaining_valid || num_stages == 0)
+    return false;
+
+  SetBoundary(0, first_boundary);
+
+  if (remaining.empty() && num_stages > 1)
+    CalcRemaining();
+
+  const unsigned size = GetStageSize(0);
+  if (size == 0)
+    return false;
+
+  value_type best_distance = std::numeric_limits<value_type>::max();
+  unsigned best_next = 0;
+
+  for (unsigned i = 0; i < size; ++i) {
+    const ScanTaskPoint p(0, i);
+
+    value_type d = CalcDistance(p, location);
+    unsigned next = 0;
+
+    if (num_stages > 1) {
+      value_type to_go = std::numeric_limits<value_type>::max();
+      for (unsigned j = 0, n = GetStageSize(1); j < n; ++j) {
+        const value_type to = CalcDistance(p, ScanTaskPoint(1, j)) +
+          remaining[stage_offset[1] + j].distance;
+        if (to < to_go) {
+          to_go = to;
+          next = j;
+        }
+      }
+
+      d += to_go;
+    }
+
+    if (d < best_distance) {
+      best_distance = d;
+      solution[0] = i;
+      best_next = next;
+    }
+  }
+
+  for (unsigned stage = 1; stage < num_stages; ++stage) {
+    solution[stage] = best_next;
+    best_next = remaining[stage_offset[stage] + best_next].next;
+  }
+
+  return true;
+}
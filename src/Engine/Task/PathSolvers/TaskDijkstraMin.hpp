@@ -5,10 +5,39 @@
 
 #include "TaskDijkstra.hpp"
 
+#include <vector>
+
 /**
  * Specialisation of TaskDijkstra for minimum distance search
  */
 class TaskDijkstraMin final : public TaskDijkstra {
+  struct Remaining {
+    /**
+     * The minimum distance from this point to the finish.
+     */
+    value_type distance;
+
+    /**
+     * The index of the next point on that path.
+     */
+    unsigned next;
+  };
+
+  /**
+   * The minimum remaining distance of each point of the stages after
+   * the first one, which do not depend on the aircraft location.
+   * Filled by DistanceMinIncremental() on demand, and invalidated by
+   * DistanceMin().
+   */
+  std::vector<Remaining> remaining;
+
+  /**
+   * The index of each stage's first point in #remaining.
+   */
+  unsigned stage_offset[MAX_STAGES];
+
+  bool remaining_valid = false;
+
 public:
   TaskDijkstraMin() noexcept
     :TaskDijkstra(true) {}
@@ -27,4 +56,23 @@ public:
    * @return True if succeeded
    */
   bool DistanceMin(const SearchPoint &location) noexcept;
+
+  /**
+   * Like DistanceMin(), but reuse the remaining distances of all
+   * stages after the first one from the previous calculation; only
+   * the first stage (the active task point) is searched again.  This
+   * may be used instead of DistanceMin() if only the aircraft
+   * location and the first boundary have changed since the last
+   * DistanceMin() call.
+   *
+   * @param first_boundary the new boundary of the first stage
+   * @param location Location of aircraft (must be valid)
+   * @return True if succeeded, false if there is no previous
+   * calculation to reuse
+   */
+  bool DistanceMinIncremental(const SearchPointVector &first_boundary,
+                              const SearchPoint &location) noexcept;
+
+private:
+  void CalcRemaining() noexcept;
 };
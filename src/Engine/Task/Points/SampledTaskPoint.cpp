@@ -29,19 +29,19 @@ SampledTaskPoint::AddInsideSample(const AircraftState& state,
     // return false (no update required)
     return false;
 
-  // add sample to polygon
+  // add sample to polygon and re-compute convex hull
   SearchPoint sp(state.location, projection);
-  sampled_points.push_back(sp);
+  bool retval = sampled_hull.Add(sampled_points, sp);
 
-  // re-compute convex hull
-  bool retval = sampled_points.PruneInterior();
+  /* thin to size is used here to ensure the sampled points vector
+     size is bounded to reasonable values for AAT calculations */
+  const bool thinned = sampled_points.ThinToSize(64);
+  if (thinned)
+    sampled_hull.Assign(sampled_points);
 
   // only return true if hull changed
   // return true; (update required)
-  return sampled_points.ThinToSize(64) || retval;
-
-  /* thin to size is used here to ensure the sampled points vector
-     size is bounded to reasonable values for AAT calculations */
+  return thinned || retval;
 }
 
 void
@@ -52,6 +52,7 @@ SampledTaskPoint::ClearSampleAllButLast(const AircraftState& ref_last,
     sampled_points.clear();
     SearchPoint sp(ref_last.location, projection);
     sampled_points.push_back(sp);
+    sampled_hull.Invalidate();
   }
 }
 
@@ -78,6 +79,7 @@ SampledTaskPoint::UpdateProjection(const FlatProjection &projection) noexcept
   search_max.Project(projection);
   search_min.Project(projection);
   nominal_points.Project(projection);
+  sampled_hull.Project(projection);
   sampled_points.Project(projection);
   boundary_points.Project(projection);
 }
@@ -86,6 +88,7 @@ void
 SampledTaskPoint::Reset() noexcept
 {
   sampled_points.clear();
+  sampled_hull.Invalidate();
 }
 
 const SearchPointVector &
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Geo/SearchPointVector.hpp"
+#include "Geo/ConvexHull/IncrementalConvexHull.hpp"
 
 class FlatProjection;
 class OZBoundary;
@@ -35,6 +36,13 @@ class SampledTaskPoint {
   bool past;
 
   SearchPointVector nominal_points;
+
+  /**
+   * Caches the Graham scan partitions of #sampled_points, so
+   * AddInsideSample() does not need to sort them for each sample.
+   */
+  IncrementalConvexHull sampled_hull;
+
   SearchPointVector sampled_points;
   SearchPointVector boundary_points;
   SearchPoint search_max;
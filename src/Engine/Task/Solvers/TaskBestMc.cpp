@@ -41,7 +41,7 @@ TaskBestMc::search(const double mc)
   // only search if mc zero is valid
   f(0);
   if (valid(0)) {
-    auto a = find_zero(mc);
+    auto a = find_zero_near(mc, WARM_START_STEP);
     if (valid(a))
       return a;
   }
@@ -54,7 +54,7 @@ TaskBestMc::search(const double mc, double &result)
   // only search if mc zero is valid
   f(0);
   if (valid(0)) {
-    auto a = find_zero(mc);
+    auto a = find_zero_near(mc, WARM_START_STEP);
     if (valid(a)) {
       result = a;
       return true;
@@ -17,6 +17,12 @@ class TaskBestMc final : ZeroFinder
 {
   static constexpr double TOLERANCE = 0.0001;
 
+  /**
+   * The initial half width of the search bracket around the
+   * MacCready value passed to search() [m/s].
+   */
+  static constexpr double WARM_START_STEP = 0.01;
+
   TaskMacCreadyRemaining tm;
   GlideResult res;
   const AircraftState &aircraft;
@@ -56,7 +62,9 @@ public:
 
   /**
    * Search for best MC.  If fails (MC=0 is below final glide), returns
-   * default value.
+   * default value.  The search starts in the neighbourhood of the
+   * default value, which is usually the result of the previous
+   * calculation.
    *
    * @param mc Default MacCready value (m/s)
    *
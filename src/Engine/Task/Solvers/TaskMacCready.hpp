@@ -12,6 +12,7 @@
 
 struct AircraftState;
 struct GlideSettings;
+class GlideResultCache;
 class TaskPoint;
 class OrderedTaskPoint;
 
@@ -61,6 +62,11 @@ protected:
    */
   GlidePolar glide_polar;
 
+  /**
+   * An optional cache for leg solutions, see SetCache().
+   */
+  GlideResultCache *cache = nullptr;
+
 public:
   /**
    * Constructor for ordered task points
@@ -94,6 +100,15 @@ public:
      settings(_settings),
      glide_polar(gp) {}
 
+  /**
+   * Use the given cache for the leg solutions.  It may be shared
+   * between solver instances (and calculation cycles) as long as they
+   * don't run concurrently.
+   */
+  void SetCache(GlideResultCache &_cache) noexcept {
+    cache = &_cache;
+  }
+
   /**
    * Calculate glide solution
    *
@@ -170,7 +185,6 @@ private:
    *
    * @return Glide result for segment
    */
-  [[gnu::pure]]
   virtual GlideResult SolvePoint(const TaskPoint &tp,
                                  const AircraftState &state,
                                  double minH) const = 0;
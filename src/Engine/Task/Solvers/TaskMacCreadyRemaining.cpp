@@ -4,6 +4,7 @@
 #include "TaskMacCreadyRemaining.hpp"
 #include "GlideSolvers/GlideState.hpp"
 #include "GlideSolvers/MacCready.hpp"
+#include "GlideSolvers/GlideResultCache.hpp"
 #include "Task/Points/TaskPoint.hpp"
 #include "Task/Ordered/Points/AATPoint.hpp"
 
@@ -20,7 +21,9 @@ TaskMacCreadyRemaining::SolvePoint(const TaskPoint &tp,
     /* ignore the travel to the start point */
     gs.vector.distance = 0;
 
-  return MacCready::Solve(settings, glide_polar, gs);
+  return cache != nullptr
+    ? cache->Solve(settings, glide_polar, gs)
+    : MacCready::Solve(settings, glide_polar, gs);
 }
 
 
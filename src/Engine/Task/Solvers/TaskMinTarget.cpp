@@ -30,7 +30,7 @@ TaskMinTarget::search(const double tp) noexcept
 
   force_current = false;
   /// @todo if search fails, force current
-  const auto p = find_zero(tp);
+  const auto p = find_zero_near(tp, WARM_START_STEP);
   if (valid(p)) {
     return p;
   } else {
@@ -22,6 +22,12 @@ class StartPoint;
 class TaskMinTarget final : private ZeroFinder {
   static constexpr double TOLERANCE = 0.002;
 
+  /**
+   * The initial half width of the search bracket around the range
+   * parameter passed to search().
+   */
+  static constexpr double WARM_START_STEP = 2 * TOLERANCE;
+
   TaskMacCreadyRemaining tm;
   GlideResult res;
   const AircraftState &aircraft;
@@ -71,13 +77,22 @@ private:
   bool valid(double p) const noexcept;
 
 public:
+  /**
+   * Use the given cache for the leg solutions, see
+   * TaskMacCready::SetCache().
+   */
+  void SetCache(GlideResultCache &cache) noexcept {
+    tm.SetCache(cache);
+  }
+
   /**
    * Search for target range to produce remaining time equal to
    * value specified in constructor.
    *
    * Running this adjusts the target values for AAT task points.
    *
-   * @param p Default range (0-1)
+   * @param p Default range (0-1); this should be the solution of the
+   * previous calculation, the search starts in its neighbourhood
    *
    * @return Range value for solution
    */
@@ -64,6 +64,14 @@ public:
   {
   }
 
+  /**
+   * Use the given cache for the leg solutions, see
+   * TaskMacCready::SetCache().
+   */
+  void SetCache(GlideResultCache &cache) noexcept {
+    tm.SetCache(cache);
+  }
+
   double f(double p) noexcept override;
 
   /**
@@ -81,7 +89,8 @@ public:
    *
    * Running this adjusts the target values for the active task point.
    *
-   * @param p Default isoline value (0-1)
+   * @param p Default isoline value (0-1); if the solution of the
+   * previous calculation is passed, the search may finish early
    *
    * @return Isoline value for solution
    */
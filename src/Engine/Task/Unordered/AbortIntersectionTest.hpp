@@ -3,10 +3,26 @@
 
 #pragma once
 
-struct AGeoPoint;
+#include "Geo/GeoPoint.hpp"
+
+#include <cassert>
+#include <span>
 
 class AbortIntersectionTest {
 public:
   [[gnu::pure]]
   virtual bool Intersects(const AGeoPoint &destination) const noexcept = 0;
+
+  /**
+   * Test many destinations at once.  Implementations may override
+   * this to evaluate them in parallel; each result must be stored at
+   * the index of its destination.
+   */
+  virtual void Intersects(std::span<const AGeoPoint> destinations,
+                          std::span<bool> results) const noexcept {
+    assert(results.size() == destinations.size());
+
+    for (std::size_t i = 0; i < destinations.size(); ++i)
+      results[i] = Intersects(destinations[i]);
+  }
 };
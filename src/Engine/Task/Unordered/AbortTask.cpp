@@ -4,12 +4,16 @@
 #include "AbortTask.hpp"
 #include "AbortIntersectionTest.hpp"
 #include "AlternateList.hpp"
+#include "Geo/GeoPoint.hpp"
 #include "Navigation/Aircraft.hpp"
 #include "Task/Visitors/TaskPointVisitor.hpp"
-#include "Task/Solvers/TaskSolution.hpp"
+#include "GlideSolvers/GlideBatch.hpp"
 #include "GlideSolvers/GlidePolar.hpp"
+#include "GlideSolvers/MacCready.hpp"
 #include "Waypoint/Waypoints.hpp"
 
+#include <memory>
+
 /** min search range in m */
 static constexpr double min_search_range = 50000;
 
@@ -97,10 +101,61 @@ IsReachable(const GlideResult &result, bool final_glide) noexcept
     : result.IsAchievable();
 }
 
+void
+AbortTask::EvaluateCandidates(const AircraftState &state,
+                              CandidateList &candidates,
+                              const GlidePolar &polar) const noexcept
+{
+  GlideBatch batch(state.altitude, state.wind);
+  batch.reserve(candidates.size());
+
+  for (const auto &i : candidates) {
+    /* same as GlideState::Remaining() */
+    const UnorderedTaskPoint t(i.waypoint, task_behaviour);
+    batch.Add(t.GetVectorRemaining(state.location),
+              std::max(0., t.GetElevation()));
+  }
+
+  std::vector<GlideResult> results(batch.size());
+  MacCready::Solve(task_behaviour.glide, polar, batch, results);
+
+  for (std::size_t i = 0; i < results.size(); ++i)
+    candidates[i].solution = results[i];
+
+  if (intersection_test == nullptr)
+    return;
+
+  /* FillReachable() tests intersection only in the final glide
+     passes, so these are the only ones to be tested */
+  std::vector<AGeoPoint> destinations;
+  std::vector<std::size_t> indices;
+  destinations.reserve(candidates.size());
+  indices.reserve(candidates.size());
+
+  for (std::size_t i = 0; i < candidates.size(); ++i) {
+    const auto &c = candidates[i];
+    if (IsReachable(c.solution, true)) {
+      destinations.emplace_back(c.waypoint->location,
+                                c.solution.min_arrival_altitude);
+      indices.push_back(i);
+    }
+  }
+
+  if (destinations.empty())
+    return;
+
+  const auto intersects = std::make_unique<bool[]>(destinations.size());
+  intersection_test->Intersects(destinations,
+                                {intersects.get(), destinations.size()});
+
+  for (std::size_t i = 0; i < indices.size(); ++i)
+    candidates[indices[i]].intersects = intersects[i];
+}
+
 bool
 AbortTask::FillReachable(const AircraftState &state,
-                         AlternateList &approx_waypoints,
-                         const GlidePolar &polar, bool only_airfield,
+                         CandidateList &approx_waypoints,
+                         bool only_airfield,
                          bool final_glide, [[maybe_unused]] bool safety) noexcept
 {
   if (IsTaskFull() || approx_waypoints.empty())
@@ -118,18 +173,14 @@ AbortTask::FillReachable(const AircraftState &state,
       continue;
     }
 
-    UnorderedTaskPoint t(v->waypoint, task_behaviour);
-    GlideResult result =
-        TaskSolution::GlideSolutionRemaining(t, state,
-                                             task_behaviour.glide, polar);
+    const GlideResult &result = v->solution;
 
     if (IsReachable(result, final_glide)) {
       bool intersects = false;
       const bool is_reachable_final = IsReachable(result, true);
 
-      if (intersection_test && final_glide && is_reachable_final)
-        intersects = intersection_test->Intersects(
-            AGeoPoint(v->waypoint->location, result.min_arrival_altitude));
+      if (final_glide && is_reachable_final)
+        intersects = v->intersects;
 
       if (!intersects) {
         q.emplace_back(v->waypoint, result);
@@ -196,32 +247,35 @@ AbortTask::UpdateSample(const AircraftState &state,
     /* can't work without a polar */
     return false;
 
-  AlternateList approx_waypoints;
-  approx_waypoints.reserve(128);
+  CandidateList approx_waypoints;
+  approx_waypoints.reserve(max_candidates);
 
-  waypoints.VisitWithinRange(state.location,
-                             GetAbortRange(state, glide_polar), [&approx_waypoints](const auto &wp){
-                               if (wp->IsLandable())
-                                 approx_waypoints.emplace_back(wp);
-                             });
+  waypoints.VisitNearest(state.location, GetAbortRange(state, glide_polar),
+                         max_candidates,
+                         [](const Waypoint &wp){ return wp.IsLandable(); },
+                         [&approx_waypoints](const auto &wp){
+                           approx_waypoints.emplace_back(wp);
+                         });
   if (approx_waypoints.empty()) {
     /** @todo increase range */
     return false;
   }
 
+  EvaluateCandidates(state, approx_waypoints, glide_polar);
+
   // sort by arrival time
 
   // first try with final glide only
-  reachable_landable |=  FillReachable(state, approx_waypoints, glide_polar,
+  reachable_landable |=  FillReachable(state, approx_waypoints,
                                        true, true, true);
-  reachable_landable |=  FillReachable(state, approx_waypoints, glide_polar,
+  reachable_landable |=  FillReachable(state, approx_waypoints,
                                        false, true, true);
 
   // inform clients that the landable reachable scan has been performed 
   ClientUpdate(state, true);
 
   // now try without final glide constraint and not preferring airports
-  FillReachable(state, approx_waypoints, glide_polar, false, false, false);
+  FillReachable(state, approx_waypoints, false, false, false);
 
   // inform clients that the landable unreachable scan has been performed 
   ClientUpdate(state, false);
@@ -5,13 +5,13 @@
 
 #include "UnorderedTask.hpp"
 #include "UnorderedTaskPoint.hpp"
+#include "AlternatePoint.hpp"
 
 #include <vector>
 #include <cassert>
 
 class Waypoints;
 class AbortIntersectionTest;
-class AlternateList;
 
 /**
  * Abort task provides automatic management of a sorted list of task points
@@ -44,10 +44,35 @@ protected:
   using AlternateTaskVector = std::vector<AlternateTaskPoint>;
   AlternateTaskVector task_points;
 
+  /**
+   * A landable waypoint within range, with the results of
+   * EvaluateCandidates().
+   */
+  struct Candidate : AlternatePoint {
+    /**
+     * Does the final glide to this waypoint intersect with terrain?
+     * Only tested if it is reachable in final glide.
+     */
+    bool intersects = false;
+
+    using AlternatePoint::AlternatePoint;
+  };
+
+  using CandidateList = std::vector<Candidate>;
+
 private:
   /** max number of items in list */
   static constexpr AlternateTaskVector::size_type max_abort = 10;
 
+  /**
+   * The maximum number of landable waypoints (nearest first) which
+   * are evaluated.  The list is sorted by arrival time, which may
+   * differ from the distance order (wind, elevation, climb), therefore
+   * a generous multiple of #max_abort is evaluated.  This limits the
+   * work with large outlanding databases.
+   */
+  static constexpr unsigned max_candidates = 16 * max_abort;
+
   /** whether the AbortTask is the master or running in background */
   bool is_active;
 
@@ -135,14 +160,30 @@ protected:
   double GetAbortRange(const AircraftState &state_now,
                        const GlidePolar &glide_polar) const noexcept;
 
+  /**
+   * Calculate the glide solution of all candidate waypoints in one
+   * batch, and run the intersection test on all those which are
+   * reachable in final glide (which may be done in parallel by the
+   * #AbortIntersectionTest implementation).  The results are stored
+   * in the #Candidate at the same index, so they do not depend on
+   * the order of evaluation.
+   *
+   * @param state Aircraft state
+   * @param candidates List of candidate waypoints
+   * @param polar Polar used for tests
+   */
+  void EvaluateCandidates(const AircraftState &state,
+                          CandidateList &candidates,
+                          const GlidePolar &polar) const noexcept;
+
   /**
    * Fill abort task list with candidate waypoints given a list of
    * waypoints satisfying approximate range queries.  Can be used
    * to add airfields only, or landpoints.
    *
    * @param state Aircraft state
-   * @param approx_waypoints List of candidate waypoints
-   * @param polar Polar used for tests
+   * @param approx_waypoints List of candidate waypoints, evaluated by
+   * EvaluateCandidates()
    * @param only_airfield If true, only add waypoints that are airfields.
    * @param final_glide Whether solution must be glide only or climb allowed
    * @param safety Whether solution uses safety polar
@@ -150,8 +191,8 @@ protected:
    * @return True if a landpoint within final glide was found
    */
   bool FillReachable(const AircraftState &state,
-                     AlternateList &approx_waypoints,
-                     const GlidePolar &polar, bool only_airfield,
+                     CandidateList &approx_waypoints,
+                     bool only_airfield,
                      bool final_glide, bool safety) noexcept;
 
 protected:
@@ -222,20 +222,6 @@ Waypoints::LookupId(const unsigned id) const noexcept
   return nullptr;
 }
 
-void
-Waypoints::VisitWithinRange(const GeoPoint &loc, const double range,
-                            WaypointVisitor visitor) const
-{
-  if (IsEmpty())
-    return; // nothing to do
-
-  const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
-  const WaypointTree::Point point(flat_location.x, flat_location.y);
-  const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
-
-  waypoint_tree.VisitWithinRange(point, mrange, visitor);
-}
-
 void
 Waypoints::VisitNamePrefix(tstring_view prefix,
                            WaypointVisitor visitor) const
@@ -12,6 +12,7 @@
 #include "util/tstring_view.hxx"
 
 #include <functional>
+#include <vector>
 
 using WaypointVisitor = std::function<void(const WaypointPtr &)>;
 
@@ -275,8 +276,51 @@ public:
    * @param range Distance in meters of search radius
    * @param visitor Visitor to be called on waypoints within range
    */
+  template<typename V>
   void VisitWithinRange(const GeoPoint &loc, double range,
-                        WaypointVisitor visitor) const;
+                        V &&visitor) const {
+    if (IsEmpty())
+      return; // nothing to do
+
+    const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
+    const WaypointTree::Point point(flat_location.x, flat_location.y);
+    const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+
+    waypoint_tree.VisitWithinRange(point, mrange, visitor);
+  }
+
+  /**
+   * Call visitor function on the (up to) @a n waypoints nearest to
+   * the search location within the given range which match the
+   * predicate, nearest first.  This is cheaper than
+   * VisitWithinRange() followed by sorting when there are many
+   * waypoints within range.  Performs search according to
+   * flat-earth internal representation, so is approximate.
+   *
+   * @param predicate called with a `const Waypoint &`
+   * @param visitor called with a `const WaypointPtr &`
+   */
+  template<typename P, typename V>
+  void VisitNearest(const GeoPoint &loc, double range, unsigned n,
+                    const P &predicate, V &&visitor) const {
+    if (IsEmpty() || n == 0)
+      return;
+
+    const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
+    const WaypointTree::Point point(flat_location.x, flat_location.y);
+    const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+
+    std::vector<WaypointTree::NearestItem> buffer(n);
+    const auto n_found =
+      waypoint_tree.FindNearestN(point, mrange,
+                                 [&predicate](const WaypointPtr &ptr){
+                                   return predicate(*ptr);
+                                 },
+                                 buffer.data(), n);
+
+    for (std::size_t i = 0; i < n_found; ++i)
+      visitor(*buffer[i].value);
+  }
 
   /**
    * Call visitor function on waypoints with the specified name
@@ -2,46 +2,237 @@
 // Copyright The XCSoar Project
 
 #include "FlarmNetDatabase.hpp"
+#include "io/FileCache.hpp"
+#include "io/FileMapping.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "util/SpanCast.hxx"
 #include "util/StringAPI.hxx"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+
+static const TCHAR *const flarmnet_cache_name = _T("flarmnet");
+
+/**
+ * The header of the cache file.  It is followed by the arrays
+ * #FlarmNetDatabase::ids, #FlarmNetDatabase::by_callsign and
+ * #FlarmNetDatabase::records.
+ */
+struct FlarmNetCacheHeader {
+  static constexpr uint32_t MAGIC = 0x464e4331;
+
+  uint32_t magic;
+
+  /**
+   * Catches caches written by a build with a different record
+   * layout (e.g. _UNICODE).
+   */
+  uint32_t record_size;
+
+  uint32_t n_records;
+
+  uint32_t reserved;
+};
+
+/* the arrays are mapped directly from the cache file, which is only
+   guaranteed to be 4-byte aligned */
+static_assert(std::is_trivially_copyable_v<FlarmNetRecord>);
+static_assert(std::is_trivially_copyable_v<FlarmId>);
+static_assert(sizeof(FlarmId) == sizeof(uint32_t));
+static_assert(alignof(FlarmNetRecord) <= alignof(uint32_t));
+
+FlarmNetDatabase::FlarmNetDatabase() noexcept = default;
+FlarmNetDatabase::~FlarmNetDatabase() noexcept = default;
+
+void
+FlarmNetDatabase::Clear() noexcept
+{
+  ids = {};
+  records = {};
+  by_callsign = {};
+
+  mapping.reset();
+  record_buffer.clear();
+  id_buffer.clear();
+  callsign_buffer.clear();
+}
 
 void
 FlarmNetDatabase::Insert(const FlarmNetRecord &record) noexcept
 {
-  FlarmId id = record.GetId();
-  if (!id.IsDefined())
+  /* records loaded from the cache are read-only; the caller is
+     expected to Clear() before loading a new file */
+  assert(mapping == nullptr);
+
+  if (!record.GetId().IsDefined())
     /* ignore malformed records */
     return;
 
-  map.insert(std::make_pair(id, record));
+  record_buffer.push_back(record);
 }
 
-const FlarmNetRecord *
-FlarmNetDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const noexcept
+void
+FlarmNetDatabase::Commit() noexcept
 {
-  for (const auto &[id, record] : map) {
-    assert(id.IsDefined());
+  assert(mapping == nullptr);
+
+  id_buffer.clear();
+  id_buffer.reserve(record_buffer.size());
+  for (const auto &record : record_buffer)
+    id_buffer.push_back(record.GetId());
+
+  /* sort by id (stable, so the first of several duplicates
+     survives), then drop the duplicates */
+  std::vector<uint32_t> order(record_buffer.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b){
+    return id_buffer[a] < id_buffer[b];
+  });
+  order.erase(std::unique(order.begin(), order.end(), [this](uint32_t a, uint32_t b){
+    return id_buffer[a] == id_buffer[b];
+  }), order.end());
 
-    if (StringIsEqual(record.callsign, cn))
-      return &record;
+  std::vector<FlarmNetRecord> sorted_records;
+  std::vector<FlarmId> sorted_ids;
+  sorted_records.reserve(order.size());
+  sorted_ids.reserve(order.size());
+  for (const uint32_t i : order) {
+    sorted_records.push_back(record_buffer[i]);
+    sorted_ids.push_back(id_buffer[i]);
   }
 
-  return NULL;
+  record_buffer = std::move(sorted_records);
+  id_buffer = std::move(sorted_ids);
+
+  callsign_buffer.resize(record_buffer.size());
+  std::iota(callsign_buffer.begin(), callsign_buffer.end(), 0);
+  std::stable_sort(callsign_buffer.begin(), callsign_buffer.end(),
+                   [this](uint32_t a, uint32_t b){
+                     return StringCompare(record_buffer[a].callsign,
+                                          record_buffer[b].callsign) < 0;
+                   });
+
+  ids = id_buffer;
+  records = record_buffer;
+  by_callsign = callsign_buffer;
+}
+
+bool
+FlarmNetDatabase::LoadCache(FileCache &cache, Path original_path) noexcept
+{
+  std::span<const std::byte> payload;
+  auto m = cache.Map(flarmnet_cache_name, original_path, payload);
+  if (!m)
+    return false;
+
+  if (payload.size() < sizeof(FlarmNetCacheHeader) ||
+      reinterpret_cast<std::uintptr_t>(payload.data()) % alignof(uint32_t) != 0)
+    return false;
+
+  FlarmNetCacheHeader header;
+  memcpy(&header, payload.data(), sizeof(header));
+  if (header.magic != FlarmNetCacheHeader::MAGIC ||
+      header.record_size != sizeof(FlarmNetRecord))
+    return false;
+
+  const std::size_t n = header.n_records;
+  payload = payload.subspan(sizeof(header));
+  if (payload.size() != n * (sizeof(FlarmId) + sizeof(uint32_t) +
+                             sizeof(FlarmNetRecord)))
+    return false;
+
+  Clear();
+
+  ids = FromBytesStrict<const FlarmId>(payload.first(n * sizeof(FlarmId)));
+  payload = payload.subspan(n * sizeof(FlarmId));
+  by_callsign = FromBytesStrict<const uint32_t>(payload.first(n * sizeof(uint32_t)));
+  payload = payload.subspan(n * sizeof(uint32_t));
+  records = FromBytesStrict<const FlarmNetRecord>(payload);
+
+  mapping = std::move(m);
+  return true;
+}
+
+void
+FlarmNetDatabase::SaveCache(FileCache &cache, Path original_path) const
+{
+  const FlarmNetCacheHeader header{
+    FlarmNetCacheHeader::MAGIC,
+    sizeof(FlarmNetRecord),
+    static_cast<uint32_t>(records.size()),
+    0,
+  };
+
+  auto os = cache.Save(flarmnet_cache_name, original_path);
+  BufferedOutputStream bos(*os);
+  bos.Write(ReferenceAsBytes(header));
+  bos.Write(std::as_bytes(ids));
+  bos.Write(std::as_bytes(by_callsign));
+  bos.Write(std::as_bytes(records));
+  bos.Flush();
+  os->Commit();
+}
+
+const FlarmNetRecord *
+FlarmNetDatabase::FindRecordById(FlarmId id) const noexcept
+{
+  const auto i = std::lower_bound(ids.begin(), ids.end(), id);
+  return i != ids.end() && *i == id
+    ? &records[std::distance(ids.begin(), i)]
+    : nullptr;
+}
+
+std::span<const uint32_t>
+FlarmNetDatabase::FindCallSignRange(const TCHAR *cn,
+                                    bool prefix) const noexcept
+{
+  const std::size_t length = StringLength(cn);
+
+  /* with a length limit, all callsigns starting with the prefix
+     compare equal */
+  const auto compare = [this, cn, length, prefix](uint32_t i) noexcept {
+    const TCHAR *callsign = records[i].callsign;
+    return prefix
+      ? StringCompare(callsign, cn, length)
+      : StringCompare(callsign, cn);
+  };
+
+  const auto begin = std::partition_point(by_callsign.begin(), by_callsign.end(),
+                                          [&compare](uint32_t i){
+                                            return compare(i) < 0;
+                                          });
+  const auto end = std::partition_point(begin, by_callsign.end(),
+                                        [&compare](uint32_t i){
+                                          return compare(i) == 0;
+                                        });
+  return {begin, end};
+}
+
+const FlarmNetRecord *
+FlarmNetDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const noexcept
+{
+  const auto range = FindCallSignRange(cn, false);
+  return range.empty()
+    ? nullptr
+    : &records[range.front()];
 }
 
 unsigned
 FlarmNetDatabase::FindRecordsByCallSign(const TCHAR *cn,
                                         const FlarmNetRecord *array[],
-                                        [[maybe_unused]] unsigned size) const noexcept
+                                        unsigned size) const noexcept
 {
   unsigned count = 0;
 
-  for (const auto &[id, record] : map) {
-    assert(id.IsDefined());
+  for (const uint32_t i : FindCallSignRange(cn, false)) {
+    if (count >= size)
+      break;
 
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = &record;
+    array[count++] = &records[i];
   }
 
   return count;
@@ -49,15 +240,32 @@ FlarmNetDatabase::FindRecordsByCallSign(const TCHAR *cn,
 
 unsigned
 FlarmNetDatabase::FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
-                                    [[maybe_unused]] unsigned size) const noexcept
+                                    unsigned size) const noexcept
+{
+  unsigned count = 0;
+
+  for (const uint32_t i : FindCallSignRange(cn, false)) {
+    if (count >= size)
+      break;
+
+    array[count++] = ids[i];
+  }
+
+  return count;
+}
+
+unsigned
+FlarmNetDatabase::FindRecordsByCallSignPrefix(const TCHAR *prefix,
+                                              const FlarmNetRecord *array[],
+                                              unsigned size) const noexcept
 {
   unsigned count = 0;
 
-  for (const auto &[id, record] : map) {
-    assert(id.IsDefined());
+  for (const uint32_t i : FindCallSignRange(prefix, true)) {
+    if (count >= size)
+      break;
 
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = id;
+    array[count++] = &records[i];
   }
 
   return count;
@@ -6,39 +6,107 @@
 #include "Id.hpp"
 #include "FlarmNetRecord.hpp"
 
-#include <map>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
 #include <tchar.h>
 
+class Path;
+class FileCache;
+class FileMapping;
+
 /**
  * An in-memory representation of the FlarmNet.org database.
+ *
+ * The records are kept in a sorted array, with a second array of
+ * indices sorted by callsign, so all lookups are binary searches.
+ * This layout can be written to the #FileCache as-is and mapped into
+ * memory on the next start, which avoids parsing the FlarmNet file
+ * again.
  */
 class FlarmNetDatabase {
-  typedef std::map<FlarmId, FlarmNetRecord> RecordMap;
-  RecordMap map;
+  /**
+   * The cache file the spans below point into; nullptr if the
+   * database was loaded from the FlarmNet file.
+   */
+  std::unique_ptr<FileMapping> mapping;
+
+  /**
+   * The storage of the spans below if the database was loaded from
+   * the FlarmNet file; #record_buffer collects unsorted records
+   * until Commit() is called.
+   */
+  std::vector<FlarmNetRecord> record_buffer;
+  std::vector<FlarmId> id_buffer;
+  std::vector<uint32_t> callsign_buffer;
+
+  /**
+   * The FLARM ids of all records, sorted.
+   */
+  std::span<const FlarmId> ids;
+
+  /**
+   * All records, in the same order as #ids.
+   */
+  std::span<const FlarmNetRecord> records;
+
+  /**
+   * Indices into #records, sorted by callsign.
+   */
+  std::span<const uint32_t> by_callsign;
 
 public:
+  FlarmNetDatabase() noexcept;
+  ~FlarmNetDatabase() noexcept;
+
+  FlarmNetDatabase(const FlarmNetDatabase &) = delete;
+  FlarmNetDatabase &operator=(const FlarmNetDatabase &) = delete;
+
   bool IsEmpty() const noexcept {
-    return map.empty();
+    return records.empty();
   }
 
-  void Clear() noexcept {
-    map.clear();
+  std::size_t size() const noexcept {
+    return records.size();
   }
 
+  void Clear() noexcept;
+
+  /**
+   * Add a record.  It will not be visible to the lookup methods
+   * until Commit() is called.
+   */
   void Insert(const FlarmNetRecord &record) noexcept;
 
+  /**
+   * Sort the records which were added with Insert() and build the
+   * indices.  If there are duplicate ids, the first record wins.
+   */
+  void Commit() noexcept;
+
+  /**
+   * Attempt to load the database from the cache file which was
+   * created from the given FlarmNet file.
+   *
+   * @return false if there is no valid cache file
+   */
+  bool LoadCache(FileCache &cache, Path original_path) noexcept;
+
+  /**
+   * Write the database to the cache.
+   *
+   * Throws on error.
+   */
+  void SaveCache(FileCache &cache, Path original_path) const;
+
   /**
    * Finds a FLARMNetRecord object based on the given FLARM id
    * @param id FLARM id
    * @return FLARMNetRecord object
    */
   [[gnu::pure]]
-  const FlarmNetRecord *FindRecordById(FlarmId id) const noexcept {
-    auto i = map.find(id);
-    return i != map.end()
-      ? &i->second
-      : NULL;
-  }
+  const FlarmNetRecord *FindRecordById(FlarmId id) const noexcept;
 
   /**
    * Finds a FLARMNetRecord object based on the given Callsign
@@ -54,13 +122,30 @@ public:
   unsigned FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
                              unsigned size) const noexcept;
 
+  /**
+   * Finds all records whose callsign starts with the given prefix,
+   * ordered by callsign.
+   */
+  unsigned FindRecordsByCallSignPrefix(const TCHAR *prefix,
+                                       const FlarmNetRecord *array[],
+                                       unsigned size) const noexcept;
+
   [[gnu::pure]]
   auto begin() const noexcept {
-    return map.begin();
+    return records.begin();
   }
 
   [[gnu::pure]]
   auto end() const noexcept {
-    return map.end();
+    return records.end();
   }
+
+private:
+  /**
+   * Returns the range of #by_callsign whose callsign equals @a cn
+   * (or starts with it if @a prefix is true).
+   */
+  [[gnu::pure]]
+  std::span<const uint32_t> FindCallSignRange(const TCHAR *cn,
+                                              bool prefix) const noexcept;
 };
@@ -119,6 +119,7 @@ FlarmNetReader::LoadFile(NLineReader &reader, FlarmNetDatabase &database)
     }
   }
 
+  database.Commit();
   return itemCount;
 }
 
@@ -11,6 +11,7 @@
 #include "MergeThread.hpp"
 #include "LocalPath.hpp"
 #include "io/DataFile.hpp"
+#include "io/FileCache.hpp"
 #include "io/Reader.hxx"
 #include "io/BufferedReader.hxx"
 #include "io/LineReader.hpp"
@@ -33,9 +34,23 @@ try {
     return;
   }
 
+  if (file_cache != nullptr && db.LoadCache(*file_cache, path)) {
+    LogFormat("%u FLARMnet ids loaded from cache", (unsigned)db.size());
+    return;
+  }
+
   unsigned num_records = FlarmNetReader::LoadFile(path, db);
-  if (num_records > 0)
+  if (num_records > 0) {
     LogFormat("%u FLARMnet ids found", num_records);
+
+    if (file_cache != nullptr) {
+      try {
+        db.SaveCache(*file_cache, path);
+      } catch (...) {
+        LogError(std::current_exception(), "Failed to save FLARMnet cache");
+      }
+    }
+  }
 } catch (...) {
   LogError(std::current_exception());
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <compare> // for the defaulted spaceship operator
 
@@ -39,6 +40,15 @@ public:
   friend constexpr auto operator<=>(const FlarmId &,
                                     const FlarmId &) noexcept = default;
 
+  /**
+   * Calculate a hash value for hash tables.
+   */
+  constexpr std::size_t Hash() const noexcept {
+    /* multiplicative (Fibonacci) hashing spreads ids which differ
+       only in a few bits */
+    return (value * 0x9e3779b1U) >> 16;
+  }
+
   static FlarmId Parse(const char *input, char **endptr_r) noexcept;
 #ifdef _UNICODE
   static FlarmId Parse(const TCHAR *input, TCHAR **endptr_r) noexcept;
@@ -7,14 +7,29 @@
 #include "NMEA/Validity.hpp"
 #include "util/TrivialArray.hxx"
 
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
 #include <type_traits>
 
 /**
- * This class keeps track of the traffic objects received from a
- * FLARM.
+ * A container for #FlarmTraffic objects with a hash index on the
+ * FLARM id.  This is the common implementation of #TrafficList and
+ * #TrafficStore.
  */
-struct TrafficList {
-  static constexpr size_t MAX_COUNT = 25;
+template<std::size_t N>
+struct BasicTrafficList {
+  static constexpr size_t MAX_COUNT = N;
+
+  /**
+   * The number of slots in #index.  This is a power of two and more
+   * than twice as large as #MAX_COUNT to keep the probe sequences
+   * short.
+   */
+  static constexpr size_t INDEX_SIZE = std::bit_ceil(2 * MAX_COUNT + 1);
+
+  static_assert(MAX_COUNT < 256, "index entries are 8 bit");
 
   /**
    * Time stamp of the latest modification to this object.
@@ -26,13 +41,26 @@ struct TrafficList {
    */
   Validity new_traffic;
 
-  /** Flarm traffic information */
+  /**
+   * Flarm traffic information.  Do not add or remove items directly,
+   * because that would break the #index.
+   */
   TrivialArray<FlarmTraffic, MAX_COUNT> list;
 
+  /**
+   * A hash table (with linear probing) mapping #FlarmId to the
+   * position in #list plus one; zero is an empty slot.  It is rebuilt
+   * after items have been removed.  This is a plain array and not a
+   * pointer to a separate allocation, because this object is copied
+   * with memcpy() between the blackboards.
+   */
+  std::array<uint8_t, INDEX_SIZE> index;
+
   constexpr void Clear() noexcept {
     modified.Clear();
     new_traffic.Clear();
     list.clear();
+    index.fill(0);
   }
 
   constexpr bool IsEmpty() const noexcept {
@@ -43,7 +71,7 @@ struct TrafficList {
    * Adds data from the specified object, unless already present in
    * this one.
    */
-  constexpr void Complement(const TrafficList &add) noexcept {
+  constexpr void Complement(const BasicTrafficList &add) noexcept {
     if (add.modified.Modified(modified))
       modified = add.modified;
 
@@ -54,13 +82,14 @@ struct TrafficList {
       /* don't bother merging the two lists, we can simply memcpy()
          it */
       list = add.list;
+      index = add.index;
       return;
     }
 
     // Add unique traffic from 'add' list
     for (auto &traffic : add.list) {
       if (FindTraffic(traffic.id) == nullptr) {
-        FlarmTraffic * new_traffic = AllocateTraffic();
+        FlarmTraffic * new_traffic = AllocateTraffic(traffic.id);
         if (new_traffic == nullptr)
           return;
         *new_traffic = traffic;
@@ -72,9 +101,16 @@ struct TrafficList {
     modified.Expire(clock, std::chrono::minutes(5));
     new_traffic.Expire(clock, std::chrono::minutes(1));
 
-    for (unsigned i = list.size(); i-- > 0;)
-      if (!list[i].Refresh(clock))
+    bool removed = false;
+    for (unsigned i = list.size(); i-- > 0;) {
+      if (!list[i].Refresh(clock)) {
         list.quick_remove(i);
+        removed = true;
+      }
+    }
+
+    if (removed)
+      RebuildIndex();
   }
 
   constexpr unsigned GetActiveTrafficCount() const noexcept {
@@ -88,11 +124,8 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   constexpr FlarmTraffic *FindTraffic(FlarmId id) noexcept {
-    for (auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const unsigned i = index[FindSlot(id)];
+    return i > 0 ? &list[i - 1] : nullptr;
   }
 
   /**
@@ -102,11 +135,8 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   constexpr const FlarmTraffic *FindTraffic(FlarmId id) const noexcept {
-    for (const auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const unsigned i = index[FindSlot(id)];
+    return i > 0 ? &list[i - 1] : nullptr;
   }
 
   /**
@@ -138,14 +168,25 @@ struct TrafficList {
   }
 
   /**
-   * Allocates a new FLARM_TRAFFIC object from the array.
+   * Allocates a new (cleared) FLARM_TRAFFIC object from the array.
    *
+   * @param id the FLARM id of the new object; it must not be in the
+   * list already
    * @return the FLARM_TRAFFIC pointer, NULL if the array is full
    */
-  constexpr FlarmTraffic *AllocateTraffic() noexcept {
-    return list.full()
-      ? NULL
-      : &list.append();
+  constexpr FlarmTraffic *AllocateTraffic(FlarmId id) noexcept {
+    if (list.full())
+      return nullptr;
+
+    const auto slot = FindSlot(id);
+    assert(index[slot] == 0);
+
+    auto &traffic = list.append();
+    traffic.Clear();
+    traffic.id = id;
+
+    index[slot] = list.size();
+    return &traffic;
   }
 
   /**
@@ -180,6 +221,40 @@ struct TrafficList {
     return list.empty() ? NULL : list.end() - 1;
   }
 
+  constexpr unsigned TrafficIndex(const FlarmTraffic *t) const noexcept {
+    return t - list.begin();
+  }
+
+private:
+  /**
+   * Find the #index slot of the given id, or the empty slot where it
+   * would be inserted.
+   */
+  constexpr std::size_t FindSlot(FlarmId id) const noexcept {
+    for (std::size_t slot = id.Hash() & (INDEX_SIZE - 1);;
+         slot = (slot + 1) & (INDEX_SIZE - 1)) {
+      const unsigned i = index[slot];
+      if (i == 0 || list[i - 1].id == id)
+        return slot;
+    }
+  }
+
+  constexpr void RebuildIndex() noexcept {
+    index.fill(0);
+
+    for (unsigned i = 0; i < list.size(); ++i)
+      index[FindSlot(list[i].id)] = i + 1;
+  }
+};
+
+/**
+ * This class keeps track of the traffic objects received from a
+ * FLARM.  It is part of #NMEAInfo and is therefore copied often, so
+ * it is small: if there are more targets, #DeviceBlackboard keeps all
+ * of them in a #TrafficStore and publishes only the most relevant
+ * ones here (see TrafficStore::CopyNearest()).
+ */
+struct TrafficList : BasicTrafficList<32> {
   /**
    * Finds the most critical alert.  Returns NULL if there is no
    * alert.
@@ -187,10 +262,6 @@ struct TrafficList {
   [[gnu::pure]]
   const FlarmTraffic *FindMaximumAlert() const noexcept;
 
-  constexpr unsigned TrafficIndex(const FlarmTraffic *t) const noexcept {
-    return t - list.begin();
-  }
-
   /**
    * Is set if traffic is present and closer than 4Km.
    */
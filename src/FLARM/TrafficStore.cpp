@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TrafficStore.hpp"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+/**
+ * Is traffic object "a" more relevant for the pilot than "b"?
+ */
+[[gnu::pure]]
+static bool
+IsMoreRelevant(const FlarmTraffic &a, const FlarmTraffic &b) noexcept
+{
+  if (a.alarm_level != b.alarm_level)
+    return (unsigned)a.alarm_level > (unsigned)b.alarm_level;
+
+  /* FlarmTraffic::distance has not been calculated yet at this
+     point */
+  return a.relative_north * a.relative_north +
+    a.relative_east * a.relative_east <
+    b.relative_north * b.relative_north +
+    b.relative_east * b.relative_east;
+}
+
+void
+TrafficStore::CopyNearest(TrafficList &dest) const noexcept
+{
+  dest.Clear();
+  dest.modified = modified;
+  dest.new_traffic = new_traffic;
+
+  std::array<uint8_t, MAX_COUNT> order;
+  std::size_t n = list.size();
+  std::iota(order.begin(), std::next(order.begin(), n), 0);
+
+  if (n > TrafficList::MAX_COUNT) {
+    const auto begin = order.begin();
+    const auto middle = std::next(begin, TrafficList::MAX_COUNT);
+    std::nth_element(begin, middle, std::next(begin, n),
+                     [this](unsigned a, unsigned b){
+                       return IsMoreRelevant(list[a], list[b]);
+                     });
+
+    n = TrafficList::MAX_COUNT;
+    std::sort(begin, middle);
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const FlarmTraffic &src = list[order[i]];
+    *dest.AllocateTraffic(src.id) = src;
+  }
+}
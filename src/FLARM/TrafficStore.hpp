@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "List.hpp"
+
+/**
+ * Keeps track of all traffic objects received from a FLARM, more
+ * than fit into a #TrafficList.  This object is large, and it is not
+ * part of #NMEAInfo; #DeviceBlackboard owns one per device (filled
+ * by the NMEA parser) and merges them, and only a #TrafficList with
+ * the most relevant targets is published to the blackboards.
+ */
+struct TrafficStore : BasicTrafficList<200> {
+  /**
+   * Replace the contents of the given #TrafficList with the
+   * #TrafficList::MAX_COUNT most relevant targets: alarms first,
+   * then the nearest ones.  The targets keep their order.
+   */
+  void CopyNearest(TrafficList &dest) const noexcept;
+};
+
+static_assert(std::is_trivial<TrafficStore>::value, "type is not trivial");
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/GeoPoint.hpp"
+#include "Geo/SearchPoint.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <math.h>
+
+/**
+ * Helpers shared by the convex hull algorithms (GrahamScan.cpp,
+ * IncrementalConvexHull.cpp), so both use the same point order and
+ * direction test.
+ */
+namespace ConvexHull {
+
+constexpr int
+Sign(double value, double tolerance) noexcept
+{
+  if (value > tolerance)
+    return 1;
+  if (value < -tolerance)
+    return -1;
+
+  return 0;
+}
+
+[[gnu::pure]]
+inline int
+Direction(const GeoPoint &p0, const GeoPoint &p1, const GeoPoint &p2,
+          double tolerance) noexcept
+{
+  //
+  // In this program we frequently want to look at three consecutive
+  // points, p0, p1, and p2, and determine whether p2 has taken a turn
+  // to the left or a turn to the right.
+  //
+  // We can do this by by translating the points so that p1 is at the origin,
+  // then taking the cross product of p0 and p2. The result will be positive,
+  // negative, or 0, meaning respectively that p2 has turned right, left, or
+  // is on a straight line.
+  //
+
+  const auto delta_a = p0 - p1;
+  const auto delta_b = p2 - p1;
+
+  const auto a = delta_a.longitude.Native() * delta_b.latitude.Native();
+  const auto b = delta_b.longitude.Native() * delta_a.latitude.Native();
+
+  if (tolerance < 0)
+    /* auto-tolerance - this has been verified by experiment */
+    tolerance = std::max(fabs(a), fabs(b)) / 10;
+
+  return Sign(a - b, tolerance);
+}
+
+/**
+ * The sort order of the hull algorithms: by longitude, then by
+ * latitude.
+ */
+[[gnu::pure]]
+constexpr bool
+LocationLess(const GeoPoint &gp1, const GeoPoint &gp2) noexcept
+{
+  if (gp1.longitude < gp2.longitude)
+    return true;
+  else if (gp1.longitude == gp2.longitude)
+    return gp1.latitude < gp2.latitude;
+  else
+    return false;
+}
+
+/**
+ * Build the lower or the upper half of the hull from the points of
+ * one partition (see PruneInterior() in GrahamScan.cpp).
+ *
+ * @param input the points between #left and #right on one side, sorted
+ * with LocationLess()
+ * @param output an empty vector which receives the half hull, from
+ * #left to #right
+ * @param factor 1 for the lower hull, -1 for the upper hull
+ * @return true if points were pruned
+ */
+bool
+BuildHalfHull(const SearchPoint &left, const SearchPoint &right,
+              std::vector<SearchPoint> &&input,
+              std::vector<SearchPoint> &output,
+              double tolerance, int factor) noexcept;
+
+} // namespace ConvexHull
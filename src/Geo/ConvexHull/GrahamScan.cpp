@@ -2,63 +2,20 @@
 // Copyright The XCSoar Project
 
 #include "GrahamScan.hpp"
+#include "Direction.hpp"
 #include "Geo/SearchPointVector.hpp"
 
 #include <algorithm>
 
-static constexpr int
-Sign(double value, double tolerance) noexcept
-{
-  if (value > tolerance)
-    return 1;
-  if (value < -tolerance)
-    return -1;
-
-  return 0;
-}
-
-[[gnu::pure]]
-static int
-Direction(const GeoPoint &p0, const GeoPoint &p1, const GeoPoint &p2,
-          double tolerance) noexcept
-{
-  //
-  // In this program we frequently want to look at three consecutive
-  // points, p0, p1, and p2, and determine whether p2 has taken a turn
-  // to the left or a turn to the right.
-  //
-  // We can do this by by translating the points so that p1 is at the origin,
-  // then taking the cross product of p0 and p2. The result will be positive,
-  // negative, or 0, meaning respectively that p2 has turned right, left, or
-  // is on a straight line.
-  //
-
-  const auto delta_a = p0 - p1;
-  const auto delta_b = p2 - p1;
-
-  const auto a = delta_a.longitude.Native() * delta_b.latitude.Native();
-  const auto b = delta_b.longitude.Native() * delta_a.latitude.Native();
-
-  if (tolerance < 0)
-    /* auto-tolerance - this has been verified by experiment */
-    tolerance = std::max(fabs(a), fabs(b)) / 10;
-
-  return Sign(a - b, tolerance);
-}
+using ConvexHull::Direction;
+using ConvexHull::BuildHalfHull;
 
 [[gnu::pure]]
 static auto
 Sorted(std::vector<SearchPoint> v) noexcept
 {
   std::sort(v.begin(), v.end(), [](const SearchPoint &sp1, const SearchPoint &sp2){
-    const auto &gp1 = sp1.GetLocation();
-    const auto &gp2 = sp2.GetLocation();
-    if (gp1.longitude < gp2.longitude)
-      return true;
-    else if (gp1.longitude == gp2.longitude)
-      return gp1.latitude < gp2.latitude;
-    else
-      return false;
+    return ConvexHull::LocationLess(sp1.GetLocation(), sp2.GetLocation());
   });
 
   return v;
@@ -138,11 +95,11 @@ PartitionPoints(const std::vector<SearchPoint> &src, double tolerance) noexcept
   return result;
 }
 
-static bool
-BuildHalfHull(const SearchPoint &left, const SearchPoint &right,
-              std::vector<SearchPoint> &&input,
-              std::vector<SearchPoint> &output,
-              double tolerance, int factor) noexcept
+bool
+ConvexHull::BuildHalfHull(const SearchPoint &left, const SearchPoint &right,
+                          std::vector<SearchPoint> &&input,
+                          std::vector<SearchPoint> &output,
+                          double tolerance, int factor) noexcept
 {
   //
   // This is the method that builds either the upper or the lower half convex
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "IncrementalConvexHull.hpp"
+#include "Direction.hpp"
+#include "GrahamScan.hpp"
+#include "Geo/SearchPointVector.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+using ConvexHull::Direction;
+using ConvexHull::LocationLess;
+
+static bool
+LocationLessSP(const SearchPoint &a, const SearchPoint &b) noexcept
+{
+  return LocationLess(a.GetLocation(), b.GetLocation());
+}
+
+void
+IncrementalConvexHull::Assign(const SearchPointVector &v) noexcept
+{
+  valid = false;
+
+  if (v.size() < 3)
+    /* PruneInterior() does nothing with these */
+    return;
+
+  std::vector<SearchPoint> sorted(v.begin(), v.end());
+  std::sort(sorted.begin(), sorted.end(), LocationLessSP);
+
+  if (std::adjacent_find(sorted.begin(), sorted.end(),
+                         [](const SearchPoint &a, const SearchPoint &b){
+                           return a.GetLocation() == b.GetLocation();
+                         }) != sorted.end())
+    /* PruneInterior() would remove the duplicate */
+    return;
+
+  /* partition the points like PartitionPoints() in GrahamScan.cpp */
+  left = sorted.front();
+  right = sorted.back();
+
+  sorted.erase(sorted.begin());
+  sorted.pop_back();
+  Partition(std::move(sorted));
+
+  valid = true;
+}
+
+bool
+IncrementalConvexHull::AddFull(SearchPointVector &v,
+                               const SearchPoint &sp) noexcept
+{
+  v.push_back(sp);
+  const bool pruned = PruneInterior(v, tolerance);
+  Assign(v);
+  return pruned;
+}
+
+void
+IncrementalConvexHull::Partition(std::vector<SearchPoint> &&middle) noexcept
+{
+  lower.clear();
+  upper.clear();
+
+  for (const auto &i : middle) {
+    if (Direction(left.GetLocation(), right.GetLocation(),
+                  i.GetLocation(), tolerance) < 0)
+      upper.push_back(i);
+    else
+      lower.push_back(i);
+  }
+}
+
+bool
+IncrementalConvexHull::Add(SearchPointVector &v,
+                           const SearchPoint &sp) noexcept
+{
+  const GeoPoint &location = sp.GetLocation();
+
+  if (!valid ||
+      location == left.GetLocation() || location == right.GetLocation())
+    return AddFull(v, sp);
+
+  if (LocationLess(location, left.GetLocation()) ||
+      LocationLess(right.GetLocation(), location)) {
+    /* a new leftmost or rightmost point: the line between them
+       changes, so all points need to be partitioned again; merging
+       the sorted partitions avoids sorting them */
+    std::vector<SearchPoint> middle;
+    middle.reserve(lower.size() + upper.size() + 1);
+    std::merge(lower.begin(), lower.end(), upper.begin(), upper.end(),
+               std::back_inserter(middle), LocationLessSP);
+
+    if (LocationLess(location, left.GetLocation())) {
+      middle.insert(middle.begin(), left);
+      left = sp;
+    } else {
+      middle.push_back(right);
+      right = sp;
+    }
+
+    Partition(std::move(middle));
+  } else {
+    auto &partition = Direction(left.GetLocation(), right.GetLocation(),
+                                location, tolerance) < 0
+      ? upper
+      : lower;
+
+    const auto i = std::lower_bound(partition.begin(), partition.end(),
+                                    sp, LocationLessSP);
+    if (i != partition.end() && i->GetLocation() == location)
+      /* duplicate */
+      return AddFull(v, sp);
+
+    partition.insert(i, sp);
+  }
+
+  /* rebuild both half hulls like BuildHull() in GrahamScan.cpp; the
+     partition which did not receive the new point may need pruning
+     as well, because the vector may have been thinned with a
+     different tolerance */
+  std::vector<SearchPoint> lower_hull, upper_hull;
+  const bool lower_pruned =
+    ConvexHull::BuildHalfHull(left, right, std::vector<SearchPoint>(lower),
+                              lower_hull, tolerance, 1);
+  const bool upper_pruned =
+    ConvexHull::BuildHalfHull(left, right, std::vector<SearchPoint>(upper),
+                              upper_hull, tolerance, -1);
+
+  if (!lower_pruned && !upper_pruned) {
+    /* like PruneInterior(), leave the vector alone */
+    v.push_back(sp);
+    return false;
+  }
+
+  /* copy the hull to the vector in the order of PruneInterior() */
+  v.clear();
+  v.insert(v.end(), lower_hull.begin(), std::prev(lower_hull.end()));
+  v.insert(v.end(), upper_hull.rbegin(), std::prev(upper_hull.rend()));
+
+  /* the remaining points stay in their partitions */
+  lower.assign(std::next(lower_hull.begin()), std::prev(lower_hull.end()));
+  upper.assign(std::next(upper_hull.begin()), std::prev(upper_hull.end()));
+  return true;
+}
+
+void
+IncrementalConvexHull::Project(const FlatProjection &projection) noexcept
+{
+  if (!valid)
+    /* left and right may be uninitialised */
+    return;
+
+  left.Project(projection);
+  right.Project(projection);
+
+  for (auto &i : lower)
+    i.Project(projection);
+
+  for (auto &i : upper)
+    i.Project(projection);
+}
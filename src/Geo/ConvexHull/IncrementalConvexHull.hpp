@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/SearchPoint.hpp"
+
+#include <vector>
+
+class SearchPointVector;
+class FlatProjection;
+
+/**
+ * Maintains the convex hull of a #SearchPointVector while points are
+ * added one at a time.  The result is exactly the same as appending
+ * each point and calling PruneInterior() with the same tolerance
+ * (including the automatic tolerance), but the vector does not need
+ * to be sorted and partitioned again for each point.
+ *
+ * This object caches the partitions of the Graham scan: the leftmost
+ * and the rightmost point, and the points below and above the line
+ * between them, each sorted from left to right.  A new point is
+ * inserted into its partition with a binary search (or, if it is the
+ * new leftmost or rightmost point, the sorted partitions are merged
+ * and split again), and then the two half hulls are rebuilt from the
+ * partitions.  This costs O(n) instead of the O(n log n) sort of
+ * PruneInterior().  Duplicate points and very small vectors take the
+ * slow path, a full PruneInterior().
+ */
+class IncrementalConvexHull {
+  double tolerance;
+
+  /**
+   * Does the cache describe the vector?  If not, the next Add() call
+   * uses PruneInterior() and rebuilds the cache.
+   */
+  bool valid = false;
+
+  SearchPoint left, right;
+  std::vector<SearchPoint> lower, upper;
+
+public:
+  /**
+   * @param _tolerance the tolerance for the direction sign; -1 for
+   * automatic tolerance (see PruneInterior())
+   */
+  explicit IncrementalConvexHull(double _tolerance=-1) noexcept
+    :tolerance(_tolerance) {}
+
+  /**
+   * Forget the cache; must be called after the vector has been
+   * modified by somebody else.
+   */
+  void Invalidate() noexcept {
+    valid = false;
+  }
+
+  /**
+   * Rebuild the cache from the given vector.
+   */
+  void Assign(const SearchPointVector &v) noexcept;
+
+  /**
+   * Equivalent to `v.push_back(sp); return PruneInterior(v,
+   * tolerance);`.  The vector must not have been modified since the
+   * last Assign() or Add() call (see Invalidate()).
+   *
+   * @return true if points were pruned
+   */
+  bool Add(SearchPointVector &v, const SearchPoint &sp) noexcept;
+
+  /**
+   * Re-project the cached points, to be called together with
+   * SearchPointVector::Project().
+   */
+  void Project(const FlatProjection &projection) noexcept;
+
+private:
+  /**
+   * Distribute the given points (sorted, between #left and #right)
+   * to #lower and #upper like PartitionPoints() in GrahamScan.cpp.
+   */
+  void Partition(std::vector<SearchPoint> &&middle) noexcept;
+
+  /**
+   * The slow path of Add(): let PruneInterior() do it.
+   */
+  bool AddFull(SearchPointVector &v, const SearchPoint &sp) noexcept;
+};
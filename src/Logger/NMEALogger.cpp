@@ -3,21 +3,122 @@
 
 #include "Logger/NMEALogger.hpp"
 #include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "thread/BoundedMPSCQueue.hpp"
+#include "thread/Cond.hxx"
+#include "thread/Thread.hpp"
 #include "LocalPath.hpp"
+#include "LogFile.hpp"
 #include "time/BrokenDateTime.hpp"
 #include "system/Path.hpp"
-#include "util/SpanCast.hxx"
 #include "util/StaticString.hxx"
 
-NMEALogger::NMEALogger() noexcept {}
-NMEALogger::~NMEALogger() noexcept = default;
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+class NMEALogger::Writer final : Thread {
+  /**
+   * Longer lines are dropped.  This is much more than the NMEA
+   * standard allows, and enough for the proprietary sentences we
+   * know.
+   */
+  static constexpr std::size_t MAX_LINE = 254;
+
+  /**
+   * The queue has room for this many lines.  At the flush interval
+   * below, this allows 2500 lines per second.
+   */
+  static constexpr std::size_t QUEUE_SIZE = 512;
+
+  static constexpr std::chrono::milliseconds FLUSH_INTERVAL{200};
+
+  struct Line {
+    uint16_t length;
+    char data[MAX_LINE];
+  };
+
+  BoundedMPSCQueue<Line, QUEUE_SIZE> queue;
+
+  std::atomic<unsigned> dropped{0};
+
+  Mutex mutex;
+  Cond cond;
+
+  /**
+   * Protected by #mutex.
+   */
+  bool stop = false;
+
+  /* the following attributes are only used by the writer thread */
+
+  std::unique_ptr<FileOutputStream> file;
+  std::unique_ptr<BufferedOutputStream> bos;
+
+  unsigned reported_dropped = 0;
+
+  /**
+   * Log the next error?  This is cleared after an error and set
+   * again after a successful write, to avoid flooding the log.
+   */
+  bool log_errors = true;
+
+public:
+  /**
+   * Throws on error.
+   */
+  Writer()
+    :Thread("NMEALogger")
+  {
+    Start();
+  }
+
+  ~Writer() noexcept {
+    {
+      const std::scoped_lock lock{mutex};
+      stop = true;
+    }
+
+    cond.notify_one();
+    Join();
+  }
+
+  void Push(std::string_view text) noexcept {
+    if (text.size() > MAX_LINE ||
+        !queue.TryPush([text](Line &line){
+          line.length = text.size();
+          std::copy(text.begin(), text.end(), line.data);
+        }))
+      dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  unsigned GetDroppedCount() const noexcept {
+    return dropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  void OpenFile();
+
+  /**
+   * Log the current exception and close the file; the next line
+   * will create a new one.
+   */
+  void Close(const char *msg) noexcept;
+
+  /**
+   * Write all queued lines to the file.
+   */
+  void WriteQueue() noexcept;
+
+  /* virtual methods from class Thread */
+  void Run() noexcept override;
+};
 
 inline void
-NMEALogger::Start()
+NMEALogger::Writer::OpenFile()
 {
-  if (file != nullptr)
-    return;
-
   BrokenDateTime dt = BrokenDateTime::NowUTC();
   assert(dt.IsPlausible());
 
@@ -31,28 +132,143 @@ NMEALogger::Start()
   const auto path = AllocatedPath::Build(logs_path, name);
   file = std::make_unique<FileOutputStream>(path,
                                             FileOutputStream::Mode::APPEND_OR_CREATE);
+  bos = std::make_unique<BufferedOutputStream>(*file);
 }
 
-static void
-WriteLine(OutputStream &os, std::string_view text)
+void
+NMEALogger::Writer::Close(const char *msg) noexcept
 {
-  os.Write(AsBytes(text));
+  if (log_errors) {
+    LogError(std::current_exception(), msg);
+    log_errors = false;
+  }
 
-  static constexpr char newline = '\n';
-  os.Write(ReferenceAsBytes(newline));
+  bos.reset();
+  file.reset();
 }
 
 void
-NMEALogger::Log(const char *text) noexcept
+NMEALogger::Writer::WriteQueue() noexcept
 {
-  if (!enabled)
-    return;
+  /* try to open the file at most once per pass */
+  bool open_failed = false;
+  unsigned n_lost = 0;
+
+  const auto consume = [this, &open_failed, &n_lost](const Line &line) noexcept {
+    if (bos == nullptr && !open_failed) {
+      /* the file is created when the first line arrives, so its name
+         is the time stamp of the first line */
+      try {
+        OpenFile();
+      } catch (...) {
+        Close("Failed to create NMEA log");
+        open_failed = true;
+      }
+    }
 
-  const std::lock_guard lock{mutex};
+    if (bos == nullptr) {
+      ++n_lost;
+      return;
+    }
+
+    try {
+      bos->Write(std::string_view{line.data, line.length});
+      bos->Write('\n');
+    } catch (...) {
+      Close("Failed to write NMEA log");
+      open_failed = true;
+      ++n_lost;
+    }
+  };
+
+  while (queue.TryPop(consume)) {}
+
+  if (bos != nullptr) {
+    try {
+      bos->Flush();
+      log_errors = true;
+    } catch (...) {
+      Close("Failed to write NMEA log");
+    }
+  }
+
+  if (n_lost > 0)
+    dropped.fetch_add(n_lost, std::memory_order_relaxed);
+
+  if (const unsigned d = GetDroppedCount(); d != reported_dropped) {
+    LogFormat("NMEA logger: %u lines dropped", d - reported_dropped);
+    reported_dropped = d;
+  }
+}
+
+void
+NMEALogger::Writer::Run() noexcept
+{
+  std::unique_lock lock{mutex};
+
+  while (!stop) {
+    cond.wait_for(lock, FLUSH_INTERVAL);
+
+    const ScopeUnlock unlock{mutex};
+    WriteQueue();
+  }
+
+  lock.unlock();
+
+  /* write the lines which were queued after the last pass */
+  WriteQueue();
+}
+
+NMEALogger::NMEALogger() noexcept {}
+NMEALogger::~NMEALogger() noexcept = default;
+
+bool
+NMEALogger::StartWriter() noexcept
+{
+  const std::scoped_lock lock{mutex};
+
+  if (writer != nullptr)
+    return true;
 
   try {
-    Start();
-    WriteLine(*file, text);
+    writer = std::make_unique<Writer>();
+    return true;
   } catch (...) {
+    LogError(std::current_exception(), "Failed to start NMEA logger");
+    return false;
   }
 }
+
+void
+NMEALogger::Enable() noexcept
+{
+  if (StartWriter())
+    enabled.store(true, std::memory_order_release);
+}
+
+void
+NMEALogger::ToggleEnabled() noexcept
+{
+  if (IsEnabled())
+    enabled.store(false, std::memory_order_relaxed);
+  else
+    Enable();
+}
+
+void
+NMEALogger::Log(const char *text) noexcept
+{
+  if (!enabled.load(std::memory_order_acquire))
+    return;
+
+  writer->Push(text);
+}
+
+unsigned
+NMEALogger::GetDroppedCount() const noexcept
+{
+  const std::scoped_lock lock{mutex};
+  return writer != nullptr
+    ? writer->GetDroppedCount()
+    : 0;
+}
@@ -5,31 +5,46 @@
 
 #include "thread/Mutex.hxx"
 
+#include <atomic>
 #include <memory>
 
-class FileOutputStream;
-
+/**
+ * Writes all NMEA lines received from the devices to a file.
+ *
+ * Log() is called from the port receive threads; it only copies the
+ * line into a lock-free queue.  A dedicated writer thread empties the
+ * queue periodically and writes the lines in batches, so slow
+ * storage does not stall the devices.  If the writer falls behind,
+ * lines are dropped (and counted).
+ */
 class NMEALogger {
-  Mutex mutex;
-  std::unique_ptr<FileOutputStream> file;
+  class Writer;
+
+  /**
+   * Protects the creation of #writer.
+   */
+  mutable Mutex mutex;
+
+  /**
+   * Created when logging is enabled for the first time, and never
+   * destroyed before this object, so Log() can use it without
+   * locking.
+   */
+  std::unique_ptr<Writer> writer;
 
-  bool enabled = false;
+  std::atomic_bool enabled = false;
 
 public:
   NMEALogger() noexcept;
   ~NMEALogger() noexcept;
 
   bool IsEnabled() const noexcept {
-    return enabled;
+    return enabled.load(std::memory_order_relaxed);
   }
 
-  void Enable() noexcept {
-    enabled = true;
-  }
+  void Enable() noexcept;
 
-  void ToggleEnabled() noexcept {
-    enabled = !enabled;
-  }
+  void ToggleEnabled() noexcept;
 
   /**
    * Logs NMEA string to log file
@@ -37,6 +52,18 @@ public:
    */
   void Log(const char *line) noexcept;
 
+  /**
+   * Returns the number of lines which were not logged because the
+   * writer thread could not keep up (or because they were too long).
+   */
+  [[gnu::pure]]
+  unsigned GetDroppedCount() const noexcept;
+
 private:
-  void Start();
+  /**
+   * Create the #writer if it does not exist yet.
+   *
+   * @return false on error
+   */
+  bool StartWriter() noexcept;
 };
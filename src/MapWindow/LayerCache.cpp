@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "LayerCache.hpp"
+#include "Projection/WindowProjection.hpp"
+
+bool
+LayerCache::Check(const WindowProjection &projection) const noexcept
+{
+  assert(projection.IsValid());
+
+  return buffer.IsDefined() &&
+    buffer.GetSize() == projection.GetScreenSize() &&
+    compare_projection.Compare(projection);
+}
+
+Canvas &
+LayerCache::Begin(Canvas &canvas, const WindowProjection &projection) noexcept
+{
+  assert(canvas.IsDefined());
+  assert(projection.IsValid());
+  assert(canvas.GetSize() == projection.GetScreenSize());
+
+  if (!buffer.IsDefined())
+    buffer.Create(canvas);
+
+  buffer.Begin(canvas);
+
+  compare_projection = CompareProjection(projection);
+  return buffer;
+}
+
+void
+LayerCache::Commit(Canvas &canvas) noexcept
+{
+  assert(compare_projection.IsDefined());
+
+  buffer.Commit(canvas);
+}
+
+void
+LayerCache::CopyTo(Canvas &canvas) noexcept
+{
+  assert(buffer.IsDefined());
+  assert(compare_projection.IsDefined());
+
+  buffer.CopyTo(canvas);
+}
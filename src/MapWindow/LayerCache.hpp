@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Projection/CompareProjection.hpp"
+#include "ui/canvas/BufferCanvas.hpp"
+
+class Canvas;
+class WindowProjection;
+
+/**
+ * Caches the output of the bottom-most (opaque) map layers in an
+ * off-screen buffer.  As long as the projection does not change and
+ * the caller does not invalidate it, the buffer is copied to the
+ * screen instead of rendering those layers again.
+ *
+ * This is the OpenGL counterpart of #TransparentRendererCache; it
+ * does not need color keying because the cached layers cover the
+ * whole map area.
+ */
+class LayerCache {
+  CompareProjection compare_projection;
+  BufferCanvas buffer;
+
+public:
+  void Invalidate() noexcept {
+    compare_projection.Clear();
+  }
+
+  /**
+   * Check if the cache can be used.
+   *
+   * @return true if the cache is valid for the given projection; the
+   * caller may skip to CopyTo()
+   */
+  [[gnu::pure]]
+  bool Check(const WindowProjection &projection) const noexcept;
+
+  /**
+   * Begin drawing to the cache.  Render to the returned Canvas.  Call
+   * Commit() when you're done.
+   */
+  Canvas &Begin(Canvas &canvas, const WindowProjection &projection) noexcept;
+
+  /**
+   * Finish drawing to the cache and copy it to the given #Canvas.
+   */
+  void Commit(Canvas &canvas) noexcept;
+
+  /**
+   * Copy the cache to the given #Canvas.
+   */
+  void CopyTo(Canvas &canvas) noexcept;
+};
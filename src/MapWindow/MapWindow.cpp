@@ -59,6 +59,10 @@ MapWindow::FlushCaches() noexcept
   if (rasp_renderer)
     rasp_renderer->Flush();
   airspace_renderer.Flush();
+
+#ifdef ENABLE_OPENGL
+  layer_cache.Invalidate();
+#endif
 }
 
 /**
@@ -142,6 +146,10 @@ MapWindow::SetTopography(TopographyStore *_topography) noexcept
   topography_renderer = topography != nullptr
     ? new CachedTopographyRenderer(*topography, look.topography)
     : nullptr;
+
+#ifdef ENABLE_OPENGL
+  layer_cache.Invalidate();
+#endif
 }
 
 void
@@ -149,6 +157,10 @@ MapWindow::SetTerrain(RasterTerrain *_terrain) noexcept
 {
   terrain = _terrain;
   background.SetTerrain(_terrain);
+
+#ifdef ENABLE_OPENGL
+  layer_cache.Invalidate();
+#endif
 }
 
 void
@@ -156,4 +168,8 @@ MapWindow::SetRasp(const std::shared_ptr<RaspStore> &_rasp_store) noexcept
 {
   rasp_renderer.reset();
   rasp_store = _rasp_store;
+
+#ifdef ENABLE_OPENGL
+  layer_cache.Invalidate();
+#endif
 }
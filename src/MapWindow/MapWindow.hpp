@@ -6,7 +6,11 @@
 #include "Projection/MapWindowProjection.hpp"
 #include "Renderer/AirspaceRenderer.hpp"
 #include "ui/window/DoubleBufferWindow.hpp"
-#ifndef ENABLE_OPENGL
+#ifdef ENABLE_OPENGL
+#include "LayerCache.hpp"
+#include "Terrain/TerrainSettings.hpp"
+#include "util/Serial.hpp"
+#else
 #include "ui/canvas/BufferCanvas.hpp"
 #endif
 #include "Renderer/LabelBlock.hpp"
@@ -114,6 +118,31 @@ protected:
 
 #ifdef ENABLE_OPENGL
   std::unique_ptr<MapOverlay> overlay;
+
+  /**
+   * Caches the terrain, RASP and topography layers, which change much
+   * less often than the map gets redrawn.
+   */
+  LayerCache layer_cache;
+
+  /**
+   * The input of the layers in #layer_cache.  If it changes, the
+   * cache needs to be redrawn.
+   */
+  struct CachedLayersState {
+    Serial terrain;
+    TerrainRendererSettings terrain_settings;
+
+    int rasp_map;
+    Serial rasp;
+
+    bool topography_enabled;
+    unsigned topography;
+
+    bool operator==(const CachedLayersState &) const noexcept = default;
+  };
+
+  CachedLayersState cached_layers_state{};
 #endif
 
   const TrafficLook &traffic_look;
@@ -338,8 +367,23 @@ private:
    */
   void RenderTerrain(Canvas &canvas) noexcept;
 
+  /**
+   * Load the configured RASP map if necessary.
+   */
+  void UpdateRasp() noexcept;
+
   void RenderRasp(Canvas &canvas) noexcept;
 
+#ifdef ENABLE_OPENGL
+  [[gnu::pure]]
+  CachedLayersState GetCachedLayersState() const noexcept;
+
+  /**
+   * Renders terrain, RASP and topography through #layer_cache.
+   */
+  void RenderCachedLayers(Canvas &canvas) noexcept;
+#endif
+
   void RenderTerrainAbove(Canvas &canvas, bool working) noexcept;
 
   /**
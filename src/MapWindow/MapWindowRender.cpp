@@ -7,6 +7,7 @@
 #include "Weather/Rasp/RaspRenderer.hpp"
 #include "Weather/Rasp/RaspCache.hpp"
 #include "Topography/CachedTopographyRenderer.hpp"
+#include "Topography/TopographyStore.hpp"
 #include "Renderer/AircraftRenderer.hpp"
 #include "Renderer/WaveRenderer.hpp"
 #include "Operation/Operation.hpp"
@@ -33,7 +34,7 @@ MapWindow::RenderTerrain(Canvas &canvas) noexcept
 }
 
 inline void
-MapWindow::RenderRasp(Canvas &canvas) noexcept
+MapWindow::UpdateRasp() noexcept
 {
   if (rasp_store == nullptr)
     return;
@@ -63,6 +64,13 @@ MapWindow::RenderRasp(Canvas &canvas) noexcept
     QuietOperationEnvironment operation;
     rasp_renderer->Update(Calculated().date_time_local, operation);
   }
+}
+
+inline void
+MapWindow::RenderRasp(Canvas &canvas) noexcept
+{
+  if (!rasp_renderer)
+    return;
 
   const auto &terrain_settings = GetMapSettings().terrain;
   if (rasp_renderer->Generate(render_projection, terrain_settings))
@@ -76,6 +84,65 @@ MapWindow::RenderTopography(Canvas &canvas) noexcept
     topography_renderer->Draw(canvas, render_projection);
 }
 
+#ifdef ENABLE_OPENGL
+
+MapWindow::CachedLayersState
+MapWindow::GetCachedLayersState() const noexcept
+{
+  const auto &settings = GetMapSettings();
+
+  CachedLayersState state{};
+  state.terrain = background.GetSerial();
+  state.terrain_settings = settings.terrain;
+
+  if (rasp_renderer) {
+    state.rasp_map = rasp_renderer->GetParameter();
+    state.rasp = rasp_renderer->GetSerial();
+  } else
+    state.rasp_map = -1;
+
+  state.topography_enabled = settings.topography_enabled;
+  if (topography != nullptr)
+    state.topography = topography->GetSerial();
+
+  return state;
+}
+
+inline void
+MapWindow::RenderCachedLayers(Canvas &canvas) noexcept
+{
+  /* let the renderers update their data first; if anything has
+     changed, the layers need to be rendered again */
+  background.SetShadingAngle(render_projection, GetMapSettings().terrain,
+                             Calculated());
+  background.Generate(render_projection, GetMapSettings().terrain);
+  UpdateRasp();
+
+  const auto state = GetCachedLayersState();
+  if (state == cached_layers_state && layer_cache.Check(render_projection)) {
+    draw_sw.Mark("CopyCachedLayers");
+    layer_cache.CopyTo(canvas);
+    return;
+  }
+
+  cached_layers_state = state;
+
+  Canvas &buffer = layer_cache.Begin(canvas, render_projection);
+
+  draw_sw.Mark("RenderTerrain");
+  RenderTerrain(buffer);
+
+  draw_sw.Mark("RenderRasp");
+  RenderRasp(buffer);
+
+  draw_sw.Mark("RenderTopography");
+  RenderTopography(buffer);
+
+  layer_cache.Commit(canvas);
+}
+
+#endif
+
 inline void
 MapWindow::RenderTopographyLabels(Canvas &canvas) noexcept
 {
@@ -187,14 +254,19 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc) noexcept
   //////////////////////////////////////////////// items on ground
 
   // Render terrain, groundline and topography
+#ifdef ENABLE_OPENGL
+  RenderCachedLayers(canvas);
+#else
   draw_sw.Mark("RenderTerrain");
   RenderTerrain(canvas);
 
   draw_sw.Mark("RenderRasp");
+  UpdateRasp();
   RenderRasp(canvas);
 
   draw_sw.Mark("RenderTopography");
   RenderTopography(canvas);
+#endif
 
   draw_sw.Mark("RenderOverlays");
   RenderOverlays(canvas);
@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 #include "ZeroFinder.hpp"
 
+#include <algorithm>
 #include <limits>
 
 #include <math.h>
@@ -110,26 +111,95 @@ double
 ZeroFinder::find_zero(const double xstart) noexcept
 {
   if ((xmin<=xstart) || (xstart<=xmax) ||
-      (f(xstart)> sqrt_epsilon))
-    return find_zero_actual(xstart);
+      (f(xstart)> sqrt_epsilon)) {
+    const double fa = f(xmin);
+    const double fb = f(xmax);
+    return find_zero_actual(xmin, fa, xmax, fb);
+  }
   return xstart;
 }
 
+static constexpr bool
+has_sign_change(double fa, double fb) noexcept
+{
+  return (fa > 0) != (fb > 0) || fa == 0 || fb == 0;
+}
+
+double
+ZeroFinder::find_zero_near(const double xstart, const double step) noexcept
+{
+  assert(step > 0);
+
+  double a, b, fa, fb;
+
+  /* the x value f() was last called with */
+  double last;
+
+  if (xmin < xstart && xstart < xmax) {
+    /* widen the bracket around the initial guess until f changes its
+       sign; if the guess is still close to the solution (e.g. the
+       solution of the previous calculation cycle), this is much
+       cheaper than searching the whole range */
+    a = std::max(xstart - step, xmin);
+    b = std::min(xstart + step, xmax);
+    fa = f(a);
+    fb = f(b);
+    last = b;
+
+    for (double width = step;
+         !has_sign_change(fa, fb) && (a > xmin || b < xmax);) {
+      width *= 8;
+
+      if (a > xmin) {
+        a = std::max(xstart - width, xmin);
+        fa = f(a);
+        last = a;
+      }
+
+      if (b < xmax) {
+        b = std::min(xstart + width, xmax);
+        fb = f(b);
+        last = b;
+      }
+    }
+  } else {
+    a = xmin;
+    b = xmax;
+    fa = f(a);
+    fb = f(b);
+    last = b;
+  }
+
+  if (!has_sign_change(fa, fb)) {
+    /* no zero in the whole range: the best solution is the end
+       closer to zero; this is where find_zero() would converge to,
+       but skipping its iterations saves many calls */
+    const double x = fabs(fa) < fabs(fb) ? a : b;
+    if (x != last)
+      /* call once more, f() may have side effects */
+      f(x);
+    return x;
+  }
+
+  if (last != b)
+    /* find_zero_actual() assumes that f() was last called with b,
+       and may return b without calling it again */
+    f(b);
+
+  return find_zero_actual(a, fa, b, fb);
+}
+
 inline double
-ZeroFinder::find_zero_actual([[maybe_unused]] const double xstart) noexcept
+ZeroFinder::find_zero_actual(double a, double fa,
+                             double b, double fb) noexcept
 {
-  double a, b, c; // Abscissae, descr. see above
-  double fa; // f(a)
-  double fb; // f(b)
+  double c; // Abscissae, descr. see above
   double fc; // f(c)
 
   bool b_best = true; // b is best and last called
 
-  c = a = xmin;  
-  fc = fa = f(a);  
-
-  b = xmax;  
-  fb = f(b);
+  c = a;
+  fc = fa;
 
   // Main iteration loop
   for (;;) {
@@ -55,6 +55,21 @@ public:
   [[gnu::pure]]
   double find_zero(double xstart) noexcept;
 
+  /**
+   * Like find_zero(), but assume that the solution is close to
+   * #xstart (e.g. the solution of the previous calculation): the
+   * search starts with the bracket [xstart-step, xstart+step] and
+   * widens it until the sign of f(x) changes.  If there is no sign
+   * change in the whole range, the end with the smaller |f(x)| is
+   * returned without further iterations.
+   *
+   * @param xstart Initial guess of x
+   * @param step Initial half width of the bracket around xstart
+   *
+   * @return x value of best solution
+   */
+  double find_zero_near(double xstart, double step) noexcept;
+
   /**
    * Find value of x that minimises f(x)
    * Method used is a variant of a bisector search.
@@ -68,8 +83,12 @@ public:
   double find_min(double xstart) noexcept;
 
 private:
-  [[gnu::pure]]
-  double find_zero_actual(double xstart) noexcept;
+  /**
+   * Search for a zero within the range [a,b] with the given
+   * (already evaluated) function values.
+   */
+  double find_zero_actual(double a, double fa,
+                          double b, double fb) noexcept;
 
   [[gnu::pure]]
   double find_min_actual(double xstart) noexcept;
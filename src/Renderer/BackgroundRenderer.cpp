@@ -24,6 +24,31 @@ BackgroundRenderer::SetTerrain(const RasterTerrain *_terrain) noexcept
   renderer.reset();
 }
 
+bool
+BackgroundRenderer::Generate(const WindowProjection &proj,
+                             const TerrainRendererSettings &terrain_settings) noexcept
+{
+  if (!terrain_settings.enable || terrain == nullptr)
+    return false;
+
+  if (!renderer)
+    // defer creation until first draw because
+    // the buffer size, smoothing etc is set by the
+    // loaded terrain properties
+    renderer.reset(new TerrainRenderer(*terrain));
+
+  renderer->SetSettings(terrain_settings);
+  return renderer->Generate(proj, shading_angle);
+}
+
+Serial
+BackgroundRenderer::GetSerial() const noexcept
+{
+  return renderer != nullptr
+    ? renderer->GetImageSerial()
+    : Serial{};
+}
+
 void
 BackgroundRenderer::Draw(Canvas& canvas,
                          const WindowProjection& proj,
@@ -31,17 +56,8 @@ BackgroundRenderer::Draw(Canvas& canvas,
 {
   canvas.ClearWhite();
 
-  if (terrain_settings.enable && terrain != nullptr) {
-    if (!renderer)
-      // defer creation until first draw because
-      // the buffer size, smoothing etc is set by the
-      // loaded terrain properties
-      renderer.reset(new TerrainRenderer(*terrain));
-
-    renderer->SetSettings(terrain_settings);
-    if (renderer->Generate(proj, shading_angle))
-      renderer->Draw(canvas, proj);
-  }
+  if (Generate(proj, terrain_settings))
+    renderer->Draw(canvas, proj);
 }
 
 void
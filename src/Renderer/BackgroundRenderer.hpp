@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Math/Angle.hpp"
+#include "util/Serial.hpp"
 
 #include <memory>
 
@@ -37,6 +38,22 @@ public:
             const WindowProjection& proj,
             const TerrainRendererSettings &terrain_settings) noexcept;
 
+  /**
+   * Generate the terrain image for the given projection if needed,
+   * but don't draw it.
+   *
+   * @return true if an image is available and Draw() will paint it
+   */
+  bool Generate(const WindowProjection &proj,
+                const TerrainRendererSettings &terrain_settings) noexcept;
+
+  /**
+   * Returns a serial which gets incremented each time a new terrain
+   * image has been generated.
+   */
+  [[gnu::pure]]
+  Serial GetSerial() const noexcept;
+
   void SetShadingAngle(const WindowProjection &projection,
                        const TerrainRendererSettings &settings,
                        const DerivedInfo &calculated) noexcept;
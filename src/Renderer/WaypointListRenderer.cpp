@@ -41,7 +41,8 @@ Draw(Canvas &canvas, PixelRect rc,
      const Waypoint &waypoint, const GeoVector *vector,
      const TwoTextRowsRenderer &row_renderer,
      const WaypointLook &look,
-     const WaypointRendererSettings &settings)
+     const WaypointRendererSettings &settings,
+     WaypointReachability reachable=WaypointReachability::UNREACHABLE)
 {
   const unsigned padding = Layout::GetTextPadding();
   const unsigned line_height = rc.GetHeight();
@@ -49,7 +50,7 @@ Draw(Canvas &canvas, PixelRect rc,
   // Draw icon
   const PixelPoint pt(rc.left + line_height / 2, rc.top + line_height / 2);
   WaypointIconRenderer wir(settings, look, canvas);
-  wir.Draw(waypoint, pt);
+  wir.Draw(waypoint, pt, reachable);
 
   rc.left += line_height + padding;
 
@@ -97,9 +98,11 @@ WaypointListRenderer::Draw(Canvas &canvas, const PixelRect rc,
                            const Waypoint &waypoint, const GeoVector &vector,
                            const TwoTextRowsRenderer &row_renderer,
                            const WaypointLook &look,
-                           const WaypointRendererSettings &settings)
+                           const WaypointRendererSettings &settings,
+                           WaypointReachability reachable)
 {
-  ::Draw(canvas, rc, waypoint, &vector, row_renderer, look, settings);
+  ::Draw(canvas, rc, waypoint, &vector, row_renderer, look, settings,
+         reachable);
 }
 
 void
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "WaypointReachability.hpp"
+
 class Canvas;
 class TwoTextRowsRenderer;
 struct PixelRect;
@@ -22,7 +24,8 @@ namespace WaypointListRenderer
             const GeoVector &vector,
             const TwoTextRowsRenderer &row_renderer,
             const WaypointLook &look,
-            const WaypointRendererSettings &settings);
+            const WaypointRendererSettings &settings,
+            WaypointReachability reachable=WaypointReachability::UNREACHABLE);
 
   void Draw(Canvas &canvas, const PixelRect rc, const Waypoint &waypoint,
             double distance, double arrival_altitude,
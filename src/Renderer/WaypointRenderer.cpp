@@ -11,7 +11,7 @@
 #include "Engine/Util/Gradient.hpp"
 #include "Engine/Waypoint/Waypoint.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
-#include "Engine/GlideSolvers/GlideState.hpp"
+#include "Engine/GlideSolvers/GlideBatch.hpp"
 #include "Engine/GlideSolvers/GlideResult.hpp"
 #include "Engine/GlideSolvers/MacCready.hpp"
 #include "Engine/Task/TaskManager.hpp"
@@ -20,6 +20,7 @@
 #include "Engine/Task/Ordered/Points/OrderedTaskPoint.hpp"
 #include "Task/ProtectedTaskManager.hpp"
 #include "Task/ProtectedRoutePlanner.hpp"
+#include "Task/LandableReach.hpp"
 #include "ui/canvas/Canvas.hpp"
 #include "Units/Units.hpp"
 #include "util/TruncateString.hpp"
@@ -31,6 +32,7 @@
 #include "Look/WaypointLook.hpp"
 
 #include <cassert>
+#include <vector>
 #include <stdio.h>
 
 /**
@@ -60,22 +62,26 @@ struct VisibleWaypoint {
     return ::IsReachable(reachable);
   }
 
-  void CalculateReachabilityDirect(const MoreData &basic,
-                                   const SpeedVector &wind,
-                                   const MacCready &mac_cready,
-                                   const TaskBehaviour &task_behaviour) noexcept {
+  /**
+   * Add this waypoint to the batch for
+   * CalculateReachabilityDirect().
+   *
+   * @return false if the waypoint has no elevation and was not added
+   */
+  bool AddToBatch(GlideBatch &batch, const MoreData &basic,
+                  const TaskBehaviour &task_behaviour) const noexcept {
     assert(basic.location_available);
-    assert(basic.NavAltitudeAvailable());
 
     if (!waypoint->has_elevation)
-      return;
+      return false;
 
     const auto elevation = waypoint->elevation +
       task_behaviour.safety_height_arrival;
-    const GlideState state(GeoVector(basic.location, waypoint->location),
-                           elevation, basic.nav_altitude, wind);
+    batch.Add(GeoVector(basic.location, waypoint->location), elevation);
+    return true;
+  }
 
-    const GlideResult result = mac_cready.SolveStraight(state);
+  void CalculateReachabilityDirect(const GlideResult &result) noexcept {
     if (!result.IsOk())
       return;
 
@@ -86,28 +92,28 @@ struct VisibleWaypoint {
       reachable = WaypointReachability::UNREACHABLE;
   }
 
-  bool CalculateRouteArrival(const ProtectedRoutePlanner &route_planner,
-                             const TaskBehaviour &task_behaviour) noexcept {
+  /**
+   * Look up the arrival height calculated by #CalculationThread.  A
+   * waypoint which is not in the table (out of range) has unknown
+   * reachability; the reach is not queried here, because that would
+   * lock the planner for each waypoint in each frame.
+   */
+  bool CalculateRouteArrival(const LandableReachTable &table) noexcept {
     if (!waypoint->has_elevation)
       return false;
 
-    const double elevation = waypoint->elevation +
-      task_behaviour.safety_height_arrival;
-    const AGeoPoint p_dest (waypoint->location, elevation);
-
-    auto _reach = route_planner.FindPositiveArrival(p_dest);
-    if (!_reach)
+    const auto *item = table.Find(waypoint->id);
+    if (item == nullptr || !item->reach)
       return false;
 
-    reach = *_reach;
-    reach.Subtract(elevation);
+    reach = *item->reach;
     return true;
   }
 
-  void CalculateReachability(const ProtectedRoutePlanner &route_planner,
+  void CalculateReachability(const LandableReachTable &table,
                              const TaskBehaviour &task_behaviour) noexcept
   {
-    if (!CalculateRouteArrival(route_planner, task_behaviour))
+    if (!CalculateRouteArrival(table))
       return;
 
     if (!reach.IsReachableDirect())
@@ -374,6 +380,22 @@ protected:
   }
 
 public:
+  /**
+   * How many more waypoints can be added?
+   */
+  unsigned GetRemaining() const noexcept {
+    return waypoints.capacity() - waypoints.size();
+  }
+
+  /**
+   * Would Add() accept this waypoint?
+   */
+  [[gnu::pure]]
+  bool IsVisible(const Waypoint &way_point) const noexcept {
+    return projection.WaypointInScaleFilter(way_point) &&
+      projection.GeoToScreenIfVisible(way_point.location);
+  }
+
   void Add(const WaypointPtr &way_point) noexcept {
     AddWaypoint(way_point, false);
   }
@@ -398,12 +420,12 @@ public:
     task_valid = true;
   }
 
-  void CalculateRoute(const ProtectedRoutePlanner &route_planner) noexcept {
+  void CalculateRoute(const LandableReachTable &table) noexcept {
     for (VisibleWaypoint &vwp : waypoints) {
       const Waypoint &way_point = *vwp.waypoint;
 
       if (way_point.IsLandable() || way_point.flags.watched)
-        vwp.CalculateReachability(route_planner, task_behaviour);
+        vwp.CalculateReachability(table, task_behaviour);
     }
   }
 
@@ -419,21 +441,37 @@ public:
       : calculated.glide_polar_safety;
     const MacCready mac_cready(task_behaviour.glide, glide_polar);
 
+    GlideBatch batch(basic.nav_altitude, calculated.GetWindOrZero());
+    StaticArray<VisibleWaypoint *, 256> batch_waypoints;
+
     for (VisibleWaypoint &vwp : waypoints) {
       const Waypoint &way_point = *vwp.waypoint;
 
-      if (way_point.IsLandable() || way_point.flags.watched)
-        vwp.CalculateReachabilityDirect(basic, calculated.GetWindOrZero(),
-                                        mac_cready, task_behaviour);
+      if ((way_point.IsLandable() || way_point.flags.watched) &&
+          vwp.AddToBatch(batch, basic, task_behaviour))
+        batch_waypoints.append(&vwp);
     }
+
+    std::vector<GlideResult> results(batch.size());
+    mac_cready.SolveStraight(batch, results);
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+      batch_waypoints[i]->CalculateReachabilityDirect(results[i]);
   }
 
   void Calculate(const ProtectedRoutePlanner *route_planner,
                  const PolarSettings &polar_settings,
                  const TaskBehaviour &task_behaviour,
                  const DerivedInfo &calculated) noexcept {
-    if (route_planner != nullptr && !route_planner->IsTerrainReachEmpty())
-      CalculateRoute(*route_planner);
+    /* the table exists only while there is a terrain reach; until
+       the calculation thread has published one for the current
+       safety height, use the straight glide */
+    const auto table = route_planner != nullptr
+      ? route_planner->GetLandableReach(task_behaviour.safety_height_arrival)
+      : nullptr;
+
+    if (table != nullptr)
+      CalculateRoute(*table);
     else
       CalculateDirect(polar_settings, task_behaviour, calculated);
   }
@@ -489,9 +527,13 @@ WaypointRenderer::Render(Canvas &canvas, LabelBlock &label_block,
       atask->AcceptTaskPointVisitor(v);
   }
 
-  way_points->VisitWithinRange(projection.GetGeoScreenCenter(),
-                               projection.GetScreenDistanceMeters(),
-                               [&v](const auto &w){ v.Add(w); });
+  /* if there are more visible waypoints than can be drawn, prefer
+     the ones nearest to the screen center */
+  way_points->VisitNearest(projection.GetGeoScreenCenter(),
+                           projection.GetScreenDistanceMeters(),
+                           v.GetRemaining(),
+                           [&v](const Waypoint &w){ return v.IsVisible(w); },
+                           [&v](const auto &w){ v.Add(w); });
 
   v.Calculate(route_planner, polar_settings, task_behaviour, calculated);
 
@@ -167,6 +167,7 @@ TaskAutoPilot::UpdateCruiseBearing(const TaskAccessor& task,
     bearing = stat.solution_remaining.vector.bearing;
 
     if (parms.enable_bestcruisetrack &&
+        stat.solution_remaining.IsOk() &&
         stat.solution_remaining.vector.distance > 1000)
       bearing = bct;
 
@@ -202,7 +203,7 @@ TaskAutoPilot::UpdateState(const TaskAccessor& task, AircraftState& state,
   case FinalGlide:
   {
     const ElementStat &stat = task.GetLegStats();
-    if (stat.solution_remaining.v_opt > 0)
+    if (stat.solution_remaining.IsOk() && stat.solution_remaining.v_opt > 0)
       state.true_airspeed = stat.solution_remaining.v_opt * speed_factor;
     else
       state.true_airspeed = glide_polar.GetVBestLD();
@@ -78,7 +78,6 @@
 #include "Engine/Task/Ordered/OrderedTask.hpp"
 #include "Operation/VerboseOperationEnvironment.hpp"
 #include "Operation/PluggableOperationEnvironment.hpp"
-#include "Operation/SubOperationEnvironment.hpp"
 #include "Widget/ProgressWidget.hpp"
 #include "PageActions.hpp"
 #include "Weather/Features.hpp"
@@ -90,11 +89,16 @@
 #include "Units/Units.hpp"
 #include "Formatter/UserGeoPointFormatter.hpp"
 #include "thread/Debug.hpp"
+#include "thread/JobGraph.hpp"
 
 #include "lua/StartFile.hpp"
 #include "lua/Background.hpp"
 
 #include "util/ScopeExit.hxx"
+#include "util/tstring.hpp"
+
+#include <chrono>
+#include <vector>
 
 #ifdef ENABLE_OPENGL
 #include "ui/canvas/opengl/Globals.hpp"
@@ -114,6 +118,52 @@ static AllMonitors *all_monitors;
 static GlideComputerTaskEvents *task_events;
 static DeviceFactory *device_factory;
 
+/**
+ * An #OperationEnvironment for a startup job which runs in another
+ * thread: error messages are collected, to be shown by the main
+ * thread after the job has finished; everything else is ignored.
+ */
+class StartupJobEnvironment final : public NullOperationEnvironment {
+  std::vector<tstring> errors;
+
+public:
+  void ShowErrors(OperationEnvironment &env) noexcept {
+    for (const auto &error : errors)
+      env.SetErrorMessage(error.c_str());
+    errors.clear();
+  }
+
+  /* virtual methods from class OperationEnvironment */
+  void SetErrorMessage(const TCHAR *text) noexcept override {
+    errors.emplace_back(text);
+  }
+};
+
+static auto
+ToMilliseconds(JobGraph::Clock::duration d) noexcept
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+}
+
+/**
+ * Wait for a job started by Startup() and log how long it took.
+ */
+static void
+WaitStartupJob(JobGraph &jobs, JobGraph::Id id,
+               JobGraph::Clock::time_point start) noexcept
+{
+  try {
+    jobs.Wait(id);
+  } catch (...) {
+    LogError(std::current_exception());
+  }
+
+  const auto &timing = jobs.GetTiming(id);
+  LogFmt("Startup: {} took {} ms (started after {} ms)",
+         jobs.GetName(id), ToMilliseconds(timing.GetDuration()),
+         ToMilliseconds(timing.start - start));
+}
+
 static bool
 LoadProfile()
 {
@@ -414,33 +464,55 @@ Startup(UI::Display &display)
                          CommonInterface::SetComputerSettings(), gp);
   task_manager->SetGlidePolar(gp);
 
-  // Read the topography file(s)
+  /* load the data files; the independent ones in parallel (the
+     terrain is loaded by MainWindow::LoadTerrain(), and the airspace
+     ground levels are updated by MainWindow::OnTerrainLoaded()) */
   data_components->topography = std::make_unique<TopographyStore>();
-  {
-    LogString("Loading Topography File...");
-    operation.SetText(_("Loading Topography File..."));
+  const RasterTerrain *const terrain = data_components->terrain.get();
+  std::shared_ptr<RaspStore> rasp;
+  StartupJobEnvironment airspace_env;
+
+  JobGraph jobs;
+
+  const auto topography_job = jobs.Add("Topography", [&]{
     LoadConfiguredTopography(*data_components->topography);
-    operation.SetProgressPosition(256);
-  }
+  });
 
-  // Read the waypoint files
-  LogString("ReadWaypoints");
-  {
-    SubOperationEnvironment sub_env(operation, 256, 512);
-    sub_env.SetText(_("Loading Waypoints..."));
-    WaypointGlue::LoadWaypoints(*data_components->waypoints,
-                                data_components->terrain.get(),
-                                sub_env);
-  }
+  const auto waypoints_job = jobs.Add("Waypoints", [&]{
+    NullOperationEnvironment env;
+    WaypointGlue::LoadWaypoints(*data_components->waypoints, terrain,
+                                file_cache, env);
+  });
 
-  // Read and parse the airfield info file
-  try {
-    SubOperationEnvironment sub_env(operation, 512, 768);
-    sub_env.SetText(_("Loading Airfield Details File..."));
-    WaypointDetails::ReadFileFromProfile(*data_components->waypoints, sub_env);
-  } catch (...) {
-    LogError(std::current_exception());
-  }
+  // the airfield info file annotates the waypoints
+  const auto details_job = jobs.Add("AirfieldDetails", [&]{
+    NullOperationEnvironment env;
+    WaypointDetails::ReadFileFromProfile(*data_components->waypoints, env);
+  }, {waypoints_job});
+
+  const auto rasp_job = jobs.Add("RASP", [&]{
+    rasp = LoadConfiguredRasp();
+  });
+
+  const auto airspace_job = jobs.Add("Airspace", [&]{
+    ReadAirspace(*data_components->airspaces, computer_settings.pressure,
+                 airspace_env);
+  });
+
+  const auto jobs_start = JobGraph::Clock::now();
+  jobs.Start();
+
+  operation.SetText(_("Loading Topography File..."));
+  WaitStartupJob(jobs, topography_job, jobs_start);
+  operation.SetProgressPosition(256);
+
+  operation.SetText(_("Loading Waypoints..."));
+  WaitStartupJob(jobs, waypoints_job, jobs_start);
+  operation.SetProgressPosition(512);
+
+  operation.SetText(_("Loading Airfield Details File..."));
+  WaitStartupJob(jobs, details_job, jobs_start);
+  operation.SetProgressPosition(768);
 
   // Set the home waypoint
   WaypointGlue::SetHome(*data_components->waypoints,
@@ -454,17 +526,15 @@ Startup(UI::Display &display)
   backend_components->device_blackboard->Merge();
   CommonInterface::ReadBlackboardBasic(backend_components->device_blackboard->Basic());
 
-  // Scan for weather forecast
-  LogString("RASP load");
-  auto rasp = LoadConfiguredRasp();
+  WaitStartupJob(jobs, rasp_job, jobs_start);
 
-  // Reads the airspace files
-  {
-    SubOperationEnvironment sub_env(operation, 768, 1024);
-    ReadAirspace(*data_components->airspaces,
-                 computer_settings.pressure,
-                 sub_env);
-  }
+  operation.SetText(_("Loading Airspace File..."));
+  WaitStartupJob(jobs, airspace_job, jobs_start);
+  airspace_env.ShowErrors(operation);
+  operation.SetProgressPosition(1024);
+
+  LogFmt("Startup: data files loaded after {} ms",
+         ToMilliseconds(JobGraph::Clock::now() - jobs_start));
 
   if (data_components->terrain)
     SetAirspaceGroundLevels(*data_components->airspaces,
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Engine/Route/ReachResult.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+/**
+ * The arrival heights of the landable (and watched) waypoints near
+ * the aircraft, calculated by #CalculationThread once per terrain
+ * reach update.  This allows the renderer to look up reachability
+ * without querying the #ReachFan for each waypoint in each frame.
+ *
+ * A waypoint which is not in the table (out of range, no elevation)
+ * has unknown reachability; the table is meant to be the only source,
+ * so callers should not fall back to querying the #ReachFan.
+ *
+ * Instances are immutable once published by #ProtectedRoutePlanner.
+ */
+class LandableReachTable {
+public:
+  struct Item {
+    unsigned waypoint_id;
+
+    /**
+     * The arrival height above the waypoint elevation plus the
+     * arrival safety height; std::nullopt if the waypoint is not
+     * reachable.
+     */
+    std::optional<ReachResult> reach;
+
+    constexpr bool operator<(unsigned other_id) const noexcept {
+      return waypoint_id < other_id;
+    }
+  };
+
+private:
+  /**
+   * Sorted by #Item::waypoint_id.
+   */
+  std::vector<Item> items;
+
+public:
+  /**
+   * The #ProtectedRoutePlanner reach serial this table was
+   * calculated from.
+   */
+  unsigned serial;
+
+  /**
+   * The arrival safety height which was subtracted from all
+   * results.
+   */
+  double safety_height;
+
+  LandableReachTable(unsigned _serial, double _safety_height) noexcept
+    :serial(_serial), safety_height(_safety_height) {}
+
+  void Reserve(std::size_t n) noexcept {
+    items.reserve(n);
+  }
+
+  /**
+   * Add an item.  Call Sort() after the last one.
+   */
+  void Add(unsigned waypoint_id,
+           const std::optional<ReachResult> &reach) noexcept {
+    items.push_back({waypoint_id, reach});
+  }
+
+  void Sort() noexcept {
+    std::sort(items.begin(), items.end(), [](const Item &a, const Item &b){
+      return a.waypoint_id < b.waypoint_id;
+    });
+  }
+
+  std::size_t size() const noexcept {
+    return items.size();
+  }
+
+  /**
+   * Look up the item for the given waypoint.
+   *
+   * @return nullptr if the waypoint was not calculated (because it
+   * is out of range or has no elevation)
+   */
+  [[gnu::pure]]
+  const Item *Find(unsigned waypoint_id) const noexcept {
+    const auto i = std::lower_bound(items.begin(), items.end(), waypoint_id);
+    return i != items.end() && i->waypoint_id == waypoint_id
+      ? &*i
+      : nullptr;
+  }
+};
@@ -2,7 +2,11 @@
 // Copyright The XCSoar Project
 
 #include "ProtectedRoutePlanner.hpp"
+#include "LandableReach.hpp"
 #include "Engine/Route/ReachResult.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+
+#include <cassert>
 
 void
 ProtectedRoutePlanner::SetTerrain(const RasterTerrain *terrain) noexcept
@@ -57,6 +61,80 @@ ProtectedRoutePlanner::SolveReach(const AGeoPoint &origin,
   const std::scoped_lock lock{reach_mutex};
   reach_terrain = std::move(rt);
   reach_working = std::move(rw);
+  ++reach_serial;
+}
+
+void
+ProtectedRoutePlanner::UpdateLandableReach(const Waypoints &waypoints,
+                                           const GeoPoint &location,
+                                           double range,
+                                           double safety_height) noexcept
+{
+  unsigned serial;
+
+  {
+    const std::scoped_lock lock{reach_mutex};
+
+    if (reach_terrain.IsEmpty()) {
+      landable_reach.reset();
+      return;
+    }
+
+    if (landable_reach != nullptr &&
+        landable_reach->serial == reach_serial &&
+        landable_reach->safety_height == safety_height)
+      return;
+
+    serial = reach_serial;
+  }
+
+  /* the table is built without the lock, so the renderer is not
+     blocked; this is safe because this method is called by the
+     calculation thread, which is the only writer of #reach_terrain
+     and #rpolars_reach */
+  auto table = std::make_shared<LandableReachTable>(serial, safety_height);
+
+  waypoints.VisitWithinRange(location, range, [&](const WaypointPtr &wp){
+    if (!wp->IsLandable() && !wp->flags.watched)
+      return;
+
+    if (!wp->has_elevation)
+      return;
+
+    const double elevation = wp->elevation + safety_height;
+    auto reach = reach_terrain.FindPositiveArrival(AGeoPoint(wp->location,
+                                                             elevation),
+                                                   rpolars_reach);
+    if (reach)
+      reach->Subtract(elevation);
+
+    /* unreachable waypoints get an (empty) entry, too, so the
+       readers can tell them apart from waypoints which were not
+       calculated */
+    table->Add(wp->id, reach);
+  });
+
+  table->Sort();
+
+  /* the old table is released after the lock, because it is declared
+     before it */
+  std::shared_ptr<const LandableReachTable> result = std::move(table);
+  const std::scoped_lock lock{reach_mutex};
+  landable_reach.swap(result);
+}
+
+std::shared_ptr<const LandableReachTable>
+ProtectedRoutePlanner::GetLandableReach(double safety_height) const noexcept
+{
+  const std::scoped_lock lock{reach_mutex};
+
+  if (landable_reach == nullptr ||
+      landable_reach->safety_height != safety_height)
+    /* the setting has just been changed, and the calculation thread
+       has not caught up yet */
+    return nullptr;
+
+  return landable_reach;
 }
 
 const FlatProjection
@@ -73,6 +151,32 @@ ProtectedRoutePlanner::FindPositiveArrival(const AGeoPoint &dest) const noexcept
   return reach_terrain.FindPositiveArrival(dest, rpolars_reach);
 }
 
+/**
+ * One query takes roughly a quarter microsecond, while waking up a
+ * worker thread costs 10-20 microseconds; smaller chunks are not
+ * worth it.
+ */
+static constexpr std::size_t MIN_REACH_CHUNK = 64;
+
+void
+ProtectedRoutePlanner::FindPositiveArrival(std::span<const AGeoPoint> destinations,
+                                           std::span<std::optional<ReachResult>> results) const noexcept
+{
+  assert(results.size() == destinations.size());
+
+  /* ReachFan::FindPositiveArrival() is const and has no side
+     effects, so the workers can share the reach while this thread
+     holds the lock */
+  const std::scoped_lock lock{reach_mutex};
+
+  reach_pool.ForEachChunk(destinations.size(), MIN_REACH_CHUNK,
+                          [&](std::size_t begin, std::size_t end){
+                            for (std::size_t i = begin; i < end; ++i)
+                              results[i] = reach_terrain.FindPositiveArrival(destinations[i],
+                                                                             rpolars_reach);
+                          });
+}
+
 void
 ProtectedRoutePlanner::AcceptInRange(const GeoBounds &bounds,
                                      FlatTriangleFanVisitor &visitor,
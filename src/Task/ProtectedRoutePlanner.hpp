@@ -7,12 +7,18 @@
 #include "Engine/Route/ReachFan.hpp"
 #include "Engine/Route/RoutePolars.hpp"
 #include "thread/Mutex.hxx"
+#include "thread/WorkerPool.hpp"
+
+#include <memory>
+#include <span>
 
 struct GlideSettings;
 struct RoutePlannerConfig;
 class GlidePolar;
 class RasterTerrain;
 class Airspaces;
+class Waypoints;
+class LandableReachTable;
 
 /**
  * Facade to task/airspace/waypoints as used by threads,
@@ -37,11 +43,29 @@ class ProtectedRoutePlanner
   ReachFan reach_terrain;
   ReachFan reach_working;
 
+  /**
+   * Incremented each time #reach_terrain changes.
+   */
+  unsigned reach_serial = 0;
+
+  /**
+   * Arrival heights of nearby landables, calculated from
+   * #reach_terrain; nullptr if there is no terrain reach.
+   */
+  std::shared_ptr<const LandableReachTable> landable_reach;
+
+  /**
+   * Evaluates batches of FindPositiveArrival() queries.  Protected
+   * by #reach_mutex.
+   */
+  mutable WorkerPool reach_pool;
+
 public:
   ProtectedRoutePlanner(RoutePlannerGlue &route, const Airspaces &_airspaces,
                         const ProtectedAirspaceWarningManager *_warnings) noexcept
     :airspaces(_airspaces), warnings(_warnings),
-     route_planner(route) {}
+     route_planner(route),
+     reach_pool("Reach", WorkerPool::GetDefaultConcurrency(4)) {}
 
   void Reset() noexcept {
     ClearReach();
@@ -54,6 +78,8 @@ public:
     const std::scoped_lock lock{reach_mutex};
     reach_terrain.Reset();
     reach_working.Reset();
+    landable_reach.reset();
+    ++reach_serial;
   }
 
   [[gnu::pure]]
@@ -77,12 +103,47 @@ public:
   void SolveReach(const AGeoPoint &origin, const RoutePlannerConfig &config,
                   int h_ceiling, bool do_solve) noexcept;
 
+  /**
+   * Calculate the arrival heights of all landable and watched
+   * waypoints within the given range, unless the table is already
+   * up to date with the terrain reach.  To be called by
+   * #CalculationThread after SolveReach(); it reads the reach
+   * without holding #reach_mutex, which is only safe in the thread
+   * which modifies it.
+   */
+  void UpdateLandableReach(const Waypoints &waypoints,
+                           const GeoPoint &location, double range,
+                           double safety_height) noexcept;
+
+  /**
+   * Obtain the most recent table calculated by
+   * UpdateLandableReach().  It may be used without holding a lock.
+   *
+   * @param safety_height the arrival safety height the caller
+   * wants; a table calculated with a different one is not returned
+   * @return nullptr if there is no terrain reach, or if there is no
+   * table for it yet
+   */
+  [[gnu::pure]]
+  std::shared_ptr<const LandableReachTable> GetLandableReach(double safety_height) const noexcept;
+
   [[gnu::pure]]
   const FlatProjection GetTerrainReachProjection() const noexcept;
 
   [[gnu::pure]]
   std::optional<ReachResult> FindPositiveArrival(const AGeoPoint &dest) const noexcept;
 
+  /**
+   * Same as FindPositiveArrival(), but for many destinations, which
+   * are split among several threads.  The lock is held only once for
+   * the whole batch.
+   *
+   * @param results receives the result of each destination at the
+   * same index
+   */
+  void FindPositiveArrival(std::span<const AGeoPoint> destinations,
+                           std::span<std::optional<ReachResult>> results) const noexcept;
+
   void AcceptInRange(const GeoBounds &bounds,
                      FlatTriangleFanVisitor &visitor,
                      bool working) const noexcept;
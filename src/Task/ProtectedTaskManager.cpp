@@ -9,6 +9,9 @@
 #include "Engine/Task/Points/TaskWaypoint.hpp"
 #include "Engine/Route/ReachResult.hpp"
 
+#include <algorithm>
+#include <vector>
+
 ProtectedTaskManager::ProtectedTaskManager(TaskManager &_task_manager,
                                            const TaskBehaviour &tb) noexcept
   :Guard<TaskManager>(_task_manager),
@@ -150,13 +153,11 @@ ProtectedTaskManager::SetRoutePlanner(const ProtectedRoutePlanner *_route) noexc
   lease->SetIntersectionTest(&intersection_test);
 }
 
-bool
-ReachIntersectionTest::Intersects(const AGeoPoint &destination) const noexcept
+[[gnu::pure]]
+static bool
+Intersects(const std::optional<ReachResult> &result,
+           const AGeoPoint &destination) noexcept
 {
-  if (!route)
-    return false;
-
-  const auto result = route->FindPositiveArrival(destination);
   if (!result)
     return false;
 
@@ -167,6 +168,31 @@ ReachIntersectionTest::Intersects(const AGeoPoint &destination) const noexcept
      result->terrain < destination.altitude);
 }
 
+bool
+ReachIntersectionTest::Intersects(const AGeoPoint &destination) const noexcept
+{
+  if (!route)
+    return false;
+
+  return ::Intersects(route->FindPositiveArrival(destination), destination);
+}
+
+void
+ReachIntersectionTest::Intersects(std::span<const AGeoPoint> destinations,
+                                  std::span<bool> results) const noexcept
+{
+  if (!route) {
+    std::fill(results.begin(), results.end(), false);
+    return;
+  }
+
+  std::vector<std::optional<ReachResult>> reach(destinations.size());
+  route->FindPositiveArrival(destinations, reach);
+
+  for (std::size_t i = 0; i < destinations.size(); ++i)
+    results[i] = ::Intersects(reach[i], destinations[i]);
+}
+
 void
 ProtectedTaskManager::ResetTask() noexcept
 {
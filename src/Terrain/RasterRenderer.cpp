@@ -177,6 +177,8 @@ RasterRenderer::GenerateImage(bool do_shading,
                               const Angle sunazimuth,
                               bool do_contour) noexcept
 {
+  ++serial;
+
   if (image == nullptr ||
       height_matrix.GetSize().x > image->GetSize().width ||
       height_matrix.GetSize().y > image->GetSize().height) {
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Terrain/HeightMatrix.hpp"
+#include "util/Serial.hpp"
 
 #ifdef ENABLE_OPENGL
 #include "Geo/GeoBounds.hpp"
@@ -51,6 +52,12 @@ class RasterRenderer {
 #endif
 
   HeightMatrix height_matrix;
+
+  /**
+   * This serial gets incremented each time GenerateImage() produces
+   * a new image.
+   */
+  Serial serial;
   RawBitmap *image = nullptr;
 
   unsigned char *contour_column_base = nullptr;
@@ -74,6 +81,10 @@ public:
     return height_matrix.GetSize();
   }
 
+  const Serial &GetSerial() const noexcept {
+    return serial;
+  }
+
 #ifdef ENABLE_OPENGL
   void Invalidate() noexcept {
     bounds.SetInvalid();
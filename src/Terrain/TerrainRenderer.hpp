@@ -71,4 +71,12 @@ public:
   void Draw(Canvas &canvas, const WindowProjection &projection) const {
     raster_renderer.Draw(canvas, projection);
   }
+
+  /**
+   * Returns a serial which gets incremented each time Generate()
+   * renders a new image.
+   */
+  const Serial &GetImageSerial() const {
+    return raster_renderer.GetSerial();
+  }
 };
@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "MappedShapeFile.hpp"
+#include "shapelib/mapshape.h"
+#include "io/FileMapping.hpp"
+#include "system/ConvertPathName.hpp"
+#include "system/Path.hpp"
+#include "util/PackedBigEndian.hxx"
+#include "util/PackedLittleEndian.hxx"
+
+#include <zzip/zzip.h>
+
+#include <string>
+
+static constexpr std::size_t SHAPEFILE_HEADER_SIZE = 100;
+
+/**
+ * An entry in the ".shx" file.  Both values are in 16 bit words.
+ */
+struct ShxRecord {
+  PackedBE32 offset, length;
+};
+
+static_assert(sizeof(ShxRecord) == 8);
+
+/**
+ * The local file header of a ZIP entry.
+ */
+struct ZipLocalHeader {
+  PackedLE32 signature;
+  PackedLE16 version, flags, method, time, date;
+  PackedLE32 crc32, compressed_size, uncompressed_size;
+  PackedLE16 name_length, extra_length;
+};
+
+static_assert(sizeof(ZipLocalHeader) == 30);
+
+/**
+ * Look up an entry which is stored without compression and return
+ * its contents inside the mapped archive.
+ *
+ * @return an empty span if the entry does not exist or is compressed
+ */
+static std::span<const std::byte>
+FindStoredEntry(zzip_dir &dir, std::span<const std::byte> archive,
+                const char *name) noexcept
+{
+  ZZIP_STAT st;
+  zzip_off_t header_offset;
+  if (zzip_dir_stat_offset(&dir, name, &st, &header_offset, 0) != 0)
+    return {};
+
+  if (st.d_compr != 0 || st.d_csize != st.st_size || st.st_size < 0)
+    /* compressed */
+    return {};
+
+  const std::size_t size = st.st_size;
+
+  if (header_offset < 0 ||
+      std::size_t(header_offset) > archive.size() ||
+      archive.size() - header_offset < sizeof(ZipLocalHeader))
+    return {};
+
+  const auto &local = *(const ZipLocalHeader *)(archive.data() + header_offset);
+  if (local.signature != 0x04034b50)
+    return {};
+
+  const std::size_t offset = std::size_t(header_offset) + sizeof(local) +
+    local.name_length + local.extra_length;
+  if (offset > archive.size() || archive.size() - offset < size)
+    return {};
+
+  return archive.subspan(offset, size);
+}
+
+/**
+ * Map one part of the shapefile, trying the lower-case and the
+ * upper-case file name suffix (like msSHPOpen() does).
+ */
+static std::span<const std::byte>
+MapPart(zzip_dir *dir, std::span<const std::byte> archive,
+        const std::string &base, const char *suffix, const char *suffix_upper,
+        std::unique_ptr<FileMapping> &mapping) noexcept
+{
+  for (const char *s : {suffix, suffix_upper}) {
+    const std::string name = base + s;
+
+    if (dir != nullptr) {
+      if (auto data = FindStoredEntry(*dir, archive, name.c_str());
+          !data.empty())
+        return data;
+    } else {
+      try {
+        mapping = std::make_unique<FileMapping>(PathName(name.c_str()));
+        return *mapping;
+      } catch (...) {
+        /* try the next suffix */
+      }
+    }
+  }
+
+  return {};
+}
+
+/**
+ * Convert the shape type from the ".shp" header to the shapelib type.
+ * Multi-points are not supported.
+ *
+ * @return MS_SHAPE_NULL if the type is not supported
+ */
+static constexpr MS_SHAPE_TYPE
+ConvertShapeType(uint32_t shp_type) noexcept
+{
+  switch (shp_type) {
+  case SHP_POINT:
+  case SHP_POINTZ:
+  case SHP_POINTM:
+    return MS_SHAPE_POINT;
+
+  case SHP_ARC:
+  case SHP_ARCZ:
+  case SHP_ARCM:
+    return MS_SHAPE_LINE;
+
+  case SHP_POLYGON:
+  case SHP_POLYGONZ:
+  case SHP_POLYGONM:
+    return MS_SHAPE_POLYGON;
+
+  default:
+    return MS_SHAPE_NULL;
+  }
+}
+
+MappedShapeFile::MappedShapeFile(std::unique_ptr<FileMapping> &&_shp_mapping,
+                                 std::unique_ptr<FileMapping> &&_shx_mapping,
+                                 std::span<const std::byte> _shp,
+                                 std::span<const std::byte> _shx,
+                                 MS_SHAPE_TYPE _type) noexcept
+  :shp_mapping(std::move(_shp_mapping)),
+   shx_mapping(std::move(_shx_mapping)),
+   shp(_shp), shx(_shx), type(_type) {}
+
+MappedShapeFile::~MappedShapeFile() noexcept = default;
+
+std::unique_ptr<MappedShapeFile>
+MappedShapeFile::Open(zzip_dir *dir, std::span<const std::byte> archive,
+                      const char *filename) noexcept
+{
+  if (dir != nullptr && archive.empty())
+    return nullptr;
+
+  std::string base{filename};
+  if (const auto dot = base.rfind('.');
+      dot != base.npos && base.find_first_of("/\\", dot) == base.npos)
+    base.erase(dot);
+
+  std::unique_ptr<FileMapping> shp_mapping, shx_mapping;
+  const auto shp = MapPart(dir, archive, base, ".shp", ".SHP", shp_mapping);
+  if (shp.size() < SHAPEFILE_HEADER_SIZE)
+    return nullptr;
+
+  const auto shx = MapPart(dir, archive, base, ".shx", ".SHX", shx_mapping);
+  if (shx.size() < SHAPEFILE_HEADER_SIZE)
+    return nullptr;
+
+  const auto type =
+    ConvertShapeType(*(const PackedLE32 *)(shp.data() + 32));
+  if (type == MS_SHAPE_NULL)
+    return nullptr;
+
+  return std::make_unique<MappedShapeFile>(std::move(shp_mapping),
+                                           std::move(shx_mapping),
+                                           shp, shx, type);
+}
+
+std::size_t
+MappedShapeFile::size() const noexcept
+{
+  return (shx.size() - SHAPEFILE_HEADER_SIZE) / sizeof(ShxRecord);
+}
+
+std::span<const std::byte>
+MappedShapeFile::GetRecord(std::size_t i) const noexcept
+{
+  if (i >= size())
+    return {};
+
+  const auto &entry = ((const ShxRecord *)
+                       (shx.data() + SHAPEFILE_HEADER_SIZE))[i];
+
+  /* skip the 8 byte record header */
+  const std::size_t offset = std::size_t{entry.offset} * 2 + 8;
+  const std::size_t length = std::size_t{entry.length} * 2;
+  if (offset > shp.size() || shp.size() - offset < length)
+    return {};
+
+  return shp.subspan(offset, length);
+}
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "shapelib/mapserver.h"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+
+class FileMapping;
+struct zzip_dir;
+
+/**
+ * Read-only access to the ".shp" and ".shx" files of a shapefile
+ * which are mapped into memory.  This allows decoding shapes directly
+ * from the record bytes, without shapelib's #shapeObj.
+ *
+ * This is only possible for plain files and for ZIP entries which
+ * are stored without compression.
+ */
+class MappedShapeFile {
+  /**
+   * These own the mappings of plain files; they are nullptr for ZIP
+   * entries, which point into the mapped archive.
+   */
+  std::unique_ptr<FileMapping> shp_mapping, shx_mapping;
+
+  std::span<const std::byte> shp, shx;
+
+  MS_SHAPE_TYPE type;
+
+public:
+  MappedShapeFile(std::unique_ptr<FileMapping> &&_shp_mapping,
+                  std::unique_ptr<FileMapping> &&_shx_mapping,
+                  std::span<const std::byte> _shp,
+                  std::span<const std::byte> _shx,
+                  MS_SHAPE_TYPE _type) noexcept;
+
+  ~MappedShapeFile() noexcept;
+
+  MappedShapeFile(const MappedShapeFile &) = delete;
+  MappedShapeFile &operator=(const MappedShapeFile &) = delete;
+
+  /**
+   * @param dir the ZIP archive containing the shapefile or nullptr
+   * if it is a plain file
+   * @param archive the whole ZIP archive mapped into memory (empty if
+   * not available)
+   * @param filename the name of the ".shp" file
+   * @return nullptr if the file cannot be mapped or uses an
+   * unsupported shape type; the caller shall fall back to shapelib
+   */
+  static std::unique_ptr<MappedShapeFile> Open(zzip_dir *dir,
+                                               std::span<const std::byte> archive,
+                                               const char *filename) noexcept;
+
+  MS_SHAPE_TYPE GetShapeType() const noexcept {
+    return type;
+  }
+
+  std::size_t size() const noexcept;
+
+  /**
+   * Returns the contents of the specified record (without the record
+   * header), or an empty span if the file is malformed.
+   */
+  [[gnu::pure]]
+  std::span<const std::byte> GetRecord(std::size_t i) const noexcept;
+};
@@ -3,18 +3,112 @@
 
 #include "Thread.hpp"
 #include "TopographyStore.hpp"
+#include "LogFile.hpp"
+
+#include <algorithm>
+#include <thread>
+
+/**
+ * The maximum number of threads (including the #TopographyThread
+ * itself) which load topography files.  More threads don't help
+ * much, because reading from a ZIP archive is serialised.
+ */
+static constexpr unsigned MAX_THREADS = 4;
+
+class TopographyThread::Worker final : StandbyThread {
+  TopographyStore &store;
+
+  const std::function<void()> &callback;
+
+  WindowProjection projection;
+
+  unsigned num_updated;
+
+public:
+  Worker(TopographyStore &_store,
+         const std::function<void()> &_callback) noexcept
+    :StandbyThread("Topography"),
+     store(_store), callback(_callback) {}
+
+  using StandbyThread::LockStop;
+
+  /**
+   * Start working on the current pass of TopographyStore::ScanNext().
+   *
+   * Throws on error.
+   */
+  void Start(const WindowProjection &_projection) {
+    const std::lock_guard lock{mutex};
+    projection = _projection;
+    num_updated = 0;
+    Trigger();
+  }
+
+  /**
+   * Wait until the pass is finished.
+   *
+   * @return the number of files updated by this worker
+   */
+  unsigned Wait() noexcept {
+    std::unique_lock lock{mutex};
+    WaitDone(lock);
+    return num_updated;
+  }
+
+private:
+  /* virtual methods from class StandbyThread*/
+  void Tick() noexcept override {
+    SetIdlePriority();
+
+    while (!IsStopped()) {
+      {
+        const ScopeUnlock unlock(mutex);
+        if (!store.ScanNext(projection))
+          break;
+
+        if (callback)
+          callback();
+      }
+
+      ++num_updated;
+    }
+  }
+};
 
 TopographyThread::TopographyThread(TopographyStore &_store,
                                    std::function<void()> &&_callback)
   :StandbyThread("Topography"),
    store(_store),
    callback(std::move(_callback)),
-   last_bounds(GeoBounds::Invalid()) {}
+   last_bounds(GeoBounds::Invalid())
+{
+  const unsigned n_threads =
+    std::clamp(std::thread::hardware_concurrency(), 1U, MAX_THREADS);
+
+  for (unsigned i = 1; i < n_threads; ++i)
+    workers.emplace_back(std::make_unique<Worker>(store, callback));
+}
 
 TopographyThread::~TopographyThread()
 {
 }
 
+void
+TopographyThread::LockStop() noexcept
+{
+  /* cancel the current pass first, so Tick() doesn't start the
+     workers again */
+  {
+    const std::lock_guard lock{mutex};
+    StopAsync();
+  }
+
+  for (auto &worker : workers)
+    worker->LockStop();
+
+  StandbyThread::LockStop();
+}
+
 void
 TopographyThread::Trigger(const WindowProjection &_projection)
 {
@@ -42,6 +136,46 @@ TopographyThread::Trigger(const WindowProjection &_projection)
   }
 }
 
+unsigned
+TopographyThread::ScanParallel(const WindowProjection &projection) noexcept
+{
+  store.BeginScan();
+
+  /* the workers are started while the mutex is locked, after
+     IsStopped() has been checked by the caller, so LockStop() will
+     always see them running */
+  std::vector<Worker *> started;
+  for (auto &worker : workers) {
+    try {
+      worker->Start(projection);
+      started.push_back(worker.get());
+    } catch (...) {
+      /* this thread does the work alone */
+      LogError(std::current_exception());
+    }
+  }
+
+  const ScopeUnlock unlock(mutex);
+
+  unsigned num_updated = 0;
+  while (store.ScanNext(projection)) {
+    ++num_updated;
+
+    /* report progress as soon as each file has been loaded */
+    if (callback)
+      callback();
+
+    const std::lock_guard lock{mutex};
+    if (IsStopped())
+      break;
+  }
+
+  for (auto *worker : started)
+    num_updated += worker->Wait();
+
+  return num_updated;
+}
+
 void
 TopographyThread::Tick() noexcept
 {
@@ -51,9 +185,7 @@ TopographyThread::Tick() noexcept
   bool again = true;
   while (next_projection.IsValid() && again && !IsStopped()) {
     const WindowProjection projection = next_projection;
-
-    const ScopeUnlock unlock(mutex);
-    again = store.ScanVisibility(projection, 1) > 0;
+    again = ScanParallel(projection) > 0;
   }
 
   /* notify the client that we have updated the topography cache */
@@ -8,17 +8,28 @@
 #include "Geo/GeoBounds.hpp"
 
 #include <functional>
+#include <memory>
+#include <vector>
 
 class TopographyStore;
 
 /**
- * A thread that loads topography files asynchronously.
+ * A thread that loads topography files asynchronously.  On
+ * multi-core machines, it distributes the files among a few helper
+ * threads.
  */
 class TopographyThread final : private StandbyThread {
+  class Worker;
+
   TopographyStore &store;
 
   const std::function<void()> callback;
 
+  /**
+   * Helper threads which update files in parallel to this one.
+   */
+  std::vector<std::unique_ptr<Worker>> workers;
+
   WindowProjection next_projection;
 
   GeoBounds last_bounds;
@@ -28,11 +39,21 @@ public:
   TopographyThread(TopographyStore &_store, std::function<void()> &&_callback);
   ~TopographyThread();
 
-  using StandbyThread::LockStop;
+  void LockStop() noexcept;
 
   void Trigger(const WindowProjection &_projection);
 
 private:
+  /**
+   * Update all files for the given projection, distributing them
+   * among this thread and the #workers.
+   *
+   * Caller must lock the mutex.
+   *
+   * @return the number of files which were updated
+   */
+  unsigned ScanParallel(const WindowProjection &projection) noexcept;
+
   /* virtual methods from class StandbyThread*/
   void Tick() noexcept override;
 };
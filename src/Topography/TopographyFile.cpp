@@ -3,6 +3,7 @@
 
 #include "Topography/TopographyFile.hpp"
 #include "Topography/XShape.hpp"
+#include "Topography/MappedShapeFile.hpp"
 #include "Convert.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "util/ScopeExit.hxx"
@@ -12,7 +13,9 @@
 #include <algorithm>
 #include <stdexcept>
 
-TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
+TopographyFile::TopographyFile(zzip_dir *_dir,
+                               std::span<const std::byte> archive,
+                               const char *filename,
                                double _threshold,
                                double _label_threshold,
                                double _important_label_threshold,
@@ -23,6 +26,7 @@ TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
                                unsigned _pen_width)
   :dir(_dir),
    file(dir, filename),
+   mapped(MappedShapeFile::Open(dir, archive, filename)),
    label_field(_label_field),
    icon(_icon), big_icon(_big_icon), ultra_icon(_ultra_icon),
    pen_width(_pen_width),
@@ -44,6 +48,10 @@ TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
 
   center = file_bounds.GetCenter();
 
+  if (mapped != nullptr && mapped->size() != n_shapes)
+    /* inconsistent with shapelib's view; don't use the mapping */
+    mapped.reset();
+
   shapes.ResizeDiscard(n_shapes);
 
   if (dir != nullptr)
@@ -70,22 +78,47 @@ TopographyFile::ClearCache() noexcept
 }
 
 static std::unique_ptr<XShape>
-LoadShape(ShapeFile &file, GeoPoint &center, std::size_t i, int label_field)
+LoadShape(ShapeFile &file, const MappedShapeFile *mapped,
+          GeoPoint &center, std::size_t i, int label_field,
+          Mutex *archive_mutex=nullptr)
 {
+  std::unique_lock<Mutex> lock;
+  if (archive_mutex != nullptr)
+    lock = std::unique_lock{*archive_mutex};
+
+  /* the label is stored in a buffer owned by the DBF handle, which
+     is private to this file; it remains valid after unlocking */
+  const char *label = label_field >= 0
+    ? file.ReadLabel(i, label_field)
+    : nullptr;
+
+  if (mapped != nullptr) {
+    /* decode directly from the mapped record; this doesn't need the
+       archive, so it may run in parallel with other files */
+    if (lock)
+      lock.unlock();
+
+    return std::make_unique<XShape>(mapped->GetShapeType(),
+                                    mapped->GetRecord(i),
+                                    center, label);
+  }
+
   shapeObj shape;
   msInitShape(&shape);
   AtScopeExit(&shape) { msFreeShape(&shape); };
+
   file.ReadShape(shape, i);
 
-  const char *label = label_field >= 0
-    ? file.ReadLabel(i, label_field)
-    : nullptr;
+  /* the conversion doesn't need the archive either */
+  if (lock)
+    lock.unlock();
 
   return std::make_unique<XShape>(shape, center, label);
 }
 
 bool
-TopographyFile::Update(const WindowProjection &map_projection)
+TopographyFile::Update(const WindowProjection &map_projection,
+                       Mutex &archive_mutex)
 {
   if (map_projection.GetMapScale() > scale_threshold)
     /* not visible, don't update cache now */
@@ -99,9 +132,18 @@ TopographyFile::Update(const WindowProjection &map_projection)
 
   cache_bounds = screenRect.Scale(2);
 
+  Mutex *const shared_mutex = dir != nullptr ? &archive_mutex : nullptr;
+
   // Test which shapes are inside the given bounds and save the
   // status to file.status
-  switch (file.WhichShapes(dir, ConvertRect(cache_bounds))) {
+  int which_shapes;
+  if (shared_mutex != nullptr) {
+    const std::lock_guard lock{*shared_mutex};
+    which_shapes = file.WhichShapes(dir, ConvertRect(cache_bounds));
+  } else
+    which_shapes = file.WhichShapes(dir, ConvertRect(cache_bounds));
+
+  switch (which_shapes) {
   case MS_FAILURE:
     ClearCache();
     throw std::runtime_error{"Failed to update shapefile"};
@@ -144,7 +186,8 @@ TopographyFile::Update(const WindowProjection &map_projection)
         assert(&*std::next(prev) != &*it);
 
         // shape isn't cached yet -> cache the shape
-        it->shape = LoadShape(file, center, i, label_field);
+        it->shape = LoadShape(file, mapped.get(), center, i, label_field,
+                              shared_mutex);
 
         /* insert into linked list (protected) */
         {
@@ -174,7 +217,7 @@ TopographyFile::LoadAll()
     if (it->shape == nullptr) {
       assert(&*std::next(prev) != &*it);
       // shape isn't cached yet -> cache the shape
-      it->shape = LoadShape(file, center, i, label_field);
+      it->shape = LoadShape(file, mapped.get(), center, i, label_field);
       // update list pointer
       prev = list.insert_after(prev, *it);
     } else {
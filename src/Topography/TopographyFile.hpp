@@ -18,9 +18,11 @@
 
 #include <cassert>
 #include <memory>
+#include <span>
 
 class WindowProjection;
 class XShape;
+class MappedShapeFile;
 struct zzip_dir;
 
 class TopographyFile {
@@ -37,6 +39,12 @@ class TopographyFile {
 
   ShapeFile file;
 
+  /**
+   * If available, shapes are decoded from this mapping instead of
+   * being read through shapelib.
+   */
+  std::unique_ptr<MappedShapeFile> mapped;
+
   /**
    * The center of shapefileObj::bounds.
    */
@@ -123,6 +131,8 @@ public:
    *
    * Throws on error.
    *
+   * @param archive the ZIP archive #dir mapped into memory (empty if
+   * not available); uncompressed shapefiles are decoded from there
    * @param shpname The shapefile to open (*.shp)
    * @param threshold the zoom threshold for displaying this object
    * @param color The color to use for drawing, including alpha for OpenGL
@@ -134,7 +144,8 @@ public:
    * @param important_label_threshold labels below this zoom threshold will
    * be rendered in default style
    */
-  TopographyFile(zzip_dir *dir, const char *shpname,
+  TopographyFile(zzip_dir *dir, std::span<const std::byte> archive,
+                 const char *shpname,
                  double threshold, double label_threshold,
                  double important_label_threshold,
                  const BGRA8Color color,
@@ -247,9 +258,15 @@ public:
   /**
    * Throws on error.
    *
+   * This may be called for different #TopographyFile instances
+   * concurrently, but not for the same one.
+   *
+   * @param archive_mutex serialises access to the ZIP archive, which
+   * may be shared with other #TopographyFile instances (zziplib is not
+   * thread-safe); it is not used if this file is not in an archive
    * @return true if new data from the topography file has been loaded
    */
-  bool Update(const WindowProjection &map_projection);
+  bool Update(const WindowProjection &map_projection, Mutex &archive_mutex);
 
   /**
    * Throws on error.
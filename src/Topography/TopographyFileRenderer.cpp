@@ -19,7 +19,6 @@
 #ifdef ENABLE_OPENGL
 #include "ui/canvas/opengl/VertexPointer.hpp"
 #include "ui/canvas/opengl/Buffer.hpp"
-#include "ui/canvas/opengl/Dynamic.hpp"
 #include "ui/canvas/opengl/Geo.hpp"
 
 #include "ui/canvas/opengl/Program.hpp"
@@ -58,6 +57,9 @@ TopographyFileRenderer::UpdateVisibleShapes(const WindowProjection &projection)
 
   visible_serial = file.GetSerial();
   visible_bounds = projection.GetScreenBounds().Scale(1.2);
+#ifdef ENABLE_OPENGL
+  ++visible_shapes_serial;
+#endif
   visible_shapes.clear();
   visible_points.clear();
   visible_labels.clear();
@@ -126,6 +128,112 @@ TopographyFileRenderer::UpdateArrayBuffer() noexcept
   array_buffer->CommitWrite(n * sizeof(*p), p - n);
 }
 
+/**
+ * Returns the batch which shall receive the indices of a shape
+ * occupying the given vertex range, starting a new one if the range
+ * cannot be addressed with GLushort indices relative to the current
+ * batch's base.
+ */
+static auto &
+GetIndexBatch(auto &batches, std::size_t start,
+              unsigned first_vertex, unsigned n_vertices) noexcept
+{
+  if (batches.empty() ||
+      first_vertex + n_vertices - batches.back().base > 0x10000)
+    batches.push_back({first_vertex, unsigned(start), 0});
+
+  return batches.back();
+}
+
+TopographyFileRenderer::IndexBuffer &
+TopographyFileRenderer::UpdateIndexBuffer(unsigned level,
+                                          ShapeScalar min_distance) noexcept
+{
+  auto &ib = index_buffers[level];
+  if (ib.buffer == nullptr)
+    ib.buffer = std::make_unique<GLElementArrayBuffer>();
+  else if (ib.serial == visible_shapes_serial)
+    return ib;
+
+  ib.serial = visible_shapes_serial;
+  ib.line_batches.clear();
+  ib.polygon_batches.clear();
+
+  std::vector<GLushort> indices;
+
+  for (const XShape *shape : visible_shapes) {
+    if (shape->get_type() != MS_SHAPE_LINE)
+      continue;
+
+    const auto lines = shape->GetLines();
+    const unsigned n_vertices = std::accumulate(lines.begin(), lines.end(),
+                                                0U);
+    auto &batch = GetIndexBatch(ib.line_batches, indices.size(),
+                                shape->GetOffset(), n_vertices);
+    const unsigned offset = shape->GetOffset() - batch.base;
+
+    XShape::Indices thinned;
+    if (level == 0 ||
+        (thinned = shape->GetIndices(level, min_distance)).indices == nullptr) {
+      /* not thinned: connect all points of each line */
+      unsigned i = offset;
+      for (const unsigned n : lines) {
+        for (unsigned j = 1; j < n; ++j, ++i) {
+          indices.push_back(i);
+          indices.push_back(i + 1);
+        }
+
+        ++i;
+      }
+    } else {
+      const GLushort *src = thinned.indices;
+      for (const unsigned n : std::span{thinned.count, lines.size()}) {
+        for (unsigned j = 1; j < n; ++j) {
+          indices.push_back(offset + src[j - 1]);
+          indices.push_back(offset + src[j]);
+        }
+
+        src += n;
+      }
+    }
+
+    batch.count = indices.size() - batch.start;
+  }
+
+  for (const XShape *shape : visible_shapes) {
+    if (shape->get_type() != MS_SHAPE_POLYGON)
+      continue;
+
+    const auto triangles = shape->GetIndices(level, min_distance);
+    const unsigned n = *triangles.count;
+    if (n == 0)
+      continue;
+
+    const auto lines = shape->GetLines();
+    const unsigned n_vertices = std::accumulate(lines.begin(), lines.end(),
+                                                0U);
+    auto &batch = GetIndexBatch(ib.polygon_batches, indices.size(),
+                                shape->GetOffset(), n_vertices);
+    const unsigned offset = shape->GetOffset() - batch.base;
+
+    if (batch.count > 0) {
+      /* join with the previous strip with two degenerate
+         triangles */
+      const GLushort last = indices.back();
+      indices.push_back(last);
+      indices.push_back(offset + triangles.indices[0]);
+    }
+
+    for (unsigned i = 0; i < n; ++i)
+      indices.push_back(offset + triangles.indices[i]);
+
+    batch.count = indices.size() - batch.start;
+  }
+
+  ib.buffer->Load(indices.size() * sizeof(indices.front()), indices.data());
+  return ib;
+}
+
 #endif
 
 inline void
@@ -189,23 +297,40 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 #endif
 
 #ifdef ENABLE_OPENGL
+  const auto &ib = UpdateIndexBuffer(level, min_distance);
+  ib.buffer->Bind();
+
   ScopeVertexPointer vp;
+  const GLushort *const indices = nullptr;
 
-#ifdef GL_EXT_multi_draw_arrays
-  std::vector<GLsizei> polygon_counts;
-  std::vector<GLushort> polygon_indices;
-#endif
-#endif
+  for (const auto &batch : ib.polygon_batches) {
+    vp.Update(GL_FLOAT, buffer + batch.base);
+    glDrawElements(GL_TRIANGLE_STRIP, batch.count, GL_UNSIGNED_SHORT,
+                   indices + batch.start);
+  }
+
+  for (const auto &batch : ib.line_batches) {
+    vp.Update(GL_FLOAT, buffer + batch.base);
+    glDrawElements(GL_LINES, batch.count, GL_UNSIGNED_SHORT,
+                   indices + batch.start);
+  }
+
+  GLElementArrayBuffer::Unbind();
+
+  glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                     glm::value_ptr(glm::mat4(1)));
+  if (!pen.GetColor().IsOpaque())
+    glDisable(GL_BLEND);
+
+  pen.Unbind();
 
+  array_buffer->Unbind();
+#else // !ENABLE_OPENGL
   for (const XShape *shape_p : visible_shapes) {
     const XShape &shape = *shape_p;
 
     const auto lines = shape.GetLines();
-#ifdef ENABLE_OPENGL
-    const ShapePoint *points = buffer + shape.GetOffset();
-#else // !ENABLE_OPENGL
     const GeoPoint *points = shape.GetPoints();
-#endif
 
     switch (shape.get_type()) {
     case MS_SHAPE_NULL:
@@ -214,66 +339,22 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 
     case MS_SHAPE_LINE:
       {
-#ifdef ENABLE_OPENGL
-        vp.Update(GL_FLOAT, points);
-
-        XShape::Indices indices;
-        if (level == 0 ||
-            (indices = shape.GetIndices(level, min_distance)).indices == nullptr) {
-          unsigned offset = 0;
-          for (unsigned n : lines) {
-            glDrawArrays(GL_LINE_STRIP, offset, n);
-            offset += n;
-          }
-        } else {
-          for (unsigned n : std::span<const GLushort>{indices.count, lines.size()}) {
-            glDrawElements(GL_LINE_STRIP, n, GL_UNSIGNED_SHORT,
-                           indices.indices);
-            indices.indices += n;
-          }
-        }
-#else // !ENABLE_OPENGL
         for (unsigned msize : lines) {
-        shape_renderer.Begin(msize);
+          shape_renderer.Begin(msize);
 
-        const GeoPoint *end = points + msize - 1;
-        for (; points < end; ++points)
-          shape_renderer.AddPointIfDistant(projection.GeoToScreen(*points));
+          const GeoPoint *end = points + msize - 1;
+          for (; points < end; ++points)
+            shape_renderer.AddPointIfDistant(projection.GeoToScreen(*points));
 
-        // make sure we always draw the last point
-        shape_renderer.AddPoint(projection.GeoToScreen(*points));
+          // make sure we always draw the last point
+          shape_renderer.AddPoint(projection.GeoToScreen(*points));
 
-        shape_renderer.FinishPolyline(canvas);
-      }
-#endif
+          shape_renderer.FinishPolyline(canvas);
+        }
       }
       break;
 
     case MS_SHAPE_POLYGON:
-#ifdef ENABLE_OPENGL
-      {
-        const auto triangles = shape.GetIndices(level, min_distance);
-        const unsigned n = *triangles.count;
-
-#ifdef GL_EXT_multi_draw_arrays
-        const unsigned offset = shape.GetOffset();
-        if (GLExt::HaveMultiDrawElements() && offset + n < 0x10000) {
-          /* postpone, draw many polygons with a single
-             glMultiDrawElements() call */
-          polygon_counts.push_back(n);
-          const size_t size = polygon_indices.size();
-          polygon_indices.resize(size + n, offset);
-          for (unsigned i = 0; i < n; ++i)
-            polygon_indices[size + i] += triangles.indices[i];
-          break;
-        }
-#endif
-
-        vp.Update(GL_FLOAT, points);
-        glDrawElements(GL_TRIANGLE_STRIP, n, GL_UNSIGNED_SHORT,
-                       triangles.indices);
-      }
-#else // !ENABLE_OPENGL
       {
         const GeoPoint *src = &points[0];
         for (const unsigned n : lines) {
@@ -304,41 +385,10 @@ TopographyFileRenderer::Paint(Canvas &canvas,
           src += n;
         }
       }
-#endif
       break;
     }
   }
-#ifdef ENABLE_OPENGL
-
-#ifdef GL_EXT_multi_draw_arrays
-  if (!polygon_indices.empty()) {
-    assert(GLExt::HaveMultiDrawElements());
 
-    std::vector<const GLushort *> polygon_pointers;
-    unsigned i = 0;
-    for (auto count : polygon_counts) {
-      polygon_pointers.push_back(polygon_indices.data() + i);
-      i += count;
-    }
-
-    vp.Update(GL_FLOAT, buffer);
-
-    GLExt::MultiDrawElements(GL_TRIANGLE_STRIP, polygon_counts.data(),
-                             GL_UNSIGNED_SHORT,
-                             (const GLvoid **)polygon_pointers.data(),
-                             polygon_counts.size());
-  }
-#endif
-
-  glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
-                     glm::value_ptr(glm::mat4(1)));
-  if (!pen.GetColor().IsOpaque())
-    glDisable(GL_BLEND);
-
-  pen.Unbind();
-
-  array_buffer->Unbind();
-#else
   shape_renderer.Commit();
 #endif
 }
@@ -9,6 +9,8 @@
 #include "Geo/GeoBounds.hpp"
 
 #ifdef ENABLE_OPENGL
+#include "Topography/XShape.hpp"
+#include <array>
 #else
 #include "ui/canvas/Brush.hpp"
 #include "Topography/ShapeRenderer.hpp"
@@ -20,6 +22,7 @@
 class TopographyFile;
 class Canvas;
 class GLArrayBuffer;
+class GLElementArrayBuffer;
 class WindowProjection;
 class LabelBlock;
 class XShape;
@@ -57,6 +60,42 @@ class TopographyFileRenderer final
 #ifdef ENABLE_OPENGL
   std::unique_ptr<GLArrayBuffer> array_buffer;
   Serial array_buffer_serial;
+
+  /**
+   * This gets incremented each time #visible_shapes is rebuilt; it
+   * invalidates all #index_buffers.
+   */
+  Serial visible_shapes_serial;
+
+  /**
+   * A range of indices which can be drawn with one glDrawElements()
+   * call.  The indices are relative to vertex #base in #array_buffer,
+   * which keeps them within the GLushort range.
+   */
+  struct IndexBatch {
+    unsigned base;
+
+    /**
+     * The position of the first index within the element buffer
+     * and the number of indices.
+     */
+    unsigned start, count;
+  };
+
+  /**
+   * The indices of all visible shapes at one thinning level, packed
+   * into one element buffer.  Lines are stored as GL_LINES pairs,
+   * polygons as one GL_TRIANGLE_STRIP joined with degenerate
+   * triangles.
+   */
+  struct IndexBuffer {
+    std::unique_ptr<GLElementArrayBuffer> buffer;
+    Serial serial;
+
+    std::vector<IndexBatch> line_batches, polygon_batches;
+  };
+
+  std::array<IndexBuffer, XShape::THINNING_LEVELS> index_buffers;
 #endif
 
 public:
@@ -90,6 +129,9 @@ private:
 
 #ifdef ENABLE_OPENGL
   void UpdateArrayBuffer() noexcept;
+
+  IndexBuffer &UpdateIndexBuffer(unsigned level,
+                                 ShapeScalar min_distance) noexcept;
 #endif
 
   void PaintPoints(Canvas &canvas, const WindowProjection &projection) noexcept;
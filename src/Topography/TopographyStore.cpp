@@ -6,12 +6,16 @@
 #include "util/StringAPI.hxx"
 #include "util/StringCompare.hxx"
 #include "io/LineReader.hpp"
+#include "io/FileMapping.hpp"
+#include "io/FileDescriptor.hxx"
 #include "system/ConvertPathName.hpp"
 #include "system/Path.hpp"
 #include "Operation/Operation.hpp"
 #include "Compatibility/path.h"
 #include "LogFile.hpp"
 
+#include <zzip/zzip.h>
+
 #include <cstdint>
 
 #include <windef.h> // for MAX_PATH
@@ -32,6 +36,18 @@ TopographyStore::GetNextScaleThreshold(double map_scale) const noexcept
   return result;
 }
 
+static bool
+UpdateFile(TopographyFile &file, const WindowProjection &projection,
+           Mutex &archive_mutex) noexcept
+{
+  try {
+    return file.Update(projection, archive_mutex);
+  } catch (...) {
+    LogError(std::current_exception());
+    return false;
+  }
+}
+
 unsigned
 TopographyStore::ScanVisibility(const WindowProjection &m_projection,
                                 unsigned max_update) noexcept
@@ -43,14 +59,10 @@ TopographyStore::ScanVisibility(const WindowProjection &m_projection,
   // to make sure eventually everything gets refreshed
   unsigned num_updated = 0;
   for (auto &file : files) {
-    try {
-      if (file.Update(m_projection)) {
-        ++num_updated;
-        if (num_updated >= max_update)
-          break;
-      }
-    } catch (...) {
-      LogError(std::current_exception());
+    if (UpdateFile(file, m_projection, archive_mutex)) {
+      ++num_updated;
+      if (num_updated >= max_update)
+        break;
     }
   }
 
@@ -58,6 +70,34 @@ TopographyStore::ScanVisibility(const WindowProjection &m_projection,
   return num_updated;
 }
 
+void
+TopographyStore::BeginScan() noexcept
+{
+  const std::lock_guard lock{scan_mutex};
+  scan_position = files.begin();
+}
+
+bool
+TopographyStore::ScanNext(const WindowProjection &m_projection) noexcept
+{
+  while (true) {
+    TopographyFile *file;
+
+    {
+      const std::lock_guard lock{scan_mutex};
+      if (scan_position == files.end())
+        return false;
+
+      file = &*scan_position++;
+    }
+
+    if (UpdateFile(*file, m_projection, archive_mutex)) {
+      ++serial;
+      return true;
+    }
+  }
+}
+
 void
 TopographyStore::LoadAll() noexcept
 {
@@ -83,6 +123,21 @@ TopographyStore::Load(NLineReader &reader,
 
   char *shape_filename_end = shape_filename + strlen(shape_filename);
 
+#ifdef HAVE_POSIX
+  if (zdir != nullptr) {
+    try {
+      archive_mapping =
+        std::make_unique<FileMapping>(FileDescriptor{zzip_dirfd(zdir)});
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to map topography");
+    }
+  }
+#endif
+
+  const std::span<const std::byte> archive = archive_mapping
+    ? std::span<const std::byte>{*archive_mapping}
+    : std::span<const std::byte>{};
+
   // Iterate through shape files in the "topology.tpl" file until
   // end or max. file number reached
   auto i = files.before_begin();
@@ -101,7 +156,7 @@ TopographyStore::Load(NLineReader &reader,
     // Create TopographyFile instance from parsed line
     try {
       i = files.emplace_after(i,
-                              zdir, shape_filename,
+                              zdir, archive, shape_filename,
                               entry->shape_range,
                               entry->label_range,
                               entry->important_label_range,
@@ -119,4 +174,5 @@ void
 TopographyStore::Reset() noexcept
 {
   files.clear();
+  archive_mapping.reset();
 }
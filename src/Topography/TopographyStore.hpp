@@ -5,10 +5,14 @@
 
 #include "TopographyFile.hpp"
 #include "util/NonCopyable.hpp"
+#include "thread/Mutex.hxx"
 
+#include <atomic>
 #include <forward_list>
+#include <memory>
 
 class Path;
+class FileMapping;
 class WindowProjection;
 class NLineReader;
 struct zzip_dir;
@@ -17,12 +21,35 @@ struct zzip_dir;
  * Class used to manage and render vector topography layers
  */
 class TopographyStore : private NonCopyable {
+  /**
+   * The ZIP archive mapped into memory; shapefiles which are stored
+   * uncompressed are read from here.  This must be declared before
+   * #files, because they point into it.
+   */
+  std::unique_ptr<FileMapping> archive_mapping;
+
   std::forward_list<TopographyFile> files;
 
   /**
    * This number is incremented each time this object is modified.
    */
-  unsigned serial = 0;
+  std::atomic<unsigned> serial = 0;
+
+  /**
+   * Serialises access to the ZIP archive shared by the files (see
+   * TopographyFile::Update()).
+   */
+  Mutex archive_mutex;
+
+  /**
+   * Protects #scan_position.
+   */
+  Mutex scan_mutex;
+
+  /**
+   * The next file to be claimed by ScanNext().
+   */
+  std::forward_list<TopographyFile>::iterator scan_position;
 
 public:
   TopographyStore() noexcept;
@@ -33,7 +60,7 @@ public:
    * incremented each time the list of warnings is modified.
    */
   unsigned GetSerial() const noexcept {
-    return serial;
+    return serial.load(std::memory_order_relaxed);
   }
 
   auto begin() const noexcept {
@@ -58,6 +85,21 @@ public:
   unsigned ScanVisibility(const WindowProjection &m_projection,
                           unsigned max_update=1024) noexcept;
 
+  /**
+   * Start a new (parallel) pass over all files; see ScanNext().
+   */
+  void BeginScan() noexcept;
+
+  /**
+   * Claim files from the pass started by BeginScan() and update them
+   * until one was modified.  This may be called from several threads
+   * at the same time; each file is updated by only one of them.
+   *
+   * @return true if a file was updated, false if there are no more
+   * files in this pass
+   */
+  bool ScanNext(const WindowProjection &m_projection) noexcept;
+
   /**
    * Load all shapes of all files into memory.  For debugging
    * purposes.
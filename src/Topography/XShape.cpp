@@ -8,6 +8,7 @@
 #include "util/UTF8.hpp"
 #include "util/StringStrip.hxx"
 #include "util/ScopeExit.hxx"
+#include "util/PackedLittleEndian.hxx"
 
 #ifdef ENABLE_OPENGL
 #include "Projection/Projection.hpp"
@@ -19,6 +20,7 @@
 #endif
 
 #include <algorithm>
+#include <bit>
 #include <stdexcept>
 
 #include <tchar.h>
@@ -79,13 +81,12 @@ ToGeoPoint(const pointObj &src) noexcept
 
 [[gnu::pure]]
 static auto
-ImportShapePoint(const pointObj &src, [[maybe_unused]] const GeoPoint &file_center) noexcept
+ImportShapePoint(const GeoPoint &vertex, [[maybe_unused]] const GeoPoint &file_center) noexcept
 {
 #ifdef ENABLE_OPENGL
   /* OpenGL: convert GeoPoints to ShapePoints, make them relative to
      the map's boundary center */
 
-  const GeoPoint vertex = ToGeoPoint(src);
   const GeoPoint relative = vertex - file_center;
 
   return ShapePoint{
@@ -93,51 +94,198 @@ ImportShapePoint(const pointObj &src, [[maybe_unused]] const GeoPoint &file_cent
     ShapeScalar(relative.latitude.Native()),
   };
 #else
-  /* convert all points of all lines to GeoPoints */
-  return ToGeoPoint(src);
+  return vertex;
 #endif
 }
 
-XShape::XShape(const shapeObj &shape, const GeoPoint &file_center,
-               const char *_label)
-  :label(ImportLabel(_label))
+/**
+ * Adapter for XShape::ImportLines() which reads from a #shapeObj.
+ */
+struct ShapeObjLines {
+  const shapeObj &shape;
+
+  std::size_t size() const noexcept {
+    return shape.numlines;
+  }
+
+  int GetNumPoints(std::size_t l) const noexcept {
+    return shape.line[l].numpoints;
+  }
+
+  GeoPoint GetPoint(std::size_t l, std::size_t i) const noexcept {
+    return ToGeoPoint(shape.line[l].point[i]);
+  }
+};
+
+static constexpr double
+ToDouble(PackedLE64 value) noexcept
 {
-  bounds = ImportRect(shape.bounds);
-  if (!bounds.Check())
-    throw std::runtime_error{"Malformed shape bounds"};
+  return std::bit_cast<double>(uint64_t{value});
+}
 
-  type = shape.type;
+/**
+ * A vertex in a ".shp" record.
+ */
+struct ShpPoint {
+  PackedLE64 x, y;
+
+  GeoPoint ToGeoPoint() const noexcept {
+    return {
+      Angle::Degrees(ToDouble(x)),
+      Angle::Degrees(ToDouble(y)),
+    };
+  }
+};
+
+static_assert(sizeof(ShpPoint) == 16);
 
+/**
+ * The header of a "PolyLine" or "Polygon" record in a ".shp" file;
+ * it is followed by the part indices and the points.
+ */
+struct ShpPolyHeader {
+  PackedLE32 type;
+  PackedLE64 min_x, min_y, max_x, max_y;
+  PackedLE32 num_parts, num_points;
+};
+
+static_assert(sizeof(ShpPolyHeader) == 44);
+
+/**
+ * Adapter for XShape::ImportLines() which reads directly from a
+ * ".shp" record.
+ */
+struct ShpRecordLines {
+  std::span<const PackedLE32> parts;
+  const ShpPoint *points;
+  std::size_t num_points;
+
+  std::size_t size() const noexcept {
+    return parts.size();
+  }
+
+  int GetNumPoints(std::size_t l) const noexcept {
+    const std::size_t end = l + 1 < parts.size()
+      ? std::size_t{parts[l + 1]}
+      : num_points;
+    return end - parts[l];
+  }
+
+  GeoPoint GetPoint(std::size_t l, std::size_t i) const noexcept {
+    return points[parts[l] + i].ToGeoPoint();
+  }
+};
+
+template<typename L>
+void
+XShape::ImportLines(const L &src, const GeoPoint &file_center)
+{
   num_lines = 0;
 
-  const int min_points = GetMinPointsForShapeType(shape.type);
+  const int min_points = GetMinPointsForShapeType(type);
   if (min_points < 0) {
     /* not supported, leave an empty XShape object */
     return;
   }
 
-  const std::size_t input_lines = std::min((std::size_t)shape.numlines,
-                                           lines.size());
+  const std::size_t input_lines = std::min(src.size(), lines.size());
   std::size_t num_points = 0;
   for (std::size_t l = 0; l < input_lines; ++l) {
-    if (shape.line[l].numpoints < min_points)
+    if (src.GetNumPoints(l) < min_points)
       /* malformed shape */
       continue;
 
-    lines[num_lines] = std::min(shape.line[l].numpoints, 16384);
+    lines[num_lines] = std::min(src.GetNumPoints(l), 16384);
     num_points += lines[num_lines];
     ++num_lines;
   }
 
   points = std::make_unique<Point[]>(num_points);
   auto *p = points.get();
-  for (std::size_t l = 0; l < num_lines; ++l) {
-    const pointObj *src = shape.line[l].point;
-    p = std::transform(src, src + lines[l], p,
-                       [&](const auto &src){
-                         return ImportShapePoint(src, file_center);
-                       });
+  for (std::size_t l = 0, i = 0; l < num_lines; ++l, ++i) {
+    /* skip the malformed lines which were omitted above */
+    while (src.GetNumPoints(i) < min_points)
+      ++i;
+
+    for (std::size_t j = 0; j < lines[l]; ++j)
+      *p++ = ImportShapePoint(src.GetPoint(i, j), file_center);
+  }
+}
+
+XShape::XShape(const shapeObj &shape, const GeoPoint &file_center,
+               const char *_label)
+  :label(ImportLabel(_label))
+{
+  bounds = ImportRect(shape.bounds);
+  if (!bounds.Check())
+    throw std::runtime_error{"Malformed shape bounds"};
+
+  type = shape.type;
+
+  ImportLines(ShapeObjLines{shape}, file_center);
+}
+
+XShape::XShape(MS_SHAPE_TYPE _type, std::span<const std::byte> record,
+               const GeoPoint &file_center, const char *_label)
+  :label(ImportLabel(_label))
+{
+  if (record.size() < 4 || *(const PackedLE32 *)record.data() == 0)
+    /* a "null" shape (same as ShapeFile::ReadShape()) */
+    throw std::runtime_error{"Failed to read shape"};
+
+  type = _type;
+
+  if (type == MS_SHAPE_POINT) {
+    if (record.size() < 4 + sizeof(ShpPoint))
+      throw std::runtime_error{"Malformed shape"};
+
+    const auto &point = *(const ShpPoint *)(record.data() + 4);
+    const GeoPoint location = point.ToGeoPoint();
+    bounds = GeoBounds{location};
+    if (!bounds.Check())
+      throw std::runtime_error{"Malformed shape bounds"};
+
+    static constexpr PackedLE32 single_part[1]{0U};
+    ImportLines(ShpRecordLines{single_part, &point, 1}, file_center);
+    return;
   }
+
+  if (record.size() < sizeof(ShpPolyHeader))
+    throw std::runtime_error{"Malformed shape"};
+
+  const auto &header = *(const ShpPolyHeader *)record.data();
+  bounds = GeoBounds{
+    GeoPoint{Angle::Degrees(ToDouble(header.min_x)),
+             Angle::Degrees(ToDouble(header.max_y))},
+    GeoPoint{Angle::Degrees(ToDouble(header.max_x)),
+             Angle::Degrees(ToDouble(header.min_y))},
+  };
+  if (!bounds.Check())
+    throw std::runtime_error{"Malformed shape bounds"};
+
+  const std::size_t num_parts = header.num_parts;
+  const std::size_t num_points = header.num_points;
+  if (num_parts > (record.size() - sizeof(header)) / sizeof(PackedLE32) ||
+      num_points > (record.size() - sizeof(header) -
+                    num_parts * sizeof(PackedLE32)) / sizeof(ShpPoint))
+    throw std::runtime_error{"Malformed shape"};
+
+  const std::span<const PackedLE32> parts{
+    (const PackedLE32 *)(record.data() + sizeof(header)),
+    num_parts,
+  };
+
+  /* validate the part indices (like msSHPReadShape() does) */
+  for (std::size_t i = 0; i < num_parts; ++i) {
+    const std::size_t end = i + 1 < num_parts
+      ? std::size_t{parts[i + 1]}
+      : num_points;
+    if (parts[i] >= end || end > num_points)
+      throw std::runtime_error{"Malformed shape"};
+  }
+
+  const auto *points = (const ShpPoint *)(parts.data() + num_parts);
+  ImportLines(ShpRecordLines{parts, points, num_points}, file_center);
 }
 
 XShape::~XShape() noexcept = default;
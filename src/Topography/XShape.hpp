@@ -23,10 +23,14 @@ struct GeoPoint;
 
 class XShape {
   static constexpr std::size_t MAX_LINES = 32;
+
+public:
 #ifdef ENABLE_OPENGL
   static constexpr std::size_t THINNING_LEVELS = 4;
 #endif
 
+private:
+
   GeoBounds bounds;
 
   uint8_t type;
@@ -84,6 +88,17 @@ public:
   XShape(const shapeObj &shape, const GeoPoint &file_center,
          const char *label);
 
+  /**
+   * Construct from a raw ".shp" record (see #MappedShapeFile).
+   *
+   * Throws on error.
+   *
+   * @param type the shape type from the ".shp" header
+   * @param record the record contents (without the record header)
+   */
+  XShape(MS_SHAPE_TYPE type, std::span<const std::byte> record,
+         const GeoPoint &file_center, const char *label);
+
   ~XShape() noexcept;
 
   XShape(const XShape &) = delete;
@@ -132,4 +147,13 @@ public:
   const TCHAR *GetLabel() const noexcept {
     return label.c_str();
   }
+
+private:
+  /**
+   * Copy the lines from the given source (an adapter for either a
+   * #shapeObj or a raw ".shp" record) into #lines and #points.
+   * Requires #type to be initialised.
+   */
+  template<typename L>
+  void ImportLines(const L &src, const GeoPoint &file_center);
 };
@@ -10,13 +10,23 @@
 #include "net/UniqueSocketDescriptor.hxx"
 #include "util/CRC16CCITT.hpp"
 
+#ifdef __linux__
+#include "net/MsgHdr.hxx"
+#endif
+
+#include <algorithm>
+#include <array>
+
 static UniqueSocketDescriptor
-CreateBindUDP(SocketAddress address)
+CreateBindUDP(SocketAddress address, bool reuse_port)
 {
   UniqueSocketDescriptor s;
   if (!s.Create(address.GetFamily(), SOCK_DGRAM, 0))
     throw MakeSocketError("Failed to create socket");
 
+  if (reuse_port && !s.SetReusePort())
+    throw MakeSocketError("Failed to set SO_REUSEPORT");
+
   if (!s.Bind(address))
     throw MakeSocketError("Failed to connect socket");
 
@@ -25,10 +35,62 @@ CreateBindUDP(SocketAddress address)
 
 namespace SkyLinesTracking {
 
+/**
+ * The maximum number of datagrams received or sent with one system
+ * call.
+ */
+static constexpr std::size_t BATCH_SIZE = 64;
+
+static constexpr std::size_t MAX_RECEIVE_SIZE = 4096;
+
+/**
+ * Larger datagrams are not queued, but sent immediately.  This is
+ * enough for all responses generated by the cloud server.
+ */
+static constexpr std::size_t MAX_QUEUED_SIZE = 2048;
+
+struct Server::ReceiveBatch {
+  std::array<Client, BATCH_SIZE> clients;
+  std::array<std::array<std::byte, MAX_RECEIVE_SIZE>, BATCH_SIZE> buffers;
+
+#ifdef __linux__
+  std::array<struct iovec, BATCH_SIZE> iov;
+  std::array<struct mmsghdr, BATCH_SIZE> msgs;
+#endif
+};
+
+struct Server::SendQueue {
+  struct Datagram {
+    StaticSocketAddress address;
+    std::size_t size;
+    std::array<std::byte, MAX_QUEUED_SIZE> data;
+  };
+
+  std::array<Datagram, BATCH_SIZE> datagrams;
+
+#ifdef __linux__
+  std::array<struct iovec, BATCH_SIZE> iov;
+  std::array<struct mmsghdr, BATCH_SIZE> msgs;
+#endif
+
+  std::size_t n = 0;
+
+  bool empty() const noexcept {
+    return n == 0;
+  }
+
+  bool full() const noexcept {
+    return n == datagrams.size();
+  }
+};
+
 Server::Server(EventLoop &event_loop,
-               SocketAddress server_address)
+               SocketAddress server_address, bool reuse_port)
   :socket(event_loop, BIND_THIS_METHOD(OnSocketReady),
-          CreateBindUDP(server_address).Release())
+          CreateBindUDP(server_address, reuse_port).Release()),
+   flush_event(event_loop, BIND_THIS_METHOD(FlushSendQueue)),
+   receive_batch(std::make_unique<ReceiveBatch>()),
+   send_queue(std::make_unique<SendQueue>())
 {
   socket.ScheduleRead();
 }
@@ -39,11 +101,11 @@ Server::~Server()
 }
 
 void
-Server::SendBuffer(SocketAddress address,
-                   std::span<const std::byte> buffer) noexcept
+Server::SendNow(SocketAddress address,
+                std::span<const std::byte> buffer) noexcept
 {
   try {
-    ssize_t nbytes = socket.GetSocket().WriteNoWait(buffer);
+    ssize_t nbytes = socket.GetSocket().WriteNoWait(buffer, address);
     if (nbytes < 0)
       throw MakeSocketError("Failed to send");
   } catch (...) {
@@ -51,6 +113,68 @@ Server::SendBuffer(SocketAddress address,
   }
 }
 
+void
+Server::SendBuffer(SocketAddress address,
+                   std::span<const std::byte> buffer) noexcept
+{
+  if (buffer.size() > MAX_QUEUED_SIZE) {
+    SendNow(address, buffer);
+    return;
+  }
+
+  auto &queue = *send_queue;
+  if (queue.full())
+    FlushSendQueue();
+
+  auto &datagram = queue.datagrams[queue.n++];
+  datagram.address = address;
+  datagram.size = buffer.size();
+  std::copy(buffer.begin(), buffer.end(), datagram.data.begin());
+
+  flush_event.ScheduleIdle();
+}
+
+void
+Server::FlushSendQueue() noexcept
+{
+  flush_event.Cancel();
+
+  auto &queue = *send_queue;
+  if (queue.empty())
+    return;
+
+#ifdef __linux__
+  for (std::size_t i = 0; i < queue.n; ++i) {
+    auto &datagram = queue.datagrams[i];
+    queue.iov[i] = {datagram.data.data(), datagram.size};
+    queue.msgs[i].msg_hdr = MakeMsgHdr(SocketAddress{datagram.address},
+                                       {&queue.iov[i], 1}, {});
+    queue.msgs[i].msg_len = 0;
+  }
+
+  for (std::size_t i = 0; i < queue.n;) {
+    int result = sendmmsg(socket.GetSocket().Get(),
+                          &queue.msgs[i], queue.n - i, MSG_DONTWAIT);
+    if (result > 0) {
+      i += result;
+    } else {
+      /* report the failed datagram and drop it; this is UDP, and
+         the client will ask again */
+      OnSendError(queue.datagrams[i].address,
+                  std::make_exception_ptr(MakeSocketError("Failed to send")));
+      ++i;
+    }
+  }
+#else
+  for (std::size_t i = 0; i < queue.n; ++i) {
+    const auto &datagram = queue.datagrams[i];
+    SendNow(datagram.address, {datagram.data.data(), datagram.size});
+  }
+#endif
+
+  queue.n = 0;
+}
+
 void
 Server::OnPing(const Client &client, unsigned id)
 {
@@ -165,22 +289,48 @@ Server::OnDatagramReceived(Client &&client,
 void
 Server::OnSocketReady(unsigned) noexcept
 try {
-  // TODO: use recvmmsg() on Linux
+  auto &batch = *receive_batch;
+
+#ifdef __linux__
+  for (std::size_t i = 0; i < BATCH_SIZE; ++i) {
+    batch.iov[i] = {batch.buffers[i].data(), batch.buffers[i].size()};
+    batch.msgs[i].msg_hdr = MakeMsgHdr(batch.clients[i].address,
+                                       {&batch.iov[i], 1}, {});
+    batch.msgs[i].msg_len = 0;
+  }
 
-  Client client;
-  socklen_t address_size = sizeof(client.address);
-  char buffer[4096];
+  int n = recvmmsg(socket.GetSocket().Get(), batch.msgs.data(), BATCH_SIZE,
+                   MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    if (IsSocketErrorReceiveWouldBlock(GetSocketError()))
+      return;
 
-  ssize_t nbytes = recvfrom(socket.GetSocket().Get(), buffer, sizeof(buffer),
-                            MSG_DONTWAIT,
-                            client.address, &address_size);
-  if (nbytes < 0)
     throw MakeSocketError("Failed to receive");
+  }
 
-  client.address.SetSize(address_size);
-  // TODO: set client.key
+  for (int i = 0; i < n; ++i) {
+    auto &client = batch.clients[i];
+    client.address.SetSize(batch.msgs[i].msg_hdr.msg_namelen);
+    OnDatagramReceived(std::move(client), batch.buffers[i].data(),
+                       batch.msgs[i].msg_len);
+  }
+#else
+  for (std::size_t i = 0; i < BATCH_SIZE; ++i) {
+    auto &client = batch.clients[i];
+    ssize_t nbytes = socket.GetSocket().ReadNoWait(batch.buffers[i],
+                                                   client.address);
+    if (nbytes < 0) {
+      if (IsSocketErrorReceiveWouldBlock(GetSocketError()))
+        break;
+
+      throw MakeSocketError("Failed to receive");
+    }
+
+    OnDatagramReceived(std::move(client), batch.buffers[i].data(), nbytes);
+  }
+#endif
 
-  OnDatagramReceived(std::move(client), buffer, nbytes);
+  /* the responses to this batch are sent by the #flush_event */
 } catch (...) {
   socket.Close();
   OnError(std::current_exception());
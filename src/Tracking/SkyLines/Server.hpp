@@ -4,12 +4,14 @@
 #pragma once
 
 #include "event/SocketEvent.hxx"
+#include "event/DeferEvent.hxx"
 #include "net/StaticSocketAddress.hxx"
 #include "util/SpanCast.hxx"
 
 #include <chrono>
 #include <cstdint>
 #include <exception>
+#include <memory>
 #include <span>
 
 struct GeoPoint;
@@ -25,14 +27,43 @@ namespace SkyLinesTracking {
 class Server {
   SocketEvent socket;
 
+  /**
+   * Flushes the #send_queue after all pending events have been
+   * handled.
+   */
+  DeferEvent flush_event;
+
 public:
   struct Client {
     StaticSocketAddress address;
     uint64_t key;
   };
 
+private:
+  struct ReceiveBatch;
+  struct SendQueue;
+
+  /**
+   * Buffers for receiving many datagrams with one system call.
+   */
+  const std::unique_ptr<ReceiveBatch> receive_batch;
+
+  /**
+   * Datagrams submitted with SendBuffer() which are sent with one
+   * system call by FlushSendQueue().
+   */
+  const std::unique_ptr<SendQueue> send_queue;
+
 public:
-  Server(EventLoop &event_loop, SocketAddress server_address);
+  /**
+   * Throws on error.
+   *
+   * @param reuse_port set SO_REUSEPORT, allowing several instances
+   * (e.g. one per thread) to bind to the same port; the kernel
+   * distributes incoming datagrams among them
+   */
+  Server(EventLoop &event_loop, SocketAddress server_address,
+         bool reuse_port=false);
 
   ~Server();
 
@@ -50,15 +81,27 @@ public:
     return socket.GetEventLoop();
   }
 
+  /**
+   * Queue a datagram.  It will be sent after the current batch of
+   * received datagrams has been handled.
+   */
   void SendBuffer(SocketAddress address,
                   std::span<const std::byte> buffer) noexcept;
 
+  /**
+   * Send all queued datagrams now.
+   */
+  void FlushSendQueue() noexcept;
+
   template<typename P>
   void SendPacket(SocketAddress address, const P &packet) noexcept {
     SendBuffer(address, ReferenceAsBytes(packet));
   }
 
 private:
+  void SendNow(SocketAddress address,
+               std::span<const std::byte> buffer) noexcept;
+
   void OnDatagramReceived(Client &&client, void *data, size_t length);
   void OnSocketReady(unsigned events) noexcept;
 
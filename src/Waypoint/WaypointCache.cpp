@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "WaypointCache.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "io/BufferedOutputStream.hxx"
+#include "io/BufferedReader.hxx"
+#include "util/SpanCast.hxx"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <string.h>
+
+struct WaypointCacheHeader {
+  static constexpr uint32_t VERSION = 1;
+
+  uint32_t version;
+
+  /**
+   * The size of TCHAR in the build which wrote this cache.
+   */
+  uint32_t char_size;
+
+  uint32_t n_waypoints;
+};
+
+/**
+ * The fixed-size attributes of a #Waypoint.  The strings follow.
+ */
+struct WaypointCacheRecord {
+  GeoPoint location;
+  double elevation;
+  uint32_t original_id;
+  Runway runway;
+  RadioFrequency radio_frequency;
+  Waypoint::Flags flags;
+  Waypoint::Type type;
+  bool has_elevation;
+  uint8_t n_files_embed, n_files_external;
+};
+
+static void
+WriteString(BufferedOutputStream &os, tstring_view s)
+{
+  const uint32_t length = s.size();
+  os.Write(ReferenceAsBytes(length));
+  os.Write(std::as_bytes(std::span{s}));
+}
+
+static tstring
+ReadString(BufferedReader &r)
+{
+  const auto length = r.ReadFullT<uint32_t>();
+  if (length > 64 * 1024)
+    throw std::runtime_error("Malformed waypoint cache string");
+
+  tstring s(length, _T('\0'));
+  r.ReadFull(std::as_writable_bytes(std::span{s}));
+  return s;
+}
+
+/**
+ * Throws if the list is too long for the 8 bit counter in
+ * #WaypointCacheRecord; the cache is not written then, and the
+ * waypoint file will be parsed again next time.
+ */
+template<typename L>
+static uint8_t
+CountFiles(const L &list)
+{
+  const auto n = std::distance(list.begin(), list.end());
+  if (n > UINT8_MAX)
+    throw std::runtime_error("Too many files in waypoint");
+
+  return n;
+}
+
+void
+SaveWaypointCache(BufferedOutputStream &os, const Waypoints &waypoints)
+{
+  std::vector<const Waypoint *> sorted;
+  sorted.reserve(waypoints.size());
+  for (const auto &wp : waypoints)
+    sorted.push_back(wp.get());
+
+  std::sort(sorted.begin(), sorted.end(), [](const Waypoint *a, const Waypoint *b){
+    return a->id < b->id;
+  });
+
+  const WaypointCacheHeader header{
+    WaypointCacheHeader::VERSION,
+    sizeof(TCHAR),
+    static_cast<uint32_t>(sorted.size()),
+  };
+  os.Write(ReferenceAsBytes(header));
+
+  for (const Waypoint *wp : sorted) {
+    WaypointCacheRecord record;
+
+    /* zero-fill all implicit padding bytes */
+    memset(static_cast<void *>(&record), 0, sizeof(record));
+
+    record.location = wp->location;
+    record.elevation = wp->elevation;
+    record.original_id = wp->original_id;
+    record.runway = wp->runway;
+    record.radio_frequency = wp->radio_frequency;
+    record.flags = wp->flags;
+    record.type = wp->type;
+    record.has_elevation = wp->has_elevation;
+    record.n_files_embed = CountFiles(wp->files_embed);
+#ifdef HAVE_RUN_FILE
+    record.n_files_external = CountFiles(wp->files_external);
+#endif
+
+    os.Write(ReferenceAsBytes(record));
+
+    WriteString(os, wp->shortname);
+    WriteString(os, wp->name);
+    WriteString(os, wp->comment);
+    WriteString(os, wp->details);
+
+    unsigned n = record.n_files_embed;
+    for (auto i = wp->files_embed.begin(); n > 0; ++i, --n)
+      WriteString(os, *i);
+
+#ifdef HAVE_RUN_FILE
+    n = record.n_files_external;
+    for (auto i = wp->files_external.begin(); n > 0; ++i, --n)
+      WriteString(os, *i);
+#endif
+  }
+}
+
+template<typename L>
+static void
+ReadFiles(BufferedReader &r, L &list, unsigned n)
+{
+  auto i = list.before_begin();
+  for (; n > 0; --n)
+    i = list.emplace_after(i, ReadString(r));
+}
+
+void
+LoadWaypointCache(BufferedReader &r, Waypoints &waypoints,
+                  WaypointOrigin origin)
+{
+  const auto header = r.ReadFullT<WaypointCacheHeader>();
+  if (header.version != WaypointCacheHeader::VERSION ||
+      header.char_size != sizeof(TCHAR))
+    throw std::runtime_error("Unsupported waypoint cache");
+
+  for (unsigned i = 0; i < header.n_waypoints; ++i) {
+    const auto record = r.ReadFullT<WaypointCacheRecord>();
+    if (!record.location.Check() ||
+        record.type > Waypoint::Type::PGLANDING)
+      throw std::runtime_error("Malformed waypoint cache");
+
+    Waypoint wp(record.location);
+    wp.elevation = record.elevation;
+    wp.original_id = record.original_id;
+    wp.runway = record.runway;
+    wp.radio_frequency = record.radio_frequency;
+    wp.flags = record.flags;
+    wp.type = record.type;
+    wp.has_elevation = record.has_elevation;
+    wp.origin = origin;
+
+    wp.shortname = ReadString(r);
+    wp.name = ReadString(r);
+    wp.comment = ReadString(r);
+    wp.details = ReadString(r);
+
+    ReadFiles(r, wp.files_embed, record.n_files_embed);
+
+#ifdef HAVE_RUN_FILE
+    ReadFiles(r, wp.files_external, record.n_files_external);
+#else
+    for (unsigned j = record.n_files_external; j > 0; --j)
+      ReadString(r);
+#endif
+
+    waypoints.Append(std::move(wp));
+  }
+}
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Engine/Waypoint/Origin.hpp"
+
+class Waypoints;
+class BufferedOutputStream;
+class BufferedReader;
+
+/**
+ * Write all waypoints to a binary cache stream, in the order of
+ * their ids.  This allows restoring the waypoints (with the same
+ * ids) much faster than parsing the original file.
+ *
+ * Throws on error.
+ */
+void
+SaveWaypointCache(BufferedOutputStream &os, const Waypoints &waypoints);
+
+/**
+ * Read waypoints written by SaveWaypointCache() and append them to
+ * the #Waypoints container.  Optimise() must be called afterwards.
+ *
+ * Throws on error.
+ *
+ * @param origin the origin which is assigned to all waypoints
+ */
+void
+LoadWaypointCache(BufferedReader &r, Waypoints &waypoints,
+                  WaypointOrigin origin);
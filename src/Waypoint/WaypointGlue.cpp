@@ -8,117 +8,393 @@
 #include "LogFile.hpp"
 #include "Waypoint/Waypoints.hpp"
 #include "WaypointReader.hpp"
+#include "WaypointCache.hpp"
 #include "Language/Language.hpp"
 #include "LocalPath.hpp"
 #include "Operation/Operation.hpp"
 #include "system/Path.hpp"
-#include "io/MapFile.hpp"
 #include "io/ZipArchive.hpp"
+#include "io/FileCache.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "io/BufferedReader.hxx"
+#include "io/Reader.hxx"
+#include "thread/Thread.hpp"
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+#include "util/StaticString.hxx"
+
+#include <algorithm>
+#include <array>
+#include <forward_list>
+#include <vector>
 
 namespace WaypointGlue {
 
-static bool
-LoadWaypointFile(Waypoints &waypoints, Path path,
-                 WaypointFileType file_type,
-                 WaypointOrigin origin,
-                 const RasterTerrain *terrain,
-                 ProgressListener &progress) noexcept
-try {
-  ReadWaypointFile(path, file_type, waypoints,
-                   WaypointFactory(origin, terrain),
-                   progress);
-  return true;
-} catch (...) {
-  LogFormat(_T("Failed to read waypoint file: %s"), path.c_str());
-  LogError(std::current_exception());
-  return false;
-}
+/**
+ * Shared by all #WaypointFileLoader instances to wake up the thread
+ * which waits for them to finish, to forward their progress.
+ */
+struct LoaderSignal {
+  Mutex mutex;
+  Cond cond;
 
-static bool
-LoadWaypointFile(Waypoints &waypoints, Path path,
-                 WaypointOrigin origin,
-                 const RasterTerrain *terrain,
-                 ProgressListener &progress) noexcept
-try {
-  ReadWaypointFile(path, waypoints,
-                   WaypointFactory(origin, terrain),
-                   progress);
-  return true;
-} catch (...) {
-  LogFormat(_T("Failed to read waypoint file: %s"), path.c_str());
-  LogError(std::current_exception());
-  return false;
-}
+  /**
+   * Set by a loader whenever its progress changes or when it
+   * finishes.  Protected by #mutex.
+   */
+  bool modified = false;
+
+  /**
+   * Caller must lock #mutex.
+   */
+  void Notify() noexcept {
+    modified = true;
+    cond.notify_one();
+  }
+};
+
+/**
+ * Loads one waypoint file into its own #Waypoints container, either
+ * from the #FileCache or by parsing it.  Several instances run in
+ * parallel; the results are merged into the main container in the
+ * configured order, so waypoint ids do not depend on thread timing.
+ *
+ * Terrain elevation is not looked up here (the cache must not
+ * depend on the terrain file); that is done while merging.
+ */
+class WaypointFileLoader final : Thread, NullOperationEnvironment {
+  LoaderSignal &signal;
+
+  FileCache *const cache;
+
+  const AllocatedPath path;
+
+  /**
+   * The name of the file inside the ZIP archive #path, or nullptr if
+   * #path is a plain waypoint file.
+   */
+  const char *const zip_entry;
+
+  const WaypointFileType file_type;
+  const WaypointOrigin origin;
+
+  StaticString<32> cache_name;
+
+  Waypoints waypoints;
+
+  bool ok = false;
+
+  /**
+   * The parser's progress, see GetProgress().  Protected by
+   * LoaderSignal::mutex.
+   */
+  unsigned progress_range = 0, progress_position = 0;
+
+  /**
+   * Protected by LoaderSignal::mutex.
+   */
+  bool done = false;
+
+public:
+  /**
+   * The range of GetProgress().
+   */
+  static constexpr unsigned PROGRESS_RANGE = 1024;
+
+  WaypointFileLoader(LoaderSignal &_signal, FileCache *_cache,
+                     Path _path, const char *_zip_entry,
+                     WaypointFileType _file_type,
+                     WaypointOrigin _origin) noexcept
+    :Thread("WaypointLoader"),
+     signal(_signal),
+     cache(_cache), path(_path), zip_entry(_zip_entry),
+     file_type(_file_type), origin(_origin)
+  {
+    /* the cache file name is derived from the source, so each
+       configured file gets its own cache */
+    uint32_t hash = 2166136261U;
+    for (const TCHAR *p = path.c_str(); *p != 0; ++p)
+      hash = (hash ^ (uint32_t)*p) * 16777619U;
+    if (zip_entry != nullptr)
+      for (const char *p = zip_entry; *p != 0; ++p)
+        hash = (hash ^ (uint8_t)*p) * 16777619U;
+
+    cache_name.Format(_T("waypoints-%08x-%u"), hash, (unsigned)file_type);
+  }
+
+  ~WaypointFileLoader() noexcept {
+    Wait();
+  }
+
+  /**
+   * Start loading in a new thread.  If that fails, load in the
+   * calling thread.
+   */
+  void Start() noexcept {
+    try {
+      Thread::Start();
+    } catch (...) {
+      LogError(std::current_exception());
+      Run();
+    }
+  }
+
+  /**
+   * Has loading finished?  Caller must lock LoaderSignal::mutex.
+   */
+  bool IsDone() const noexcept {
+    return done;
+  }
+
+  /**
+   * Returns the progress between 0 and #PROGRESS_RANGE, based on the
+   * number of bytes parsed.  A file loaded from the cache jumps from
+   * 0 to #PROGRESS_RANGE.  Caller must lock LoaderSignal::mutex.
+   */
+  unsigned GetProgress() const noexcept {
+    if (done)
+      return PROGRESS_RANGE;
+
+    if (progress_range == 0)
+      return 0;
+
+    return std::min(progress_position, progress_range) *
+      PROGRESS_RANGE / progress_range;
+  }
+
+  void Wait() noexcept {
+    if (IsDefined())
+      Join();
+  }
+
+  /**
+   * Wait for completion and move the waypoints into the destination
+   * container.
+   *
+   * @return true if the file was loaded successfully
+   */
+  bool MergeInto(Waypoints &dest, const RasterTerrain *terrain) noexcept {
+    Wait();
 
-static bool
-LoadWaypointFile(Waypoints &waypoints, struct zzip_dir *dir, const char *path,
-                 WaypointFileType file_type,
-                 WaypointOrigin origin,
-                 const RasterTerrain *terrain,
-                 ProgressListener &progressg) noexcept
-try {
-  ReadWaypointFile(dir, path, file_type, waypoints,
-                   WaypointFactory(origin, terrain),
-                   progressg);
-  return true;
-} catch (...) {
-  LogFormat(_T("Failed to read waypoint file: %s"), path);
-  LogError(std::current_exception());
-  return false;
+    /* append in file order, so the ids are the same as if the file
+       had been parsed directly into the destination */
+    std::vector<WaypointPtr> sorted(waypoints.begin(), waypoints.end());
+    std::sort(sorted.begin(), sorted.end(),
+              [](const WaypointPtr &a, const WaypointPtr &b){
+                return a->id < b->id;
+              });
+    waypoints.Clear();
+
+    const WaypointFactory factory(origin, terrain);
+    for (auto &wp : sorted) {
+      /* we hold the only reference now; this is the same const_cast
+         hack as in Waypoints::Append() */
+      Waypoint &w = const_cast<Waypoint &>(*wp);
+      if (!w.has_elevation)
+        factory.FallbackElevation(w);
+
+      dest.Append(std::move(wp));
+    }
+
+    return ok;
+  }
+
+private:
+  bool LoadCache() noexcept {
+    if (cache == nullptr)
+      return false;
+
+    auto r = cache->Load(cache_name, path);
+    if (!r)
+      return false;
+
+    try {
+      BufferedReader br(*r);
+      LoadWaypointCache(br, waypoints, origin);
+      return true;
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to load waypoint cache");
+      waypoints.Clear();
+      return false;
+    }
+  }
+
+  void SaveCache() noexcept {
+    if (cache == nullptr)
+      return;
+
+    try {
+      auto os = cache->Save(cache_name, path);
+      BufferedOutputStream bos(*os);
+      SaveWaypointCache(bos, waypoints);
+      bos.Flush();
+      os->Commit();
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to save waypoint cache");
+    }
+  }
+
+  void Parse() {
+    OperationEnvironment &env = *this;
+    const WaypointFactory factory(origin);
+
+    if (zip_entry != nullptr) {
+      ZipArchive archive(path);
+      ReadWaypointFile(archive.get(), zip_entry, file_type, waypoints,
+                       factory, env);
+    } else if (file_type != WaypointFileType::UNKNOWN)
+      ReadWaypointFile(path, file_type, waypoints, factory, env);
+    else
+      ReadWaypointFile(path, waypoints, factory, env);
+  }
+
+  void Load() noexcept {
+    if (LoadCache()) {
+      ok = true;
+      return;
+    }
+
+    try {
+      Parse();
+      ok = true;
+    } catch (...) {
+      if (zip_entry != nullptr)
+        LogFormat("Failed to read waypoint file: %s", zip_entry);
+      else
+        LogFormat(_T("Failed to read waypoint file: %s"), path.c_str());
+      LogError(std::current_exception());
+      return;
+    }
+
+    SaveCache();
+  }
+
+  /* virtual methods from class Thread */
+  void Run() noexcept override {
+    Load();
+
+    const std::lock_guard lock{signal.mutex};
+    done = true;
+    signal.Notify();
+  }
+
+  /* virtual methods from class ProgressListener */
+  void SetProgressRange(unsigned range) noexcept override {
+    const std::lock_guard lock{signal.mutex};
+    progress_range = range;
+    progress_position = 0;
+  }
+
+  void SetProgressPosition(unsigned position) noexcept override {
+    const std::lock_guard lock{signal.mutex};
+    if (position != progress_position) {
+      progress_position = position;
+      signal.Notify();
+    }
+  }
+};
+
+/**
+ * Wait until all loaders have finished, and forward their combined
+ * progress to the #ProgressListener meanwhile.
+ */
+static void
+WaitLoaders(LoaderSignal &signal,
+            const std::forward_list<WaypointFileLoader> &loaders,
+            ProgressListener &progress) noexcept
+{
+  progress.SetProgressRange(std::distance(loaders.begin(), loaders.end()) *
+                            WaypointFileLoader::PROGRESS_RANGE);
+
+  std::unique_lock lock{signal.mutex};
+
+  while (true) {
+    signal.modified = false;
+
+    unsigned position = 0;
+    bool all_done = true;
+    for (const auto &loader : loaders) {
+      position += loader.GetProgress();
+      all_done &= loader.IsDone();
+    }
+
+    /* don't call the listener (which may redraw the screen) while
+       the loaders are blocked */
+    lock.unlock();
+    progress.SetProgressPosition(position);
+    lock.lock();
+
+    if (all_done)
+      break;
+
+    signal.cond.wait(lock, [&signal]{ return signal.modified; });
+  }
 }
 
 bool
 LoadWaypoints(Waypoints &way_points, const RasterTerrain *terrain,
-              ProgressListener &progress)
+              FileCache *cache, ProgressListener &progress)
 {
   bool found = false;
 
   // Delete old waypoints
   way_points.Clear();
 
-  // ### FIRST FILE ###
-  auto path = Profile::GetPath(ProfileKeys::WaypointFile);
-  if (path != nullptr)
-    found |= LoadWaypointFile(way_points, path, WaypointOrigin::PRIMARY,
-                              terrain, progress);
+  /* the configured files are loaded in parallel and merged in this
+     order: the first three files, the map file (only if none of
+     them was found), user.cup */
+  LoaderSignal signal;
+  std::forward_list<WaypointFileLoader> loaders;
+  auto last = loaders.before_begin();
+
+  static constexpr std::array<std::pair<std::string_view, WaypointOrigin>, 3> keys{{
+    {ProfileKeys::WaypointFile, WaypointOrigin::PRIMARY},
+    {ProfileKeys::AdditionalWaypointFile, WaypointOrigin::ADDITIONAL},
+    {ProfileKeys::WatchedWaypointFile, WaypointOrigin::WATCHED},
+  }};
+
+  for (const auto &[key, origin] : keys) {
+    auto path = Profile::GetPath(key);
+    if (path != nullptr)
+      last = loaders.emplace_after(last, signal, cache, path, nullptr,
+                                   WaypointFileType::UNKNOWN, origin);
+  }
+
+  auto &user = *loaders.emplace_after(last, signal, cache,
+                                      LocalPath(_T("user.cup")),
+                                      nullptr, WaypointFileType::SEEYOU,
+                                      WaypointOrigin::USER);
 
-  // ### SECOND FILE ###
-  path = Profile::GetPath(ProfileKeys::AdditionalWaypointFile);
-  if (path != nullptr)
-    found |= LoadWaypointFile(way_points, path, WaypointOrigin::ADDITIONAL,
-                              terrain, progress);
+  for (auto &loader : loaders)
+    loader.Start();
 
-  // ### WATCHED WAYPOINT/THIRD FILE ###
-  path = Profile::GetPath(ProfileKeys::WatchedWaypointFile);
-  if (path != nullptr)
-    found |= LoadWaypointFile(way_points, path, WaypointOrigin::WATCHED,
-                              terrain, progress);
+  WaitLoaders(signal, loaders, progress);
 
-  // ### MAP/FOURTH FILE ###
+  for (auto i = loaders.begin(); i != loaders.end() && &*i != &user; ++i)
+    found |= i->MergeInto(way_points, terrain);
 
   // If no waypoint file found yet
   if (!found) {
-    try {
-      if (auto archive = OpenMapFile()) {
-        found |= LoadWaypointFile(way_points, archive->get(), "waypoints.xcw",
-                                  WaypointFileType::WINPILOT,
-                                  WaypointOrigin::MAP,
-                                  terrain, progress);
-
-        found |= LoadWaypointFile(way_points, archive->get(), "waypoints.cup",
-                                  WaypointFileType::SEEYOU,
-                                  WaypointOrigin::MAP,
-                                  terrain, progress);
-      }
-    } catch (...) {
-      LogError(std::current_exception(),
-               "Failed to load waypoints from map file");
+    if (auto path = Profile::GetPath(ProfileKeys::MapFile);
+        path != nullptr) {
+      WaypointFileLoader xcw(signal, cache, path, "waypoints.xcw",
+                             WaypointFileType::WINPILOT,
+                             WaypointOrigin::MAP);
+      WaypointFileLoader cup(signal, cache, path, "waypoints.cup",
+                             WaypointFileType::SEEYOU,
+                             WaypointOrigin::MAP);
+      xcw.Start();
+      cup.Start();
+
+      found |= xcw.MergeInto(way_points, terrain);
+      found |= cup.MergeInto(way_points, terrain);
     }
   }
+
   //Load user.cup
-  LoadWaypointFile(way_points, LocalPath(_T("user.cup")),
-                   WaypointFileType::SEEYOU,
-                   WaypointOrigin::USER, terrain, progress);
+  user.MergeInto(way_points, terrain);
+
   // Optimise the waypoint list after attaching new waypoints
   way_points.Optimise();
 
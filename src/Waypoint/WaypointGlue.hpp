@@ -8,6 +8,7 @@
 class Waypoints;
 class RasterTerrain;
 class ProgressListener;
+class FileCache;
 struct PlacesOfInterestSettings;
 struct TeamCodeSettings;
 class DeviceBlackboard;
@@ -82,14 +83,17 @@ SaveHome(ProfileMap &profile,
          const TeamCodeSettings &team_code_settings) noexcept;
 
 /**
- * Reads the waypoints out of the two waypoint files and appends them to the
- * specified waypoint list
+ * Reads the waypoints out of the configured waypoint files and
+ * appends them to the specified waypoint list.  The files are parsed
+ * in parallel, and the parsed waypoints are kept in the cache.
  * @param way_points The waypoint list to fill
  * @param terrain RasterTerrain (for automatic waypoint height)
+ * @param cache the cache for parsed waypoint files (may be nullptr)
  */
 bool
 LoadWaypoints(Waypoints &way_points,
               const RasterTerrain *terrain,
+              FileCache *cache,
               ProgressListener &progress);
 
 /**
@@ -86,6 +86,7 @@ RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
     return;
 
   map.reset();
+  ++serial;
 
   auto archive = store.OpenArchive();
   if (!archive)
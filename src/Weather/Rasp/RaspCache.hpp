@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "util/Serial.hpp"
+
 #include <memory>
 
 #include <tchar.h>
@@ -27,6 +29,11 @@ class RaspCache {
 
   std::unique_ptr<RasterMap> map;
 
+  /**
+   * This serial gets incremented each time #map gets replaced.
+   */
+  Serial serial;
+
 public:
   RaspCache(const RaspStore &_store, unsigned _parameter) noexcept;
   ~RaspCache() noexcept;
@@ -40,6 +47,10 @@ public:
     return map.get();
   }
 
+  const Serial &GetSerial() const {
+    return serial;
+  }
+
   /**
    * Returns the current map's name.
    */
@@ -43,6 +43,14 @@ public:
     return cache.GetParameter();
   }
 
+  /**
+   * Returns a serial which gets incremented each time a new RASP
+   * map has been loaded.
+   */
+  const Serial &GetSerial() const {
+    return cache.GetSerial();
+  }
+
   /**
    * Returns the human-readable name for the current RASP map, or
    * nullptr if no RASP map is enabled.
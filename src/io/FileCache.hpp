@@ -5,12 +5,15 @@
 
 #include "system/Path.hpp"
 
+#include <cstddef>
 #include <memory>
+#include <span>
 #include <stdio.h>
 #include <tchar.h>
 
 class Reader;
 class FileOutputStream;
+class FileMapping;
 
 class FileCache {
   AllocatedPath cache_path;
@@ -32,6 +35,16 @@ public:
    */
   std::unique_ptr<Reader> Load(const TCHAR *name, Path original_path) noexcept;
 
+  /**
+   * Like Load(), but map the whole cache file into memory.  On
+   * success, @a payload_r points to the data after the cache
+   * header.
+   *
+   * Returns nullptr on error.
+   */
+  std::unique_ptr<FileMapping> Map(const TCHAR *name, Path original_path,
+                                   std::span<const std::byte> &payload_r) noexcept;
+
   /**
    * Throws on error.
    */
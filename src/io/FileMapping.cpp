@@ -85,6 +85,31 @@ FileMapping::FileMapping(Path path)
   span = {(std::byte *)data, size};
 }
 
+#ifdef HAVE_POSIX
+
+FileMapping::FileMapping(FileDescriptor fd)
+{
+  struct stat st;
+  if (fstat(fd.Get(), &st) < 0)
+    throw MakeErrno("Failed to stat file");
+
+  if (st.st_size <= 0)
+    throw std::runtime_error{"File empty"};
+
+  if (st.st_size > 1024 * 1024 * 1024)
+    throw std::runtime_error{"File too large"};
+
+  const std::size_t size = (std::size_t)st.st_size;
+
+  void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd.Get(), 0);
+  if (data == (void *)-1)
+    throw MakeErrno("Failed to map file");
+
+  span = {(std::byte *)data, size};
+}
+
+#endif /* HAVE_POSIX */
+
 FileMapping::~FileMapping() noexcept
 {
 #ifdef HAVE_POSIX
@@ -11,6 +11,7 @@
 #endif
 
 class Path;
+class FileDescriptor;
 
 /**
  * Maps a file into the address space of this process.
@@ -28,6 +29,18 @@ public:
    */
   FileMapping(Path path);
 
+#ifdef HAVE_POSIX
+  /**
+   * Map a file which is already open (e.g. a ZIP archive which is
+   * also accessed with other means).  Unlike the other constructor,
+   * this one does not ask the kernel to read ahead, because the
+   * caller is expected to access only small parts of the file.
+   *
+   * Throws on error.
+   */
+  explicit FileMapping(FileDescriptor fd);
+#endif
+
   ~FileMapping() noexcept;
 
   FileMapping(const FileMapping &) = delete;
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * A fixed-size lock-free queue which may be filled by any number of
+ * producer threads and emptied by exactly one consumer thread.  Each
+ * slot carries a sequence number which tells whether it is free,
+ * being written or ready to be consumed (the algorithm by Dmitry
+ * Vyukov).
+ *
+ * The values are constructed once and are modified in place by the
+ * callbacks passed to TryPush() and TryPop(), which avoids copying
+ * large values.
+ *
+ * @param N the number of slots; must be a power of two
+ */
+template<typename T, std::size_t N>
+class BoundedMPSCQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  Slot slots[N];
+
+  /**
+   * The position of the next slot to be claimed by a producer.
+   */
+  alignas(64) std::atomic<std::size_t> tail{0};
+
+  /**
+   * The position of the next slot to be consumed; only accessed by
+   * the consumer.
+   */
+  alignas(64) std::size_t head = 0;
+
+public:
+  BoundedMPSCQueue() noexcept {
+    for (std::size_t i = 0; i < N; ++i)
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  BoundedMPSCQueue(const BoundedMPSCQueue &) = delete;
+  BoundedMPSCQueue &operator=(const BoundedMPSCQueue &) = delete;
+
+  static constexpr std::size_t capacity() noexcept {
+    return N;
+  }
+
+  /**
+   * Claim a slot and let the callback fill it.  May be called by any
+   * thread.
+   *
+   * @param fill a callable which receives a `T &`
+   * @return false if the queue is full
+   */
+  template<typename F>
+  bool TryPush(F &&fill) noexcept {
+    std::size_t pos = tail.load(std::memory_order_relaxed);
+
+    while (true) {
+      Slot &slot = slots[pos & (N - 1)];
+      const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(sequence) -
+        static_cast<std::intptr_t>(pos);
+
+      if (diff == 0) {
+        /* the slot is free; try to claim it */
+        if (tail.compare_exchange_weak(pos, pos + 1,
+                                       std::memory_order_relaxed)) {
+          fill(slot.value);
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        /* the consumer has not yet emptied this slot */
+        return false;
+      } else {
+        /* another producer was faster */
+        pos = tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * Pass the oldest value to the callback and free its slot.  Must
+   * only be called by the consumer thread.
+   *
+   * @param consume a callable which receives a `T &`
+   * @return false if the queue is empty (or the oldest slot is still
+   * being filled by a producer)
+   */
+  template<typename F>
+  bool TryPop(F &&consume) noexcept {
+    Slot &slot = slots[head & (N - 1)];
+    const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != head + 1)
+      return false;
+
+    consume(slot.value);
+    slot.sequence.store(head + N, std::memory_order_release);
+    ++head;
+    return true;
+  }
+};
@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "thread/JobGraph.hpp"
+#include "thread/Thread.hpp"
+
+#include <cassert>
+#include <exception>
+
+class JobGraph::Job final : Thread {
+  JobGraph &graph;
+
+  const char *const name;
+
+  const Function function;
+
+  const std::vector<Id> dependencies;
+
+  std::exception_ptr error;
+
+  Timing timing;
+
+public:
+  /**
+   * Protected by JobGraph::mutex.
+   */
+  bool done = false;
+
+  Job(JobGraph &_graph, const char *_name, Function &&_function,
+      std::initializer_list<Id> _dependencies) noexcept
+    :Thread(_name), graph(_graph), name(_name),
+     function(std::move(_function)), dependencies(_dependencies) {}
+
+  ~Job() noexcept {
+    Wait();
+  }
+
+  const char *GetName() const noexcept {
+    return name;
+  }
+
+  const Timing &GetTiming() const noexcept {
+    return timing;
+  }
+
+  void Start() noexcept {
+    try {
+      Thread::Start();
+    } catch (...) {
+      /* could not launch the thread; run the job here */
+      Run();
+    }
+  }
+
+  /**
+   * Join the thread (if there is one) and rethrow the job's
+   * exception.  The job must be done already.
+   */
+  void Finish() {
+    Wait();
+
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+private:
+  void Wait() noexcept {
+    if (IsDefined())
+      Join();
+  }
+
+  /* virtual methods from class Thread */
+  void Run() noexcept override {
+    for (const Id i : dependencies)
+      graph.WaitDone(i);
+
+    timing.start = Clock::now();
+
+    try {
+      function();
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    timing.end = Clock::now();
+
+    const std::lock_guard lock{graph.mutex};
+    done = true;
+    graph.cond.notify_all();
+  }
+};
+
+JobGraph::JobGraph() noexcept = default;
+
+JobGraph::~JobGraph() noexcept
+{
+  /* destroy in reverse order, so no job is destroyed while a later
+     one may still be waiting for it */
+  while (!jobs.empty())
+    jobs.pop_back();
+}
+
+JobGraph::Id
+JobGraph::Add(const char *name, Function f,
+              std::initializer_list<Id> dependencies) noexcept
+{
+  const Id id = jobs.size();
+
+#ifndef NDEBUG
+  for (const Id i : dependencies)
+    assert(i < id);
+#endif
+
+  jobs.emplace_back(std::make_unique<Job>(*this, name, std::move(f),
+                                          dependencies));
+  return id;
+}
+
+void
+JobGraph::Start() noexcept
+{
+  /* in the order of addition, so a job run in this thread (after a
+     thread launch failure) only waits for jobs which were started
+     before */
+  for (auto &job : jobs)
+    job->Start();
+}
+
+void
+JobGraph::WaitDone(Id id) noexcept
+{
+  assert(id < jobs.size());
+
+  const Job &job = *jobs[id];
+
+  std::unique_lock lock{mutex};
+  cond.wait(lock, [&job]{ return job.done; });
+}
+
+void
+JobGraph::Wait(Id id)
+{
+  WaitDone(id);
+  jobs[id]->Finish();
+}
+
+const char *
+JobGraph::GetName(Id id) const noexcept
+{
+  assert(id < jobs.size());
+
+  return jobs[id]->GetName();
+}
+
+const JobGraph::Timing &
+JobGraph::GetTiming(Id id) const noexcept
+{
+  assert(id < jobs.size());
+
+  return jobs[id]->GetTiming();
+}
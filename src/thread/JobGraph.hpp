@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+/**
+ * Runs a set of jobs in parallel, each in its own thread.  A job may
+ * depend on jobs which were added before it; its thread waits until
+ * these have finished (successfully or not) before it calls the job
+ * function.  Because dependencies can only point backwards, the graph
+ * cannot contain cycles.
+ *
+ * This is meant for a handful of long-running jobs (e.g. loading
+ * data files), not for many small ones; see #WorkerPool for those.
+ */
+class JobGraph {
+public:
+  using Function = std::function<void()>;
+  using Id = std::size_t;
+
+  using Clock = std::chrono::steady_clock;
+
+  struct Timing {
+    /**
+     * When the job function was called, i.e. after all dependencies
+     * had finished.
+     */
+    Clock::time_point start;
+
+    /**
+     * When the job function returned.
+     */
+    Clock::time_point end;
+
+    Clock::duration GetDuration() const noexcept {
+      return end - start;
+    }
+  };
+
+private:
+  class Job;
+  std::vector<std::unique_ptr<Job>> jobs;
+
+  /**
+   * Protects Job::done.
+   */
+  mutable Mutex mutex;
+
+  /**
+   * Signalled when a job has finished.
+   */
+  Cond cond;
+
+public:
+  JobGraph() noexcept;
+
+  /**
+   * Waits for all jobs which have been started.
+   */
+  ~JobGraph() noexcept;
+
+  JobGraph(const JobGraph &) = delete;
+  JobGraph &operator=(const JobGraph &) = delete;
+
+  /**
+   * Add a job.  Must not be called after Start().
+   *
+   * @param name the job name; also used as the name of its thread,
+   * so the string must remain valid as long as this object exists
+   * @param dependencies jobs which must be finished before this one
+   * is started
+   */
+  Id Add(const char *name, Function f,
+         std::initializer_list<Id> dependencies = {}) noexcept;
+
+  /**
+   * Start all jobs.  If a thread cannot be launched, that job is run
+   * in the calling thread instead (after waiting for its
+   * dependencies).
+   */
+  void Start() noexcept;
+
+  /**
+   * Wait until the given job has finished.  Must not be called
+   * before Start().
+   *
+   * Throws the exception which was thrown by the job function.
+   */
+  void Wait(Id id);
+
+  [[gnu::pure]]
+  const char *GetName(Id id) const noexcept;
+
+  /**
+   * Only valid after Wait() has returned.
+   */
+  [[gnu::pure]]
+  const Timing &GetTiming(Id id) const noexcept;
+
+private:
+  void WaitDone(Id id) noexcept;
+};
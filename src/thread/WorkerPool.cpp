@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "thread/WorkerPool.hpp"
+#include "thread/StandbyThread.hpp"
+
+#include <algorithm>
+#include <thread>
+
+class WorkerPool::Worker final : StandbyThread {
+  const Function *function;
+  std::size_t begin, end;
+
+public:
+  explicit Worker(const char *_name) noexcept
+    :StandbyThread(_name) {}
+
+  ~Worker() noexcept {
+    LockStop();
+  }
+
+  /**
+   * Start processing the given chunk.
+   *
+   * Throws on error.
+   */
+  void Start(const Function &_function,
+             std::size_t _begin, std::size_t _end) {
+    const std::lock_guard lock{mutex};
+    function = &_function;
+    begin = _begin;
+    end = _end;
+    Trigger();
+  }
+
+  void Wait() noexcept {
+    LockWaitDone();
+  }
+
+private:
+  /* virtual methods from class StandbyThread*/
+  void Tick() noexcept override {
+    const Function &f = *function;
+    const std::size_t _begin = begin, _end = end;
+
+    const ScopeUnlock unlock(mutex);
+    f(_begin, _end);
+  }
+};
+
+WorkerPool::WorkerPool(const char *name, unsigned n_threads) noexcept
+{
+  for (unsigned i = 1; i < n_threads; ++i)
+    workers.emplace_back(std::make_unique<Worker>(name));
+}
+
+unsigned
+WorkerPool::GetDefaultConcurrency(unsigned max_threads) noexcept
+{
+  return std::clamp(std::thread::hardware_concurrency(), 1U, max_threads);
+}
+
+WorkerPool::~WorkerPool() noexcept = default;
+
+void
+WorkerPool::ForEachChunk(std::size_t size, std::size_t min_chunk,
+                         const Function &f) noexcept
+{
+  const std::size_t n_chunks =
+    std::min<std::size_t>(GetConcurrency(),
+                          size / std::max<std::size_t>(min_chunk, 1));
+  if (n_chunks < 2) {
+    if (size > 0)
+      f(0, size);
+    return;
+  }
+
+  const std::size_t chunk_size = (size + n_chunks - 1) / n_chunks;
+
+  /* the first chunk is left to the calling thread; the others are
+     started first so they run while it is busy */
+  std::size_t n_started = 0;
+  std::size_t begin = chunk_size;
+  for (; begin < size && n_started < workers.size(); begin += chunk_size) {
+    try {
+      workers[n_started]->Start(f, begin,
+                                std::min(begin + chunk_size, size));
+      ++n_started;
+    } catch (...) {
+      /* could not launch the thread; process the rest here */
+      break;
+    }
+  }
+
+  f(0, chunk_size);
+  if (begin < size)
+    f(begin, size);
+
+  for (std::size_t i = 0; i < n_started; ++i)
+    workers[i]->Wait();
+}
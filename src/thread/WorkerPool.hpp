@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * A fixed set of background threads which process a range of items
+ * in parallel chunks.  The threads are launched on demand and then
+ * wait for the next job (see #StandbyThread), so each job only costs
+ * a wakeup, not a thread creation.
+ *
+ * Each chunk is a consecutive part of the range, and the caller
+ * decides where the results go (usually into an array indexed like
+ * the input), so the result does not depend on thread timing.
+ */
+class WorkerPool {
+public:
+  /**
+   * Process the items [begin, end).
+   */
+  using Function = std::function<void(std::size_t begin, std::size_t end)>;
+
+private:
+  class Worker;
+  std::vector<std::unique_ptr<Worker>> workers;
+
+public:
+  /**
+   * @param n_threads the number of threads working on one job,
+   * including the calling thread (see GetDefaultConcurrency())
+   */
+  WorkerPool(const char *name, unsigned n_threads) noexcept;
+  ~WorkerPool() noexcept;
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  /**
+   * @return the number of CPUs, but not more than the given value
+   */
+  [[gnu::const]]
+  static unsigned GetDefaultConcurrency(unsigned max_threads) noexcept;
+
+  /**
+   * @return the number of threads working on one job, including the
+   * calling thread
+   */
+  unsigned GetConcurrency() const noexcept {
+    return workers.size() + 1;
+  }
+
+  /**
+   * Call the function for consecutive chunks which together cover
+   * the range [0, size), in parallel.  The calling thread processes
+   * the first chunk itself; this method returns after all chunks
+   * have been processed.
+   *
+   * This method must not be called by more than one thread at a
+   * time.
+   *
+   * @param min_chunk the minimum number of items per chunk; ranges
+   * smaller than twice this are processed by the calling thread
+   * alone, because waking up a thread would cost more than it saves
+   */
+  void ForEachChunk(std::size_t size, std::size_t min_chunk,
+                    const Function &f) noexcept;
+};
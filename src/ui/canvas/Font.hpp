@@ -24,7 +24,12 @@ class GLTexture;
 #include <tchar.h>
 
 #ifdef USE_FREETYPE
+#include <optional>
+#include <vector>
+
 typedef struct FT_FaceRec_ *FT_Face;
+class GlyphAtlas;
+struct GlyphQuad;
 #endif
 
 class FontDescription;
@@ -37,6 +42,12 @@ class Font {
 protected:
 #ifdef USE_FREETYPE
   FT_Face face = nullptr;
+
+  /**
+   * The glyphs which have been rendered so far.  Created on demand,
+   * freed by Destroy().
+   */
+  mutable GlyphAtlas *atlas = nullptr;
 #elif defined(ANDROID)
   TextUtil *text_util_object = nullptr;
 
@@ -113,6 +124,26 @@ public:
 
   void Render(tstring_view text, const PixelSize size,
               void *buffer) const noexcept;
+
+#if defined(USE_FREETYPE) && defined(ENABLE_OPENGL)
+  /**
+   * Lay out the text with glyphs from the #GlyphAtlas (rendering the
+   * missing ones).  Afterwards, GetGlyphAtlas() contains all glyphs
+   * referenced by the quads.
+   *
+   * @param quads a buffer which is cleared and filled by this method
+   * @return the width of the text (like TextSize()), or std::nullopt
+   * if the glyphs of this string do not fit into the atlas at the
+   * same time (the caller should then render the string with
+   * Render())
+   */
+  std::optional<unsigned> LayoutGlyphs(tstring_view text,
+                                       std::vector<GlyphQuad> &quads) const noexcept;
+
+  GlyphAtlas &GetGlyphAtlas() const noexcept {
+    return *atlas;
+  }
+#endif
 #elif defined(ANDROID)
   std::unique_ptr<GLTexture> TextTextureGL(tstring_view text) const noexcept;
 #elif defined(USE_GDI)
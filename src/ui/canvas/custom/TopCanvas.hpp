@@ -32,6 +32,10 @@
 #include "../memory/Dither.hpp"
 #endif
 
+#ifdef USE_FB
+#include "ui/dim/Rect.hpp"
+#endif
+
 #include <cstdint>
 
 #ifdef SOFTWARE_ROTATE_DISPLAY
@@ -109,6 +113,13 @@ class TopCanvas
   unsigned map_pitch, map_bpp;
 
   uint32_t epd_update_marker;
+
+  /**
+   * The part of the screen which has been modified since the last
+   * Flip() (see AddDamage()).  If this is empty, Flip() copies the
+   * whole screen.
+   */
+  PixelRect damaged{0, 0, 0, 0};
 #endif // USE_FB
 
 #ifdef KOBO
@@ -226,6 +237,16 @@ public:
   Canvas Lock();
   void Unlock() noexcept;
 
+#ifdef USE_FB
+  /**
+   * Remember that the given part of the screen has been modified.
+   * The next Flip() copies (and on e-paper: refreshes) only the
+   * union of these rectangles.  Without any AddDamage() call, it
+   * flushes the whole screen.
+   */
+  void AddDamage(PixelRect rect) noexcept;
+#endif
+
   void Flip();
 
 #ifdef KOBO
@@ -248,6 +269,14 @@ private:
   PixelSize SetupViewport(PixelSize native_size) noexcept;
 #endif
 
+#ifdef USE_FB
+  /**
+   * Return the damaged region (clipped to the screen, or the whole
+   * screen if nothing was reported) and reset it.
+   */
+  PixelRect TakeDamage() noexcept;
+#endif
+
 #ifdef USE_EGL
   void CreateSurface(EGLNativeWindowType native_window);
 #endif
@@ -225,6 +225,12 @@ TopCanvas::CheckResize(const PixelSize new_native_size) noexcept
 
   buffer.Free();
   buffer.Allocate(new_size);
+
+#ifdef USE_FB
+  /* the next Flip() must copy everything */
+  damaged = {0, 0, 0, 0};
+#endif
+
   return true;
 }
 
@@ -239,10 +245,71 @@ TopCanvas::Unlock() noexcept
 {
 }
 
+#ifdef USE_FB
+
+static constexpr bool
+IsEmpty(const PixelRect &r) noexcept
+{
+  return r.left >= r.right || r.top >= r.bottom;
+}
+
+void
+TopCanvas::AddDamage(PixelRect rect) noexcept
+{
+  if (IsEmpty(rect))
+    return;
+
+  if (IsEmpty(damaged)) {
+    damaged = rect;
+    return;
+  }
+
+  damaged.left = std::min(damaged.left, rect.left);
+  damaged.top = std::min(damaged.top, rect.top);
+  damaged.right = std::max(damaged.right, rect.right);
+  damaged.bottom = std::max(damaged.bottom, rect.bottom);
+}
+
+inline PixelRect
+TopCanvas::TakeDamage() noexcept
+{
+  const PixelRect screen{buffer.size};
+
+  PixelRect rc = damaged;
+  damaged = {0, 0, 0, 0};
+
+  rc.left = std::max(rc.left, screen.left);
+  rc.top = std::max(rc.top, screen.top);
+  rc.right = std::min(rc.right, screen.right);
+  rc.bottom = std::min(rc.bottom, screen.bottom);
+
+  if (IsEmpty(rc))
+    return screen;
+
+  return rc;
+}
+
+#endif
+
 void
 TopCanvas::Flip()
 {
 #ifdef USE_FB
+  PixelRect rc = TakeDamage();
+
+#if defined(DITHER) && !defined(KOBO)
+  if (map_bpp == 4)
+    /* CopyFromGreyscale() expands the dithered pixels in place, which
+       works only with whole rows */
+    rc = PixelRect{buffer.size};
+#endif
+
+  /* copy only the damaged region */
+  void *const dest = static_cast<uint8_t *>(map)
+    + unsigned(rc.top) * map_pitch + unsigned(rc.left) * map_bpp;
+  const decltype(buffer) src{
+    buffer.At(rc.left, rc.top), buffer.pitch, rc.GetSize(),
+  };
 
 #ifdef GREYSCALE
   CopyFromGreyscale(
@@ -252,10 +319,10 @@ TopCanvas::Flip()
 #ifdef KOBO
                     enable_dither,
 #endif
-                    map, map_pitch, map_bpp,
-                    buffer);
+                    dest, map_pitch, map_bpp,
+                    src);
 #else
-  CopyFromBGRA(map, map_pitch, map_bpp, buffer);
+  CopyFromBGRA(dest, map_pitch, map_bpp, src);
 #endif
 
 
@@ -268,7 +335,7 @@ TopCanvas::Flip()
   KoboModel kobo_model = DetectKoboModel();
   struct mxcfb_update_data epd_update_data = {
     {
-      0, 0, buffer.size.width, buffer.size.height
+      uint32_t(rc.top), uint32_t(rc.left), rc.GetWidth(), rc.GetHeight()
     },
 
     uint32_t(enable_dither &&
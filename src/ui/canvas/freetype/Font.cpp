@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "ui/canvas/Font.hpp"
+#include "GlyphAtlas.hpp"
 #include "Screen/Debug.hpp"
 #include "ui/canvas/custom/Files.hpp"
 #include "Look/FontDescription.hpp"
@@ -208,6 +209,9 @@ Font::Destroy() noexcept
 
   ::FT_Done_Face(face);
   face = nullptr;
+
+  delete atlas;
+  atlas = nullptr;
 }
 
 static void
@@ -223,10 +227,94 @@ ForEachChar(tstring_view text, std::invocable<unsigned> auto f)
   }
 }
 
+static void
+ConvertMono(unsigned char *dest, const unsigned char *src, unsigned n) noexcept
+{
+  for (; n >= 8; n -= 8, ++src) {
+    for (unsigned i = 0x80; i != 0; i >>= 1)
+      *dest++ = (*src & i) ? 0xff : 0x00;
+  }
+
+  for (unsigned i = 0x80; n > 0; i >>= 1, --n)
+    *dest++ = (*src & i) ? 0xff : 0x00;
+}
+
+static void
+ConvertMono(FT_Bitmap &dest, const FT_Bitmap &src) noexcept
+{
+  dest = src;
+  dest.pitch = dest.width;
+  dest.buffer = new unsigned char[dest.pitch * dest.rows];
+
+  unsigned char *d = dest.buffer, *s = src.buffer;
+  for (unsigned y = 0; y < unsigned(dest.rows);
+       ++y, d += dest.pitch, s += src.pitch)
+    ConvertMono(d, s, dest.width);
+}
+
+static const GlyphAtlas::Glyph &
+AddGlyph(GlyphAtlas &atlas, GlyphAtlas::Glyph glyph,
+         unsigned ch, const FT_Bitmap &bitmap) noexcept
+{
+  return atlas.Add(ch, glyph, bitmap.buffer, bitmap.pitch,
+                   bitmap.width, bitmap.rows);
+}
+
+/**
+ * Look up a glyph in the atlas; if it is not there yet, let FreeType
+ * render it and add it.
+ */
+static const GlyphAtlas::Glyph &
+GetGlyph(const FT_Face face, unsigned ascent_height, GlyphAtlas &atlas,
+         unsigned ch) noexcept
+{
+  if (const auto *glyph = atlas.Find(ch))
+    return *glyph;
+
+  const FT_UInt i = FT_Get_Char_Index(face, ch);
+  if (i == 0)
+    return atlas.AddMissing(ch);
+
+  if (FT_Load_Glyph(face, i, load_flags))
+    return atlas.AddMissing(ch);
+
+  const FT_GlyphSlot slot = face->glyph;
+  const FT_Glyph_Metrics &metrics = slot->metrics;
+
+  GlyphAtlas::Glyph glyph{};
+  glyph.index = i;
+  glyph.x = FT_FLOOR(metrics.horiBearingX);
+  glyph.y = int(ascent_height) - FT_FLOOR(metrics.horiBearingY);
+  glyph.extent = glyph.x + FT_CEIL(metrics.width);
+  glyph.advance = FT_CEIL(metrics.horiAdvance);
+
+  if (FT_Render_Glyph(slot, render_mode))
+    /* keep the metrics, draw nothing */
+    return atlas.Add(ch, glyph, nullptr, 0, 0, 0);
+
+  if (IsMono()) {
+    /* with anti-aliasing disabled, FreeType writes each pixel in one
+       bit; hack: convert it to 1 byte per pixel */
+    FT_Bitmap bitmap;
+    ConvertMono(bitmap, slot->bitmap);
+    const auto &result = AddGlyph(atlas, glyph, ch, bitmap);
+    delete[] bitmap.buffer;
+    return result;
+  } else
+    return AddGlyph(atlas, glyph, ch, slot->bitmap);
+}
+
+/**
+ * Invoke the callback for each glyph of the string which the font
+ * has, with the pen position.  The #GlyphAtlas is created on demand
+ * and may be cleared (and thus invalidate earlier glyphs) while
+ * iterating.
+ */
 template<typename T>
 static void
-ForEachGlyph(const FT_Face face, unsigned ascent_height, T &&text,
-             std::invocable<int, int, FT_GlyphSlot> auto f) noexcept
+ForEachGlyph(const FT_Face face, unsigned ascent_height,
+             GlyphAtlas *&atlas, T &&text,
+             std::invocable<int, const GlyphAtlas::Glyph &> auto f) noexcept
 {
   const bool use_kerning = FT_HAS_KERNING(face);
 
@@ -237,36 +325,30 @@ ForEachGlyph(const FT_Face face, unsigned ascent_height, T &&text,
   const std::lock_guard lock{freetype_mutex};
 #endif
 
+  if (atlas == nullptr)
+    atlas = new GlyphAtlas();
+
   ForEachChar(std::forward<T>(text),
-              [face, ascent_height, &f, use_kerning,
+              [face, ascent_height, &atlas = *atlas, &f, use_kerning,
                &x, &prev_index](unsigned ch){
-      const FT_UInt i = FT_Get_Char_Index(face, ch);
-      if (i == 0)
+      const auto &glyph = GetGlyph(face, ascent_height, atlas, ch);
+      if (glyph.index == 0)
         return;
 
-      const FT_Error error = FT_Load_Glyph(face, i, load_flags);
-      if (error)
-        return;
-
-      const FT_GlyphSlot glyph = face->glyph;
-      const FT_Glyph_Metrics &metrics = glyph->metrics;
-
       if (use_kerning) {
-        if (prev_index != 0 && i != 0) {
+        if (prev_index != 0) {
           FT_Vector delta;
-          FT_Get_Kerning(face, prev_index, i, ft_kerning_default,
+          FT_Get_Kerning(face, prev_index, glyph.index, ft_kerning_default,
                          &delta);
           x += delta.x >> 6;
         }
 
-        prev_index = i;
+        prev_index = glyph.index;
       }
 
-      f(x + FT_FLOOR(metrics.horiBearingX),
-        ascent_height - FT_FLOOR(metrics.horiBearingY),
-        glyph);
+      f(x, glyph);
 
-      x += FT_CEIL(metrics.horiAdvance);
+      x += glyph.advance;
     });
 }
 
@@ -275,20 +357,58 @@ Font::TextSize(tstring_view text) const noexcept
 {
   int maxx = 0;
 
-  ForEachGlyph(face, ascent_height, text,
-               [&maxx](int x, [[maybe_unused]] int y, const FT_GlyphSlot glyph){
-      const FT_Glyph_Metrics &metrics = glyph->metrics;
-      const int glyph_minx = FT_FLOOR(metrics.horiBearingX);
-      const int glyph_maxx = glyph_minx + FT_CEIL(metrics.width);
-
-      int z = x + glyph_maxx;
-      if (z > maxx)
-        maxx = z;
+  ForEachGlyph(face, ascent_height, atlas, text,
+               [&maxx](int x, const GlyphAtlas::Glyph &glyph){
+      maxx = std::max(maxx, x + glyph.extent);
     });
 
   return PixelSize{unsigned(maxx), height};
 }
 
+#ifdef ENABLE_OPENGL
+
+std::optional<unsigned>
+Font::LayoutGlyphs(tstring_view text,
+                   std::vector<GlyphQuad> &quads) const noexcept
+{
+  /* if the atlas overflows while laying out, it gets cleared and the
+     glyphs added before are gone; start over once with an empty
+     atlas */
+  for (unsigned attempt = 0; attempt < 2; ++attempt) {
+    if (attempt > 0)
+      atlas->Clear();
+
+    const unsigned generation = atlas != nullptr
+      ? atlas->GetGeneration()
+      : 0;
+
+    quads.clear();
+    int maxx = 0;
+
+    ForEachGlyph(face, ascent_height, atlas, text,
+                 [&maxx, &quads](int x, const GlyphAtlas::Glyph &glyph){
+        maxx = std::max(maxx, x + glyph.extent);
+
+        if (glyph.width > 0)
+          quads.push_back({
+              x + glyph.x, glyph.y,
+              glyph.width, glyph.height,
+              glyph.atlas_x, glyph.atlas_y,
+            });
+      });
+
+    if (atlas->GetGeneration() == generation)
+      return maxx;
+  }
+
+  /* the empty atlas overflowed again: this string has more (or
+     larger) glyphs than the atlas can hold */
+  quads.clear();
+  return std::nullopt;
+}
+
+#endif
+
 static void
 MixLine(uint8_t *dest, const uint8_t *src, size_t n) noexcept
 {
@@ -299,12 +419,9 @@ MixLine(uint8_t *dest, const uint8_t *src, size_t n) noexcept
 
 static void
 RenderGlyph(uint8_t *buffer, unsigned buffer_width, unsigned buffer_height,
-            const FT_Bitmap &bitmap, int x, int y) noexcept
+            const uint8_t *src, std::ptrdiff_t pitch,
+            int width, int height, int x, int y) noexcept
 {
-  const uint8_t *src = (const uint8_t *)bitmap.buffer;
-  int width = bitmap.width, height = bitmap.rows;
-  int pitch = bitmap.pitch;
-
   if (x < 0) {
     src -= x;
     width += x;
@@ -335,50 +452,6 @@ RenderGlyph(uint8_t *buffer, unsigned buffer_width, unsigned buffer_height,
     MixLine(buffer, src, width);
 }
 
-static void
-ConvertMono(unsigned char *dest, const unsigned char *src, unsigned n) noexcept
-{
-  for (; n >= 8; n -= 8, ++src) {
-    for (unsigned i = 0x80; i != 0; i >>= 1)
-      *dest++ = (*src & i) ? 0xff : 0x00;
-  }
-
-  for (unsigned i = 0x80; n > 0; i >>= 1, --n)
-    *dest++ = (*src & i) ? 0xff : 0x00;
-}
-
-static void
-ConvertMono(FT_Bitmap &dest, const FT_Bitmap &src) noexcept
-{
-  dest = src;
-  dest.pitch = dest.width;
-  dest.buffer = new unsigned char[dest.pitch * dest.rows];
-
-  unsigned char *d = dest.buffer, *s = src.buffer;
-  for (unsigned y = 0; y < unsigned(dest.rows);
-       ++y, d += dest.pitch, s += src.pitch)
-    ConvertMono(d, s, dest.width);
-}
-
-static void
-RenderGlyph(uint8_t *buffer, size_t width, size_t height,
-            FT_GlyphSlot glyph, int x, int y) noexcept
-{
-  FT_Error error = FT_Render_Glyph(glyph, render_mode);
-  if (error)
-    return;
-
-  if (IsMono()) {
-    /* with anti-aliasing disabled, FreeType writes each pixel in one
-       bit; hack: convert it to 1 byte per pixel and then render it */
-    FT_Bitmap bitmap;
-    ConvertMono(bitmap, glyph->bitmap);
-    RenderGlyph(buffer, width, height, bitmap, x, y);
-    delete[] bitmap.buffer;
-  } else
-    RenderGlyph(buffer, width, height, glyph->bitmap, x, y);
-}
-
 void
 Font::Render(tstring_view text, const PixelSize size,
              void *_buffer) const noexcept
@@ -386,9 +459,12 @@ Font::Render(tstring_view text, const PixelSize size,
   uint8_t *buffer = (uint8_t *)_buffer;
   std::fill_n(buffer, BufferSize(size), 0);
 
-  ForEachGlyph(face, ascent_height, text,
-               [size, buffer](int x, int y, const FT_GlyphSlot glyph){
-      RenderGlyph(buffer, size.width, size.height, glyph,
-                  x, y);
+  ForEachGlyph(face, ascent_height, atlas, text,
+               [this, size, buffer](int x, const GlyphAtlas::Glyph &glyph){
+      if (glyph.width > 0)
+        RenderGlyph(buffer, size.width, size.height,
+                    atlas->GetPixels(glyph), GlyphAtlas::WIDTH,
+                    glyph.width, glyph.height,
+                    x + glyph.x, glyph.y);
     });
 }
@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "GlyphAtlas.hpp"
+
+#ifdef ENABLE_OPENGL
+#include "ui/canvas/opengl/Texture.hpp"
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+GlyphAtlas::GlyphAtlas() noexcept
+{
+  std::fill_n(ascii, std::size(ascii), NO_GLYPH);
+}
+
+GlyphAtlas::~GlyphAtlas() noexcept = default;
+
+const GlyphAtlas::Glyph *
+GlyphAtlas::Find(unsigned ch) const noexcept
+{
+  unsigned i;
+  if (ch < std::size(ascii)) {
+    i = ascii[ch];
+    if (i == NO_GLYPH)
+      return nullptr;
+  } else {
+    auto j = others.find(ch);
+    if (j == others.end())
+      return nullptr;
+
+    i = j->second;
+  }
+
+  return &glyphs[i];
+}
+
+inline const GlyphAtlas::Glyph &
+GlyphAtlas::Insert(unsigned ch, const Glyph &glyph) noexcept
+{
+  const unsigned i = glyphs.size();
+  glyphs.push_back(glyph);
+
+  if (ch < std::size(ascii))
+    ascii[ch] = i;
+  else
+    others.emplace(ch, i);
+
+  return glyphs.back();
+}
+
+const GlyphAtlas::Glyph &
+GlyphAtlas::AddMissing(unsigned ch) noexcept
+{
+  return Insert(ch, Glyph{});
+}
+
+bool
+GlyphAtlas::Allocate(unsigned width, unsigned _height,
+                     unsigned &x_r, unsigned &y_r) noexcept
+{
+  const unsigned padded_width = width + PADDING;
+  const unsigned padded_height = _height + PADDING;
+
+  if (padded_width > WIDTH)
+    return false;
+
+  if (shelf_x + padded_width > WIDTH) {
+    /* start a new shelf */
+    shelf_y += shelf_height;
+    shelf_x = 0;
+    shelf_height = 0;
+  }
+
+  if (shelf_y + padded_height > height) {
+    unsigned new_height = std::max(height, MIN_HEIGHT);
+    while (shelf_y + padded_height > new_height)
+      new_height *= 2;
+
+    if (new_height > MAX_HEIGHT)
+      return false;
+
+    std::unique_ptr<uint8_t[]> new_pixels{new uint8_t[WIDTH * new_height]};
+    if (height > 0)
+      std::copy_n(pixels.get(), WIDTH * height, new_pixels.get());
+    std::fill_n(new_pixels.get() + WIDTH * height,
+                WIDTH * (new_height - height), 0);
+
+    pixels = std::move(new_pixels);
+    height = new_height;
+
+#ifdef ENABLE_OPENGL
+    /* the texture needs to be recreated */
+    texture.reset();
+#endif
+  }
+
+  x_r = shelf_x;
+  y_r = shelf_y;
+
+  shelf_x += padded_width;
+  shelf_height = std::max(shelf_height, padded_height);
+  return true;
+}
+
+const GlyphAtlas::Glyph &
+GlyphAtlas::Add(unsigned ch, Glyph glyph,
+                const uint8_t *src, std::ptrdiff_t pitch,
+                unsigned width, unsigned _height) noexcept
+{
+  assert(Find(ch) == nullptr);
+
+  const bool empty = width == 0 || _height == 0;
+
+  unsigned x, y;
+  bool allocated = !empty && Allocate(width, _height, x, y);
+  if (!allocated && !empty) {
+    /* the atlas is full: start over */
+    Clear();
+    allocated = Allocate(width, _height, x, y);
+  }
+
+  if (!allocated) {
+    /* empty (e.g. space) or too large for the atlas: keep only the
+       metrics */
+    glyph.width = glyph.height = 0;
+    glyph.atlas_x = glyph.atlas_y = 0;
+    return Insert(ch, glyph);
+  }
+
+  glyph.width = width;
+  glyph.height = _height;
+  glyph.atlas_x = x;
+  glyph.atlas_y = y;
+
+  uint8_t *dest = pixels.get() + y * WIDTH + x;
+  for (unsigned row = 0; row < _height; ++row, src += pitch, dest += WIDTH)
+    std::copy_n(src, width, dest);
+
+#ifdef ENABLE_OPENGL
+  if (dirty_top == dirty_bottom) {
+    dirty_top = y;
+    dirty_bottom = y + _height;
+  } else {
+    dirty_top = std::min(dirty_top, y);
+    dirty_bottom = std::max(dirty_bottom, y + _height);
+  }
+#endif
+
+  return Insert(ch, glyph);
+}
+
+void
+GlyphAtlas::Clear() noexcept
+{
+  ++generation;
+
+  glyphs.clear();
+  std::fill_n(ascii, std::size(ascii), NO_GLYPH);
+  others.clear();
+
+  /* keep the bitmap, it will be overwritten */
+  if (height > 0)
+    std::fill_n(pixels.get(), WIDTH * height, 0);
+
+  shelf_x = shelf_y = shelf_height = 0;
+
+#ifdef ENABLE_OPENGL
+  dirty_top = dirty_bottom = 0;
+  texture.reset();
+#endif
+}
+
+#ifdef ENABLE_OPENGL
+
+GLTexture &
+GlyphAtlas::GetTexture() noexcept
+{
+  assert(height > 0);
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+  if (texture == nullptr) {
+    texture = std::make_unique<GLTexture>(GL_ALPHA, PixelSize{WIDTH, height},
+                                          GL_ALPHA, GL_UNSIGNED_BYTE,
+                                          pixels.get());
+  } else {
+    texture->Bind();
+
+    if (dirty_top < dirty_bottom)
+      glTexSubImage2D(GL_TEXTURE_2D, 0, 0, dirty_top,
+                      WIDTH, dirty_bottom - dirty_top,
+                      GL_ALPHA, GL_UNSIGNED_BYTE,
+                      pixels.get() + dirty_top * WIDTH);
+  }
+
+  dirty_top = dirty_bottom = 0;
+  return *texture;
+}
+
+#endif
@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#ifdef ENABLE_OPENGL
+class GLTexture;
+#endif
+
+/**
+ * One glyph of a string laid out by Font::LayoutGlyphs().
+ */
+struct GlyphQuad {
+  /**
+   * The position of the glyph bitmap relative to the top left corner
+   * of the string.
+   */
+  int x, y;
+
+  unsigned width, height;
+
+  /**
+   * The position of the glyph bitmap in the #GlyphAtlas.
+   */
+  unsigned atlas_x, atlas_y;
+};
+
+/**
+ * The rendered glyphs of one #Font, packed into one 8 bit alpha
+ * bitmap.  Strings are composed from these glyphs, which means
+ * FreeType rasterises each glyph only once.
+ *
+ * This class is not thread-safe; the caller must protect it (see
+ * freetype_mutex in Font.cpp).
+ */
+class GlyphAtlas {
+public:
+  struct Glyph {
+    /**
+     * The FreeType glyph index (for kerning); 0 if the font has no
+     * glyph for this character.
+     */
+    unsigned index;
+
+    /**
+     * The position of the bitmap relative to the pen position and
+     * the top of the line.
+     */
+    int x, y;
+
+    unsigned width, height;
+
+    /**
+     * The position of the bitmap in the atlas.
+     */
+    unsigned atlas_x, atlas_y;
+
+    /**
+     * The right edge of the glyph (relative to the pen position) as
+     * used by Font::TextSize().
+     */
+    int extent;
+
+    int advance;
+  };
+
+  /**
+   * The width of the atlas bitmap.  It grows downwards, up to
+   * #MAX_HEIGHT rows.
+   */
+  static constexpr unsigned WIDTH = 512;
+  static constexpr unsigned MAX_HEIGHT = 1024;
+
+private:
+  static constexpr unsigned MIN_HEIGHT = 64;
+
+  /**
+   * Empty space around each glyph, to avoid sampling neighbouring
+   * glyphs with GL_LINEAR.
+   */
+  static constexpr unsigned PADDING = 1;
+
+  static constexpr unsigned NO_GLYPH = ~0U;
+
+  std::vector<Glyph> glyphs;
+
+  /**
+   * Indices into #glyphs for ASCII characters (fast path), or
+   * #NO_GLYPH.
+   */
+  unsigned ascii[128];
+
+  /**
+   * Indices into #glyphs for all other characters.
+   */
+  std::unordered_map<unsigned, unsigned> others;
+
+  std::unique_ptr<uint8_t[]> pixels;
+  unsigned height = 0;
+
+  /**
+   * The "shelf" (row of glyphs) new glyphs are added to.
+   */
+  unsigned shelf_x = 0, shelf_y = 0, shelf_height = 0;
+
+  /**
+   * Incremented by Clear(), which invalidates all #Glyph positions.
+   */
+  unsigned generation = 0;
+
+#ifdef ENABLE_OPENGL
+  std::unique_ptr<GLTexture> texture;
+
+  /**
+   * The range of rows which have been modified since the last
+   * upload to #texture.
+   */
+  unsigned dirty_top = 0, dirty_bottom = 0;
+#endif
+
+public:
+  GlyphAtlas() noexcept;
+  ~GlyphAtlas() noexcept;
+
+  GlyphAtlas(const GlyphAtlas &) = delete;
+  GlyphAtlas &operator=(const GlyphAtlas &) = delete;
+
+  unsigned GetGeneration() const noexcept {
+    return generation;
+  }
+
+  [[gnu::pure]]
+  const Glyph *Find(unsigned ch) const noexcept;
+
+  /**
+   * Add a glyph which the font does not have; only the lookup is
+   * cached.
+   */
+  const Glyph &AddMissing(unsigned ch) noexcept;
+
+  /**
+   * Copy a rendered glyph into the atlas.  If the atlas is full, it
+   * is cleared first (invalidating all other #Glyph references and
+   * positions).
+   *
+   * @param glyph the metrics; the bitmap size and position are filled
+   * in by this method
+   * @param src the 8 bit alpha bitmap
+   */
+  const Glyph &Add(unsigned ch, Glyph glyph,
+                   const uint8_t *src, std::ptrdiff_t pitch,
+                   unsigned width, unsigned height) noexcept;
+
+  /**
+   * Returns a pointer to the bitmap of the given glyph; the pitch is
+   * #WIDTH.
+   */
+  const uint8_t *GetPixels(const Glyph &glyph) const noexcept {
+    return pixels.get() + glyph.atlas_y * WIDTH + glyph.atlas_x;
+  }
+
+  /**
+   * Remove all glyphs.
+   */
+  void Clear() noexcept;
+
+#ifdef ENABLE_OPENGL
+  /**
+   * Returns the texture containing all glyphs, after uploading the
+   * modified rows.
+   */
+  GLTexture &GetTexture() noexcept;
+#endif
+
+private:
+  const Glyph &Insert(unsigned ch, const Glyph &glyph) noexcept;
+
+  /**
+   * Allocate space for a bitmap of the given size.
+   *
+   * @return false if the atlas is full
+   */
+  bool Allocate(unsigned width, unsigned height,
+                unsigned &x_r, unsigned &y_r) noexcept;
+};
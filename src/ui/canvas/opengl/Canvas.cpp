@@ -29,6 +29,16 @@
 #include "util/ConvertString.hpp"
 #endif
 
+#if defined(USE_FREETYPE) && !defined(UNICODE)
+/* compose strings from the glyph atlas of each font instead of
+   rendering one texture per string (see TextCache) */
+#define USE_GLYPH_ATLAS
+#include "ui/canvas/freetype/GlyphAtlas.hpp"
+#include "ui/canvas/Font.hpp"
+
+#include <vector>
+#endif
+
 #ifndef NDEBUG
 #include "util/UTF8.hpp"
 #endif
@@ -571,6 +581,85 @@ PrepareColoredAlphaTexture(Color color) noexcept
   color.Bind();
 }
 
+#ifdef USE_GLYPH_ATLAS
+
+/**
+ * Buffers for laying out and drawing strings; only used by the
+ * OpenGL thread.
+ */
+static std::vector<GlyphQuad> glyph_quads;
+static AllocatedArray<BulkPixelPoint> glyph_vertices;
+static AllocatedArray<GLfloat> glyph_coords;
+
+/**
+ * Draw glyphs laid out by Font::LayoutGlyphs() with a single draw
+ * call.  The caller is responsible for the shader and for blending.
+ *
+ * @param clip the glyphs are clipped to this size (relative to #p)
+ */
+static void
+DrawGlyphs(GlyphAtlas &atlas, const std::vector<GlyphQuad> &quads,
+           PixelPoint p, PixelSize clip) noexcept
+{
+  if (quads.empty())
+    return;
+
+  GLTexture &texture = atlas.GetTexture();
+  const PixelSize allocated = texture.GetAllocatedSize();
+
+  glyph_vertices.GrowDiscard(quads.size() * 6);
+  glyph_coords.GrowDiscard(quads.size() * 12);
+
+  BulkPixelPoint *v = glyph_vertices.data();
+  GLfloat *c = glyph_coords.data();
+  unsigned n = 0;
+
+  for (const auto &quad : quads) {
+    const int left = std::max(quad.x, 0);
+    const int top = std::max(quad.y, 0);
+    const int right = std::min(quad.x + int(quad.width), int(clip.width));
+    const int bottom = std::min(quad.y + int(quad.height), int(clip.height));
+    if (left >= right || top >= bottom)
+      continue;
+
+    const BulkPixelPoint tl{p.x + left, p.y + top};
+    const BulkPixelPoint tr{p.x + right, p.y + top};
+    const BulkPixelPoint bl{p.x + left, p.y + bottom};
+    const BulkPixelPoint br{p.x + right, p.y + bottom};
+    *v++ = tl; *v++ = tr; *v++ = bl;
+    *v++ = tr; *v++ = bl; *v++ = br;
+
+    const GLfloat x0 = GLfloat(int(quad.atlas_x) + left - quad.x) / allocated.width;
+    const GLfloat y0 = GLfloat(int(quad.atlas_y) + top - quad.y) / allocated.height;
+    const GLfloat x1 = GLfloat(int(quad.atlas_x) + right - quad.x) / allocated.width;
+    const GLfloat y1 = GLfloat(int(quad.atlas_y) + bottom - quad.y) / allocated.height;
+    const GLfloat coords[] = {
+      x0, y0, x1, y0, x0, y1,
+      x1, y0, x0, y1, x1, y1,
+    };
+    c = std::copy(std::begin(coords), std::end(coords), c);
+
+    n += 6;
+  }
+
+  if (n == 0)
+    return;
+
+  texture.Bind();
+
+  const ScopeVertexPointer vp{glyph_vertices.data()};
+
+  glEnableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
+  glVertexAttribPointer(OpenGL::Attribute::TEXCOORD, 2, GL_FLOAT, GL_FALSE,
+                        0, glyph_coords.data());
+
+  glDrawArrays(GL_TRIANGLES, 0, n);
+
+  glDisableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
+}
+
+#endif
+
 void
 Canvas::DrawText(PixelPoint p, tstring_view text) noexcept
 {
@@ -590,6 +679,25 @@ Canvas::DrawText(PixelPoint p, tstring_view text) noexcept
   if (text3.empty())
     return;
 
+#ifdef USE_GLYPH_ATLAS
+  if (const auto text_width = font->LayoutGlyphs(text3, glyph_quads)) {
+    const PixelSize text_size{*text_width, font->GetHeight()};
+
+    if (background_mode == OPAQUE)
+      DrawFilledRectangle({p, text_size}, background_color);
+
+    PrepareColoredAlphaTexture(text_color);
+
+    const ScopeAlphaBlend alpha_blend;
+
+    DrawGlyphs(font->GetGlyphAtlas(), glyph_quads, p, text_size);
+    return;
+  }
+
+  /* the string does not fit into the glyph atlas; fall back to one
+     texture for the whole string */
+#endif
+
   GLTexture *texture = TextCache::Get(*font, text3);
   if (texture == nullptr)
     return;
@@ -624,6 +732,22 @@ Canvas::DrawTransparentText(PixelPoint p, tstring_view text) noexcept
   if (text3.empty())
     return;
 
+#ifdef USE_GLYPH_ATLAS
+  if (const auto text_width = font->LayoutGlyphs(text3, glyph_quads)) {
+    const PixelSize text_size{*text_width, font->GetHeight()};
+
+    PrepareColoredAlphaTexture(text_color);
+
+    const ScopeAlphaBlend alpha_blend;
+
+    DrawGlyphs(font->GetGlyphAtlas(), glyph_quads, p, text_size);
+    return;
+  }
+
+  /* the string does not fit into the glyph atlas; fall back to one
+     texture for the whole string */
+#endif
+
   GLTexture *texture = TextCache::Get(*font, text3);
   if (texture == nullptr)
     return;
@@ -656,6 +780,24 @@ Canvas::DrawClippedText(PixelPoint p, PixelSize size,
   if (text3.empty())
     return;
 
+#ifdef USE_GLYPH_ATLAS
+  if (const auto text_width = font->LayoutGlyphs(text3, glyph_quads)) {
+    if (font->GetHeight() < size.height)
+      size.height = font->GetHeight();
+    if (*text_width < size.width)
+      size.width = *text_width;
+
+    PrepareColoredAlphaTexture(text_color);
+
+    const ScopeAlphaBlend alpha_blend;
+
+    DrawGlyphs(font->GetGlyphAtlas(), glyph_quads, p, size);
+    return;
+  }
+
+  /* the string does not fit into the glyph atlas; fall back to one
+     texture for the whole string */
+#endif
   GLTexture *texture = TextCache::Get(*font, text3);
   if (texture == nullptr)
     return;
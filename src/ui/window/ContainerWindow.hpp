@@ -76,7 +76,15 @@ public:
    * Like Invalidate(), but if the specified window is covered by a
    * sibling, this method is a no-op.
    */
-  void InvalidateChild(const Window &child) noexcept;
+  void InvalidateChild(const Window &child) noexcept {
+    InvalidateChild(child, child.GetPosition());
+  }
+
+  /**
+   * Like InvalidateChild(), but only the given part of the child (in
+   * the coordinates of this window) has changed.
+   */
+  void InvalidateChild(const Window &child, PixelRect rect) noexcept;
 
   void BringChildToTop(Window &child) noexcept {
     children.BringToTop(child);
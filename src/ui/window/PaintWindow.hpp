@@ -78,7 +78,7 @@ public:
    */
   void Invalidate([[maybe_unused]] const PixelRect &rect) noexcept {
 #ifndef USE_WINUSER
-    Invalidate();
+    InvalidateRegion(rect);
 #else
     const RECT r = rect;
     ::InvalidateRect(hWnd, &r, false);
@@ -34,6 +34,10 @@ struct SDL_Window;
 #include "DisplayOrientation.hpp"
 #endif
 
+#if defined(DRAW_MOUSE_CURSOR) && defined(USE_FB)
+#include <optional>
+#endif
+
 #ifndef USE_WINUSER
 class TopCanvas;
 #endif
@@ -140,6 +144,15 @@ class TopWindow : public ContainerWindow {
   uint8_t cursor_size = 1;
   bool invert_cursor_colors = false;
   std::chrono::steady_clock::time_point cursor_visible_until;
+
+#ifdef USE_FB
+  /**
+   * The position of the mouse cursor in the last frame, or nullopt
+   * if it was not drawn.  Used to report the cursor's old area as
+   * damaged when it moves or disappears.
+   */
+  std::optional<PixelPoint> drawn_cursor;
+#endif
 #endif
 
 #ifndef USE_WINUSER
@@ -302,6 +315,7 @@ public:
 
 #ifndef USE_WINUSER
   void Invalidate() noexcept override;
+  void InvalidateRegion(PixelRect rect) noexcept override;
 
 protected:
   void Expose() noexcept;
@@ -384,7 +398,18 @@ public:
 
 #ifdef DRAW_MOUSE_CURSOR
 private:
-  void DrawMouseCursor(Canvas &canvas) noexcept;
+  [[gnu::pure]]
+  PixelRect GetMouseCursorRect(PixelPoint m) const noexcept;
+
+  void DrawMouseCursor(Canvas &canvas, PixelPoint m) noexcept;
+
+#ifdef USE_FB
+  /**
+   * Add the old and the new area of the mouse cursor to the damaged
+   * screen region if its visibility or position has changed.
+   */
+  void AddMouseCursorDamage(std::optional<PixelPoint> m) noexcept;
+#endif
 #endif
 
 protected:
@@ -272,6 +272,8 @@ public:
     AssertThread();
 
 #ifndef USE_WINUSER
+    /* the old position needs to be redrawn, too */
+    Invalidate();
     position = _position;
     Invalidate();
 #else
@@ -356,6 +358,8 @@ public:
     if (_size == size)
       return;
 
+    /* the old area needs to be redrawn, too */
+    Invalidate();
     size = _size;
 
     Invalidate();
@@ -734,6 +738,13 @@ public:
 
 #ifndef USE_WINUSER
   virtual void Invalidate() noexcept;
+
+  /**
+   * Like Invalidate(), but only the given part of this window
+   * (relative coordinates) has changed.  The rectangle is passed up
+   * to the #TopWindow, which uses it to limit the screen update.
+   */
+  virtual void InvalidateRegion(PixelRect rect) noexcept;
 #else /* USE_WINUSER */
   HDC BeginPaint(PAINTSTRUCT *ps) noexcept {
     AssertThread();
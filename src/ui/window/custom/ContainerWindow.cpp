@@ -239,12 +239,13 @@ ContainerWindow::EventChildAt(PixelPoint p) noexcept
 }
 
 void
-ContainerWindow::InvalidateChild(const Window &child) noexcept
+ContainerWindow::InvalidateChild(const Window &child,
+                                 PixelRect rect) noexcept
 {
   AssertThread();
 
   if (!children.IsCovered(child))
-    Invalidate();
+    InvalidateRegion(rect);
 }
 
 void
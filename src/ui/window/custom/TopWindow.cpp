@@ -28,6 +28,8 @@
 
 #ifdef DRAW_MOUSE_CURSOR
 #include "Screen/Layout.hpp"
+
+#include <optional>
 #endif
 
 namespace UI {
@@ -54,6 +56,10 @@ TopWindow::Create([[maybe_unused]] const TCHAR *text, PixelSize size,
   delete screen;
   screen = nullptr;
 
+#if defined(DRAW_MOUSE_CURSOR) && defined(USE_FB)
+  drawn_cursor.reset();
+#endif
+
 #ifdef ENABLE_SDL
   screen = new TopCanvas(display, window);
 #elif defined(USE_GLX)
@@ -96,16 +102,41 @@ TopWindow::CancelMode() noexcept
 
 void
 TopWindow::Invalidate() noexcept
+{
+  InvalidateRegion(GetClientRect());
+}
+
+void
+TopWindow::InvalidateRegion([[maybe_unused]] PixelRect rect) noexcept
 {
   invalidated = true;
+
+#ifdef USE_FB
+  if (screen != nullptr)
+    screen->AddDamage(rect);
+#endif
 }
 
 #ifdef DRAW_MOUSE_CURSOR
 
+PixelRect
+TopWindow::GetMouseCursorRect(PixelPoint m) const noexcept
+{
+  const int shortDistance = Layout::Scale(cursor_size * 4);
+  const int longDistance = Layout::Scale(cursor_size * 6);
+
+  /* the outline pen extends beyond the triangle */
+  const int margin = cursor_size + 1;
+
+  return {
+    m.x - margin, m.y - margin,
+    m.x + shortDistance + margin, m.y + longDistance + margin,
+  };
+}
+
 inline void
-TopWindow::DrawMouseCursor(Canvas &canvas) noexcept
+TopWindow::DrawMouseCursor(Canvas &canvas, PixelPoint m) noexcept
 {
-  const auto m = event_queue->GetMousePosition();
   const int shortDistance = Layout::Scale(cursor_size * 4);
   const int longDistance = Layout::Scale(cursor_size * 6);
 
@@ -125,6 +156,25 @@ TopWindow::DrawMouseCursor(Canvas &canvas) noexcept
   canvas.DrawTriangleFan(p, std::size(p));
 }
 
+#ifdef USE_FB
+
+inline void
+TopWindow::AddMouseCursorDamage(std::optional<PixelPoint> m) noexcept
+{
+  if (m == drawn_cursor)
+    return;
+
+  if (drawn_cursor)
+    screen->AddDamage(GetMouseCursorRect(*drawn_cursor));
+
+  if (m)
+    screen->AddDamage(GetMouseCursorRect(*m));
+
+  drawn_cursor = m;
+}
+
+#endif
+
 #endif
 
 void
@@ -138,8 +188,15 @@ TopWindow::Expose() noexcept
     OnPaint(canvas);
 
 #ifdef DRAW_MOUSE_CURSOR
-    if (std::chrono::steady_clock::now() < cursor_visible_until)
-      DrawMouseCursor(canvas);
+    std::optional<PixelPoint> cursor;
+    if (std::chrono::steady_clock::now() < cursor_visible_until) {
+      cursor = event_queue->GetMousePosition();
+      DrawMouseCursor(canvas, *cursor);
+    }
+
+#ifdef USE_FB
+    AddMouseCursorDamage(cursor);
+#endif
 #endif
 
     screen->Unlock();
@@ -150,8 +150,19 @@ Window::Invalidate() noexcept
   AssertThread();
   assert(IsDefined());
 
-  if (visible && parent != nullptr)
-    parent->InvalidateChild(*this);
+  InvalidateRegion(PixelRect{GetSize()});
+}
+
+void
+Window::InvalidateRegion(PixelRect rect) noexcept
+{
+  AssertThread();
+  assert(IsDefined());
+
+  if (visible && parent != nullptr) {
+    rect.Offset(position.x, position.y);
+    parent->InvalidateChild(*this, rect);
+  }
 }
 
 void
@@ -163,7 +174,7 @@ Window::Show() noexcept
     return;
 
   visible = true;
-  parent->Invalidate();
+  parent->InvalidateChild(*this);
 }
 
 void
@@ -175,7 +186,7 @@ Window::Hide() noexcept
     return;
 
   visible = false;
-  parent->Invalidate();
+  parent->InvalidateChild(*this);
 }
 
 void
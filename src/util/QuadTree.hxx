@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <utility>
 #include <limits>
 #include <memory>
@@ -230,6 +231,14 @@ public:
 		}
 	};
 
+	/**
+	 * One result of FindNearestN().
+	 */
+	struct NearestItem {
+		const T *value;
+		distance_type square_distance;
+	};
+
 	/**
 	 * Function wrapper for the Accessor.
 	 */
@@ -273,6 +282,46 @@ protected:
 
 	using LeafAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Leaf>;
 
+	/**
+	 * A bounded max-heap of the nearest values found so far, used by
+	 * FindNearestN().  Once it is full, #square_range shrinks to the
+	 * distance of the farthest item, which prunes the search.
+	 */
+	struct NearestHeap {
+		NearestItem *const items;
+		const std::size_t capacity;
+		distance_type square_range;
+		std::size_t size = 0;
+
+		static constexpr bool Compare(const NearestItem &a,
+					      const NearestItem &b) noexcept {
+			return a.square_distance < b.square_distance;
+		}
+
+		constexpr
+		bool Accepts(distance_type square_distance) const noexcept {
+			return size < capacity
+				? square_distance <= square_range
+				: square_distance < square_range;
+		}
+
+		void Add(const T &value, distance_type square_distance) noexcept {
+			assert(Accepts(square_distance));
+
+			if (size < capacity) {
+				items[size++] = {&value, square_distance};
+			} else {
+				std::pop_heap(items, items + size, Compare);
+				items[size - 1] = {&value, square_distance};
+			}
+
+			std::push_heap(items, items + size, Compare);
+
+			if (size == capacity)
+				square_range = items[0].square_distance;
+		}
+	};
+
 	struct LeafList {
 		/* a linked list of values, or nullptr if this is a splitted bucket */
 		Leaf *head = nullptr;
@@ -436,6 +485,17 @@ protected:
 				if (leaf->InSquareRange(location, square_range))
 					visitor((const T &)leaf->value);
 		}
+
+		template<class P>
+		void FindNearestN(const Point location, const P &predicate,
+				  NearestHeap &heap) const noexcept {
+			for (const Leaf *i = head; i != nullptr; i = i->next) {
+				const distance_type square_distance =
+					i->SquareDistanceTo(location);
+				if (heap.Accepts(square_distance) && predicate(i->value))
+					heap.Add(i->value, square_distance);
+			}
+		}
 	};
 
 	struct QuadBucket;
@@ -736,6 +796,19 @@ protected:
 			else
 				leaves.VisitWithinRange(location, square_range, visitor);
 		}
+
+		template<class P>
+		void FindNearestN(const Rectangle &bounds, const Point location,
+				  const P &predicate,
+				  NearestHeap &heap) const noexcept {
+			if (!bounds.IsWithinSquareRange(location, heap.square_range))
+				return;
+
+			if (IsSplitted())
+				children->FindNearestN(bounds, location, predicate, heap);
+			else
+				leaves.FindNearestN(location, predicate, heap);
+		}
 	};
 
 	struct QuadBucket {
@@ -882,6 +955,36 @@ protected:
 			buckets[3].VisitWithinRange(GetBottomRight(bounds, middle),
 						    location, square_range, visitor);
 		}
+
+		template<class P>
+		void FindNearestN(const Rectangle &bounds, const Point location,
+				  const P &predicate,
+				  NearestHeap &heap) const noexcept {
+			const Point middle = bounds.GetMiddle();
+			const Rectangle child_bounds[N] = {
+				GetTopLeft(bounds, middle),
+				GetTopRight(bounds, middle),
+				GetBottomLeft(bounds, middle),
+				GetBottomRight(bounds, middle),
+			};
+
+			/* descend into the closest bucket first, so the heap
+			   fills up early and prunes the others */
+			distance_type square_distances[N];
+			unsigned order[N];
+			for (unsigned i = 0; i < N; ++i) {
+				square_distances[i] = child_bounds[i].SquareDistanceTo(location);
+				order[i] = i;
+			}
+
+			std::sort(order, order + N, [&square_distances](unsigned a, unsigned b){
+				return square_distances[a] < square_distances[b];
+			});
+
+			for (const unsigned i : order)
+				buckets[i].FindNearestN(child_bounds[i], location,
+							predicate, heap);
+		}
 	};
 
 	/**
@@ -1372,6 +1475,29 @@ public:
 		return FindNearest(GetPosition(value), range);
 	}
 
+	/**
+	 * Find up to @a n values nearest to @a location (within @a range)
+	 * which match the predicate.  This uses a bounded heap instead of
+	 * visiting all values within range and sorting them afterwards.
+	 *
+	 * @param buffer an array of at least @a n items which receives
+	 * the results, sorted by distance (nearest first)
+	 * @return the number of results
+	 */
+	template<class P>
+	std::size_t FindNearestN(const Point location, distance_type range,
+				 const P &predicate,
+				 NearestItem *buffer,
+				 std::size_t n) const noexcept {
+		if (n == 0)
+			return 0;
+
+		NearestHeap heap{buffer, n, Square(range)};
+		root.FindNearestN(bounds, location, predicate, heap);
+		std::sort_heap(buffer, buffer + heap.size, NearestHeap::Compare);
+		return heap.size;
+	}
+
 	template<class V>
 	void VisitWithinRange(const Point location, distance_type range,
 			      V &visitor) const {
@@ -24,13 +24,11 @@
 #define ZZIP_USE_INTERNAL
 #include <zzip/info.h>
 
-/**    get meta infornation on a zipped element.
- * This function obtains information about a filename in an opened zip-archive 
- * without opening that file first. Mostly used to obtain the uncompressed 
- * size of a file inside a zip-archive. see => zzip_dir_open.
+/*
+ * Look up an entry in the central directory.
  */
-int
-zzip_dir_stat(ZZIP_DIR * dir, zzip_char_t * name, ZZIP_STAT * zs, int flags)
+static struct zzip_dir_hdr *
+zzip_dir_find(ZZIP_DIR * dir, zzip_char_t * name, int flags)
 {
     struct zzip_dir_hdr *hdr = dir->hdr0;
     int (*cmp) (zzip_char_t *, zzip_char_t *);
@@ -43,7 +41,7 @@ zzip_dir_stat(ZZIP_DIR * dir, zzip_char_t * name, ZZIP_STAT * zs, int flags)
 #ifdef ZZIP_DISABLED
         dir->errcode = ZZIP_ENOENT;
 #endif /* ZZIP_DISABLED */
-        return -1;
+        return 0;
     }
 
     if (flags & ZZIP_IGNOREPATH)
@@ -64,27 +62,65 @@ zzip_dir_stat(ZZIP_DIR * dir, zzip_char_t * name, ZZIP_STAT * zs, int flags)
         }
 
         if (! cmp(hdr_name, name))
-            break;
+            return hdr;
 
         if (! hdr->d_reclen)
         {
 #ifdef ZZIP_DISABLED
             dir->errcode = ZZIP_ENOENT;
 #endif /* ZZIP_DISABLED */
-            return -1;
+            return 0;
         }
 
         hdr = (struct zzip_dir_hdr *) ((char *) hdr + hdr->d_reclen);
     }
+}
+
+/**    get meta infornation on a zipped element.
+ * This function obtains information about a filename in an opened zip-archive 
+ * without opening that file first. Mostly used to obtain the uncompressed 
+ * size of a file inside a zip-archive. see => zzip_dir_open.
+ */
+int
+zzip_dir_stat(ZZIP_DIR * dir, zzip_char_t * name, ZZIP_STAT * zs, int flags)
+{
+    return zzip_dir_stat_offset(dir, name, zs, 0, flags);
+}
+
+/** => zzip_dir_stat
+ * (XCSoar extension) Like zzip_dir_stat, but also obtains the offset
+ * of the entry's local file header in the archive file, which allows
+ * reading an uncompressed entry directly (e.g. from a memory mapping
+ * of => zzip_dirfd). The offset pointer may be null.
+ */
+int
+zzip_dir_stat_offset(ZZIP_DIR * dir, zzip_char_t * name, ZZIP_STAT * zs,
+                     zzip_off_t * offset, int flags)
+{
+    struct zzip_dir_hdr *hdr = zzip_dir_find(dir, name, flags);
+    if (! hdr)
+        return -1;
 
     zs->d_compr = hdr->d_compr;
     zs->d_csize = hdr->d_csize;
     zs->st_size = hdr->d_usize;
     zs->d_name = hdr->d_name;
 
+    if (offset)
+        *offset = hdr->d_off;
+
     return 0;
 }
 
+/**
+ * This function returns the file descriptor of the opened archive.
+ */
+int
+zzip_dirfd(ZZIP_DIR * dir)
+{
+    return dir->fd;
+}
+
 /** => zzip_dir_stat
  * This function will obtain information about a opened file _within_ a 
  * zip-archive. The file is supposed to be open (otherwise -1 is returned). 
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Benchmark for the AAT target optimisation (TaskMinTarget,
+ * TaskOptTarget) and the automatic MacCready calculation
+ * (TaskBestMc): replays the AAT tasks of test_aat with all wind
+ * settings and measures the time per simulated flight.
+ */
+
+#include "harness_flight.hpp"
+#include "harness_wind.hpp"
+#include "test_debug.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+using std::chrono::steady_clock;
+
+static steady_clock::duration
+RunFlights(int test_num, bool auto_mc, double &max_ratio_error)
+{
+  const FloatDuration min_time =
+    FloatDuration{aat_min_time(test_num)} + std::chrono::minutes{5};
+
+  const auto start = steady_clock::now();
+
+  for (unsigned n_wind = 0; n_wind < NUM_WIND; ++n_wind) {
+    const auto result = test_flight(test_num, n_wind, 1.0, auto_mc);
+    max_ratio_error = std::max(max_ratio_error,
+                               fabs(result.time_elapsed / min_time - 1.0));
+  }
+
+  return steady_clock::now() - start;
+}
+
+static void
+PrintResult(const char *name, steady_clock::duration duration,
+            double max_ratio_error)
+{
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+
+  printf("%s: %lu ms/flight, max time ratio error %g\n", name,
+         (unsigned long)duration_cast<milliseconds>(duration).count() / NUM_WIND,
+         max_ratio_error);
+}
+
+int
+main(int argc, char **argv)
+{
+  autopilot_parms.SetIdeal();
+
+  if (!ParseArgs(argc, argv))
+    return 0;
+
+  static constexpr struct {
+    const char *name;
+    int test_num;
+    bool auto_mc;
+  } runs[] = {
+    { "aat", 2, false },
+    { "aat auto_mc", 2, true },
+    { "mixed", 0, false },
+    { "mixed auto_mc", 0, true },
+  };
+
+  for (const auto &run : runs) {
+    double max_ratio_error = 0;
+    const auto duration = RunFlights(run.test_num, run.auto_mc,
+                                     max_ratio_error);
+    PrintResult(run.name, duration, max_ratio_error);
+  }
+
+  return EXIT_SUCCESS;
+}
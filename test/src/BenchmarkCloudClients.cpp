@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Benchmark for the spatial index of #CloudClientContainer with an
+ * update-heavy workload: all clients move a little and submit a fix,
+ * and each fix is followed by a traffic range query, just like
+ * CloudServer::OnFix() does.  For comparison, the same workload is
+ * run on a boost::geometry R*-tree (which was used previously).
+ */
+
+#include "Cloud/Client.hpp"
+#include "Geo/Boost/GeoPoint.hpp"
+#include "Geo/Boost/RangeBox.hpp"
+#include "net/IPv4Address.hxx"
+#include "system/Args.hpp"
+#include "util/NumberParser.hpp"
+#include "util/PrintException.hxx"
+
+#include <boost/geometry/algorithms/intersection.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using std::chrono::steady_clock;
+
+static constexpr double TRAFFIC_RANGE = 50000;
+
+struct Result {
+  steady_clock::duration update{}, query{};
+  unsigned long n_results = 0;
+};
+
+static void
+PrintResult(const char *name, const Result &result, unsigned n)
+{
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+
+  printf("%s: update %lu ns, query %lu ns, %lu results\n", name,
+         (unsigned long)duration_cast<nanoseconds>(result.update).count() / n,
+         (unsigned long)duration_cast<nanoseconds>(result.query).count() / n,
+         result.n_results);
+}
+
+/**
+ * Generates the same random walk for all benchmarks.
+ */
+class Workload {
+  std::vector<GeoPoint> locations;
+
+  std::minstd_rand random;
+  std::uniform_real_distribution<double> drift{-0.005, 0.005};
+
+public:
+  explicit Workload(unsigned n_clients) noexcept {
+    std::uniform_real_distribution<double> longitude(0, 15);
+    std::uniform_real_distribution<double> latitude(45, 55);
+
+    locations.reserve(n_clients);
+    for (unsigned i = 0; i < n_clients; ++i)
+      locations.emplace_back(Angle::Degrees(longitude(random)),
+                             Angle::Degrees(latitude(random)));
+  }
+
+  std::size_t size() const noexcept {
+    return locations.size();
+  }
+
+  const GeoPoint &operator[](std::size_t i) const noexcept {
+    return locations[i];
+  }
+
+  const GeoPoint &Move(std::size_t i) noexcept {
+    auto &location = locations[i];
+    location.longitude += Angle::Degrees(drift(random));
+    location.latitude += Angle::Degrees(drift(random));
+    return location;
+  }
+};
+
+static Result
+BenchmarkGrid(Workload workload, unsigned n_rounds)
+{
+  const IPv4Address address(127, 0, 0, 1, 5597);
+
+  auto clients = std::make_unique<CloudClientContainer>();
+  for (std::size_t i = 0; i < workload.size(); ++i)
+    clients->Make(address, i + 1, workload[i], 1000);
+
+  Result result;
+
+  for (unsigned round = 0; round < n_rounds; ++round) {
+    for (std::size_t i = 0; i < workload.size(); ++i) {
+      const auto &location = workload.Move(i);
+
+      const auto start = steady_clock::now();
+      clients->Make(address, i + 1, location, 1000);
+      const auto updated = steady_clock::now();
+
+      for ([[maybe_unused]] const auto &c :
+             clients->QueryWithinRange(location, TRAFFIC_RANGE))
+        ++result.n_results;
+
+      result.update += updated - start;
+      result.query += steady_clock::now() - updated;
+    }
+  }
+
+  return result;
+}
+
+static Result
+BenchmarkRTree(Workload workload, unsigned n_rounds)
+{
+  using Value = std::pair<GeoPoint, std::size_t>;
+  boost::geometry::index::rtree<Value,
+                                boost::geometry::index::rstar<16>> rtree;
+
+  for (std::size_t i = 0; i < workload.size(); ++i)
+    rtree.insert(Value{workload[i], i});
+
+  Result result;
+
+  for (unsigned round = 0; round < n_rounds; ++round) {
+    for (std::size_t i = 0; i < workload.size(); ++i) {
+      const Value old_value{workload[i], i};
+      const auto &location = workload.Move(i);
+
+      const auto start = steady_clock::now();
+      rtree.remove(old_value);
+      rtree.insert(Value{location, i});
+      const auto updated = steady_clock::now();
+
+      const auto q = boost::geometry::index::intersects(BoostRangeBox(location,
+                                                                      TRAFFIC_RANGE));
+      for (auto j = rtree.qbegin(q); j != rtree.qend(); ++j)
+        ++result.n_results;
+
+      result.update += updated - start;
+      result.query += steady_clock::now() - updated;
+    }
+  }
+
+  return result;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[CLIENTS [ROUNDS]]");
+  const unsigned n_clients = args.IsEmpty()
+    ? 10000 : ParseUnsigned(args.ExpectNext());
+  const unsigned n_rounds = args.IsEmpty()
+    ? 10 : ParseUnsigned(args.ExpectNext());
+  args.ExpectEnd();
+
+  if (n_clients == 0 || n_rounds == 0) {
+    fprintf(stderr, "Invalid parameters\n");
+    return EXIT_FAILURE;
+  }
+
+  const Workload workload(n_clients);
+  const unsigned n = n_clients * n_rounds;
+
+  const auto grid = BenchmarkGrid(workload, n_rounds);
+  PrintResult("grid", grid, n);
+
+  const auto rtree = BenchmarkRTree(workload, n_rounds);
+  PrintResult("rtree", rtree, n);
+
+  if (grid.n_results != rtree.n_results) {
+    fprintf(stderr, "Result mismatch\n");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,426 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Throughput benchmark for the task engine: replays IGC files through
+ * #TaskManager, #ContestManager, #AirspaceWarningManager and the
+ * route planner (reach and route to the current leg) the way the
+ * calculation thread drives them, and measures the time, the number
+ * of heap allocations and the allocated bytes of each component per
+ * fix.
+ *
+ * The results are printed as one JSON object per IGC file (JSON
+ * Lines), so they can be collected and compared over time.
+ */
+
+#include "DebugReplayIGC.hpp"
+#include "Task/TaskFile.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/TaskBehaviour.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Contest/ContestManager.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "Engine/Airspace/AirspaceWarningConfig.hpp"
+#include "Engine/Airspace/Predicate/AirspacePredicate.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Route/Config.hpp"
+#include "Route/AirspaceRoute.hpp"
+#include "Route/ReachFan.hpp"
+#include "GlideSolvers/GlideSettings.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "NMEA/Aircraft.hpp"
+#include "Operation/Operation.hpp"
+#include "time/GPSClock.hpp"
+#include "thread/SharedMutex.hpp"
+#include "io/FileReader.hxx"
+#include "io/BufferedReader.hxx"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "util/PrintException.hxx"
+
+#include <zzip/zzip.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef HAVE_POSIX
+#include <sys/resource.h>
+#endif
+
+using namespace std::chrono;
+
+/*
+ * Heap accounting: the global operator new/delete are replaced by
+ * versions which store the allocation size in a header in front of
+ * each block.
+ */
+
+static constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+static std::atomic<uint64_t> n_allocations, n_allocated_bytes;
+static std::atomic<std::size_t> live_bytes, peak_bytes;
+
+void *
+operator new(std::size_t size)
+{
+  void *p = malloc(HEADER_SIZE + size);
+  if (p == nullptr)
+    throw std::bad_alloc();
+
+  *(std::size_t *)p = size;
+
+  n_allocations.fetch_add(1, std::memory_order_relaxed);
+  n_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+  const std::size_t live =
+    live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+  std::size_t peak = peak_bytes.load(std::memory_order_relaxed);
+  while (live > peak &&
+         !peak_bytes.compare_exchange_weak(peak, live,
+                                           std::memory_order_relaxed)) {}
+
+  return (std::byte *)p + HEADER_SIZE;
+}
+
+void
+operator delete(void *p) noexcept
+{
+  if (p == nullptr)
+    return;
+
+  void *block = (std::byte *)p - HEADER_SIZE;
+  live_bytes.fetch_sub(*(const std::size_t *)block,
+                       std::memory_order_relaxed);
+  free(block);
+}
+
+void
+operator delete(void *p, std::size_t) noexcept
+{
+  operator delete(p);
+}
+
+/**
+ * Accumulates the cost of one component.
+ */
+struct Meter {
+  steady_clock::duration duration{};
+  uint64_t allocations = 0, bytes = 0;
+
+  template<typename F>
+  void Measure(F &&f) {
+    const uint64_t allocations0 = n_allocations.load(std::memory_order_relaxed);
+    const uint64_t bytes0 = n_allocated_bytes.load(std::memory_order_relaxed);
+    const auto start = steady_clock::now();
+
+    f();
+
+    duration += steady_clock::now() - start;
+    allocations += n_allocations.load(std::memory_order_relaxed) - allocations0;
+    bytes += n_allocated_bytes.load(std::memory_order_relaxed) - bytes0;
+  }
+
+  /**
+   * Print the per-fix cost as a JSON object member.
+   */
+  void PrintPerFix(const char *name, unsigned n_fixes) const {
+    const double n = std::max(n_fixes, 1U);
+    printf(",\"%s\":{\"ns_per_fix\":%.0f,\"allocs_per_fix\":%.3f,"
+           "\"bytes_per_fix\":%.1f}",
+           name, duration_cast<nanoseconds>(duration).count() / n,
+           allocations / n, bytes / n);
+  }
+
+  /**
+   * Print the total cost as a JSON object member.
+   */
+  void PrintTotal(const char *name) const {
+    printf(",\"%s\":{\"ns\":%llu,\"allocs\":%llu,\"bytes\":%llu}",
+           name,
+           (unsigned long long)duration_cast<nanoseconds>(duration).count(),
+           (unsigned long long)allocations,
+           (unsigned long long)bytes);
+  }
+};
+
+static void
+PrintJSONString(const char *s)
+{
+  putchar('"');
+  for (; *s != 0; ++s) {
+    if (*s == '"' || *s == '\\')
+      putchar('\\');
+    putchar(*s);
+  }
+  putchar('"');
+}
+
+static long
+GetMaxRSS()
+{
+#ifdef HAVE_POSIX
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    return usage.ru_maxrss;
+#endif
+
+  return -1;
+}
+
+static void
+LoadTerrain(const char *path, RasterMap &map)
+{
+  ZZIP_DIR *dir = zzip_dir_open(path, nullptr);
+  if (dir == nullptr) {
+    fprintf(stderr, "Failed to open %s\n", path);
+    exit(EXIT_FAILURE);
+  }
+
+  {
+    NullOperationEnvironment operation;
+    LoadTerrainOverview(dir, map.GetTileCache(), operation);
+  }
+
+  map.UpdateProjection();
+
+  SharedMutex mutex;
+  do {
+    UpdateTerrainTiles(dir, map.GetTileCache(), mutex,
+                       map.GetProjection(),
+                       map.GetMapCenter(), 50000);
+  } while (map.IsDirty());
+  zzip_dir_close(dir);
+}
+
+static void
+LoadAirspaces(Path path, Airspaces &airspaces)
+{
+  FileReader file_reader{path};
+  BufferedReader buffered_reader{file_reader};
+  ParseAirspaceFile(airspaces, buffered_reader);
+  airspaces.Optimise();
+}
+
+/**
+ * Load the task declared for the flight: a task file with the same
+ * base name, or else the declaration in the IGC file.
+ */
+static std::unique_ptr<OrderedTask>
+LoadTask(Path igc_path, const TaskBehaviour &task_behaviour)
+{
+  const auto tsk_path = igc_path.WithSuffix(".tsk");
+  try {
+    if (auto task = TaskFile::GetTask(tsk_path, task_behaviour, nullptr, 0))
+      return task;
+  } catch (...) {
+  }
+
+  try {
+    return TaskFile::GetTask(igc_path, task_behaviour, nullptr, 0);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+static bool
+Run(Path igc_path, const RasterMap &map, const Airspaces &airspaces)
+{
+  DebugReplay *replay = DebugReplayIGC::Create(igc_path);
+  if (replay == nullptr)
+    return false;
+
+  peak_bytes.store(live_bytes.load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+
+  const GlidePolar glide_polar(1);
+
+  const Waypoints waypoints;
+  TaskManager task_manager(task_behaviour, waypoints);
+  task_manager.SetGlidePolar(glide_polar);
+
+  const auto task = LoadTask(igc_path, task_behaviour);
+  if (task != nullptr) {
+    task_manager.Commit(*task);
+    task_manager.Resume();
+  }
+
+  /* the trace sizes of TraceComputer */
+  Trace full_trace(minutes{2}, Trace::null_time, 1024);
+  Trace contest_trace({}, Trace::null_time, 256);
+  Trace sprint_trace({}, minutes{150}, 128);
+  ContestManager contest_manager(Contest::WEGLIDE_FREE,
+                                 full_trace, contest_trace, sprint_trace);
+
+  AirspaceWarningConfig warning_config;
+  warning_config.SetDefaults();
+  AirspaceWarningManager warning_manager(warning_config, airspaces);
+  bool warning_initialised = false;
+
+  GlideSettings glide_settings;
+  glide_settings.SetDefaults();
+  RoutePlannerConfig route_config;
+  route_config.SetDefaults();
+  route_config.mode = RoutePlannerConfig::Mode::BOTH;
+
+  AirspaceRoute route;
+  route.UpdatePolar(glide_settings, route_config, glide_polar, glide_polar,
+                    SpeedVector::Zero());
+  route.SetTerrain(&map);
+
+  static constexpr auto ROUTE_PERIOD = seconds(5);
+  GPSClock reach_clock, route_clock;
+
+  Meter task_meter, contest_meter, contest_solve_meter, airspace_meter,
+    route_meter;
+
+  unsigned n_fixes = 0;
+  AircraftState last_state;
+  bool last_state_valid = false;
+
+  while (replay->Next()) {
+    const MoreData &basic = replay->Basic();
+    const DerivedInfo &calculated = replay->Calculated();
+
+    if (!basic.time_available || !basic.location_available ||
+        !basic.NavAltitudeAvailable())
+      continue;
+
+    const AircraftState state = ToAircraftState(basic, calculated);
+    if (!last_state_valid) {
+      last_state = state;
+      last_state_valid = true;
+      continue;
+    }
+
+    const auto dt = basic.time - last_state.time;
+    if (dt.count() <= 0) {
+      last_state = state;
+      continue;
+    }
+
+    ++n_fixes;
+
+    task_meter.Measure([&]{
+      task_manager.Update(state, last_state);
+      task_manager.UpdateIdle(state);
+      task_manager.UpdateAutoMC(state, 0);
+      task_manager.SetTaskAdvance().SetArmed(true);
+    });
+
+    contest_meter.Measure([&]{
+      if (calculated.flight.flying) {
+        const TracePoint point(basic);
+        full_trace.push_back(point);
+        contest_trace.push_back(point);
+        sprint_trace.push_back(point);
+      }
+
+      contest_manager.UpdateIdle();
+    });
+
+    airspace_meter.Measure([&]{
+      if (!warning_initialised) {
+        warning_initialised = true;
+        warning_manager.Reset(state);
+      }
+
+      warning_manager.Update(state, glide_polar, task_manager.GetStats(),
+                             calculated.circling,
+                             round<duration<unsigned>>(dt));
+    });
+
+    route_meter.Measure([&]{
+      const AGeoPoint start(state.location, state.altitude);
+      const int h_ceiling = (int)basic.nav_altitude + 500;
+
+      if (reach_clock.CheckAdvance(basic.time, ROUTE_PERIOD)) {
+        [[maybe_unused]] const auto reach_terrain =
+          route.SolveReach(start, route_config, h_ceiling, true, false);
+        [[maybe_unused]] const auto reach_working =
+          route.SolveReach(start, route_config, h_ceiling, true, true);
+      }
+
+      const GlideResult &solution =
+        task_manager.GetStats().current_leg.solution_remaining;
+      if (solution.IsDefined() &&
+          route_clock.CheckAdvance(basic.time, ROUTE_PERIOD)) {
+        GeoVector v = solution.vector;
+        v.distance = std::min(v.distance, 200000.);
+
+        const AGeoPoint destination(v.EndPoint(start),
+                                    solution.min_arrival_altitude);
+        route.Synchronise(airspaces, AirspacePredicateTrue,
+                          destination, start);
+        route.Solve(destination, start, route_config, h_ceiling);
+      }
+    });
+
+    last_state = state;
+  }
+
+  contest_solve_meter.Measure([&]{
+    contest_manager.SolveExhaustive();
+  });
+
+  delete replay;
+
+  printf("{\"file\":");
+  PrintJSONString(igc_path.c_str());
+  printf(",\"fixes\":%u,\"task\":%s", n_fixes,
+         task != nullptr ? "true" : "false");
+  task_meter.PrintPerFix("task_manager", n_fixes);
+  contest_meter.PrintPerFix("contest_manager", n_fixes);
+  contest_solve_meter.PrintTotal("contest_solve");
+  airspace_meter.PrintPerFix("airspace_warning_manager", n_fixes);
+  route_meter.PrintPerFix("route_planner", n_fixes);
+  printf(",\"peak_heap_bytes\":%zu,\"max_rss_kb\":%ld}\n",
+         peak_bytes.load(std::memory_order_relaxed), GetMaxRSS());
+  fflush(stdout);
+
+  return true;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "MAP.xcm AIRSPACE IGC...");
+  const char *map_path = args.ExpectNext();
+  const auto airspace_path = args.ExpectNextPath();
+
+  RasterMap map;
+  LoadTerrain(map_path, map);
+
+  Airspaces airspaces;
+  LoadAirspaces(airspace_path, airspaces);
+
+  if (args.IsEmpty())
+    args.UsageError();
+
+  int result = EXIT_SUCCESS;
+  while (!args.IsEmpty()) {
+    const auto igc_path = args.ExpectNextPath();
+    if (!Run(igc_path, map, airspaces)) {
+      fprintf(stderr, "Failed to open %s\n", igc_path.c_str());
+      result = EXIT_FAILURE;
+    }
+  }
+
+  return result;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Benchmark for the spatial queries of #Waypoints with a large
+ * database: "the 10 nearest landables" implemented as a range scan
+ * followed by sorting (the way the alternates list used to do it)
+ * compared with the k-nearest query.
+ */
+
+#include "Waypoint/Waypoints.hpp"
+#include "system/Args.hpp"
+#include "util/NumberParser.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using std::chrono::steady_clock;
+
+static constexpr double RANGE = 100000;
+static constexpr unsigned N_NEAREST = 10;
+
+static void
+PrintResult(const char *name, steady_clock::duration duration,
+            unsigned n_queries, unsigned long n_results)
+{
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+
+  printf("%s: %lu ns/query, %lu results\n", name,
+         (unsigned long)duration_cast<nanoseconds>(duration).count() / n_queries,
+         n_results);
+}
+
+static void
+AddRandomWaypoints(Waypoints &waypoints, unsigned n, std::minstd_rand &random)
+{
+  std::uniform_real_distribution<double> longitude(0, 15);
+  std::uniform_real_distribution<double> latitude(45, 55);
+
+  for (unsigned i = 0; i < n; ++i) {
+    Waypoint wp = waypoints.Create(GeoPoint(Angle::Degrees(longitude(random)),
+                                            Angle::Degrees(latitude(random))));
+    if (i % 3 == 0)
+      wp.type = Waypoint::Type::OUTLANDING;
+    waypoints.Append(std::move(wp));
+  }
+
+  waypoints.Optimise();
+}
+
+static unsigned long
+RangeScan(const Waypoints &waypoints, const GeoPoint &location)
+{
+  std::vector<WaypointPtr> found;
+
+  /* the std::function overhead is part of what is measured here */
+  const WaypointVisitor visitor = [&found](const WaypointPtr &wp){
+    if (wp->IsLandable())
+      found.push_back(wp);
+  };
+  waypoints.VisitWithinRange(location, RANGE, visitor);
+
+  const auto n = std::min<std::size_t>(found.size(), N_NEAREST);
+  std::partial_sort(found.begin(), found.begin() + n, found.end(),
+                    [location](const WaypointPtr &a, const WaypointPtr &b){
+                      return a->location.DistanceS(location) <
+                        b->location.DistanceS(location);
+                    });
+  return n;
+}
+
+static unsigned long
+Nearest(const Waypoints &waypoints, const GeoPoint &location)
+{
+  unsigned long n = 0;
+  waypoints.VisitNearest(location, RANGE, N_NEAREST,
+                         [](const Waypoint &wp){ return wp.IsLandable(); },
+                         [&n](const WaypointPtr &){ ++n; });
+  return n;
+}
+
+template<typename F>
+static void
+Run(const char *name, const Waypoints &waypoints,
+    const std::vector<GeoPoint> &locations, F &&f)
+{
+  unsigned long n_results = 0;
+  const auto start = steady_clock::now();
+  for (const auto &location : locations)
+    n_results += f(waypoints, location);
+  PrintResult(name, steady_clock::now() - start, locations.size(), n_results);
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[WAYPOINTS [QUERIES]]");
+  const unsigned n_waypoints = args.IsEmpty()
+    ? 50000 : ParseUnsigned(args.ExpectNext());
+  const unsigned n_queries = args.IsEmpty()
+    ? 1000 : ParseUnsigned(args.ExpectNext());
+  args.ExpectEnd();
+
+  if (n_waypoints == 0 || n_queries == 0) {
+    fprintf(stderr, "Invalid parameters\n");
+    return EXIT_FAILURE;
+  }
+
+  std::minstd_rand random;
+
+  Waypoints waypoints;
+  AddRandomWaypoints(waypoints, n_waypoints, random);
+
+  std::uniform_real_distribution<double> longitude(1, 14);
+  std::uniform_real_distribution<double> latitude(46, 54);
+  std::vector<GeoPoint> locations;
+  locations.reserve(n_queries);
+  for (unsigned i = 0; i < n_queries; ++i)
+    locations.emplace_back(Angle::Degrees(longitude(random)),
+                           Angle::Degrees(latitude(random)));
+
+  printf("%u waypoints, %u queries, %u nearest landables within %.0f km\n",
+         n_waypoints, n_queries, N_NEAREST, RANGE / 1000);
+
+  Run("range scan + sort", waypoints, locations, RangeScan);
+  Run("k-nearest", waypoints, locations, Nearest);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
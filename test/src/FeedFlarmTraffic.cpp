@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * A stress test for the FLARM traffic code: sends $PFLAA sentences
+ * for many targets circling around the own position, once per
+ * second, like a FLARM at a crowded competition grid.
+ */
+
+#include "DebugPort.hpp"
+#include "system/Args.hpp"
+#include "Device/Port/Port.hpp"
+#include "Device/Port/ConfiguredPort.hpp"
+#include "Device/Config.hpp"
+#include "Device/Util/NMEAWriter.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "io/async/GlobalAsioThread.hpp"
+#include "io/async/AsioThread.hpp"
+#include "io/NullDataHandler.hpp"
+#include "util/NumberParser.hpp"
+#include "util/StaticString.hxx"
+#include "util/PrintException.hxx"
+#include "Math/Util.hpp"
+#include "time/PeriodClock.hpp"
+#include "time/Cast.hxx"
+
+#include <thread>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static void
+SendTraffic(Port &port, OperationEnvironment &env,
+            unsigned n_targets, double elapsed)
+{
+  NarrowString<128> sentence;
+
+  sentence.Format("PFLAU,%u,1,2,1,0,,0,,", std::min(n_targets, 99u));
+  PortWriteNMEA(port, sentence, env);
+
+  for (unsigned i = 0; i < n_targets; ++i) {
+    /* each target circles on its own radius with 25 m/s */
+    const double radius = 200 + 50 * i;
+    const double angle = elapsed * 25 / radius + i;
+
+    const int north = iround(radius * cos(angle));
+    const int east = iround(radius * sin(angle));
+    const int vertical = (int(i % 20) - 10) * 30;
+    const unsigned track = unsigned(angle * 180 / M_PI + 90) % 360;
+
+    sentence.Format("PFLAA,0,%d,%d,%d,2,%06X,%u,0,25,1.5,1",
+                    north, east, vertical, 0xDD0000 + i, track);
+    PortWriteNMEA(port, sentence, env);
+  }
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "PORT [TARGETS]");
+  DebugPort debug_port(args);
+  const unsigned n_targets = args.IsEmpty()
+    ? 200 : ParseUnsigned(args.ExpectNext());
+  args.ExpectEnd();
+
+  ScopeGlobalAsioThread global_asio_thread;
+
+  NullDataHandler handler;
+  auto port = debug_port.Open(*asio_thread, *global_cares_channel, handler);
+
+  ConsoleOperationEnvironment env;
+
+  if (!port->WaitConnected(env)) {
+    fprintf(stderr, "Failed to connect the port\n");
+    return EXIT_FAILURE;
+  }
+
+  PeriodClock start_clock;
+  start_clock.Update();
+
+  while (true) {
+    SendTraffic(*port, env, n_targets,
+                ToFloatSeconds(start_clock.Elapsed()));
+
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+} catch (const std::exception &exception) {
+  PrintException(exception);
+  return EXIT_FAILURE;
+}
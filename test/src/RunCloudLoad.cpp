@@ -0,0 +1,289 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * A load generator for xcsoar-cloud-server: simulates many clients
+ * flying close to each other, each submitting fixes and requesting
+ * traffic, and reports the packet rates.
+ */
+
+#include "Tracking/SkyLines/Assemble.hpp"
+#include "Tracking/SkyLines/Protocol.hpp"
+#include "Tracking/SkyLines/Server.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "net/Resolver.hxx"
+#include "net/AddressInfo.hxx"
+#include "net/SocketError.hxx"
+#include "net/UniqueSocketDescriptor.hxx"
+#include "event/Loop.hxx"
+#include "event/SocketEvent.hxx"
+#include "event/FineTimerEvent.hxx"
+#include "system/Args.hpp"
+#include "util/ByteOrder.hxx"
+#include "util/NumberParser.hpp"
+#include "util/PrintException.hxx"
+#include "util/SpanCast.hxx"
+
+#include <algorithm>
+#include <list>
+#include <random>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std::chrono;
+
+/**
+ * Traffic requests expire on the server after 5 minutes; refresh
+ * them well before that.
+ */
+static constexpr auto TRAFFIC_REQUEST_INTERVAL = minutes(1);
+
+/**
+ * The clients are distributed over this many sockets (i.e. source
+ * ports), which allows a server with SO_REUSEPORT to distribute them
+ * over its threads.
+ */
+static constexpr unsigned MAX_SOCKETS = 32;
+
+class LoadSocket;
+
+struct SimulatedClient {
+  LoadSocket *socket;
+
+  uint64_t key;
+
+  GeoPoint location;
+
+  steady_clock::time_point next_fix, next_traffic_request;
+};
+
+struct Counters {
+  unsigned sent_packets = 0, send_errors = 0;
+  unsigned received_packets = 0, received_traffic = 0;
+  std::size_t received_bytes = 0;
+
+  Counters &operator+=(const Counters &other) noexcept {
+    sent_packets += other.sent_packets;
+    send_errors += other.send_errors;
+    received_packets += other.received_packets;
+    received_traffic += other.received_traffic;
+    received_bytes += other.received_bytes;
+    return *this;
+  }
+};
+
+/**
+ * One UDP socket connected to the server.
+ */
+class LoadSocket {
+  SocketEvent event;
+
+  Counters &counters;
+
+public:
+  LoadSocket(EventLoop &event_loop, SocketAddress address,
+             Counters &_counters)
+    :event(event_loop, BIND_THIS_METHOD(OnSocketReady)),
+     counters(_counters)
+  {
+    UniqueSocketDescriptor s;
+    if (!s.Create(address.GetFamily(), SOCK_DGRAM, 0))
+      throw MakeSocketError("Failed to create socket");
+
+    if (!s.Connect(address))
+      throw MakeSocketError("Failed to connect socket");
+
+    event.Open(s.Release());
+    event.ScheduleRead();
+  }
+
+  ~LoadSocket() noexcept {
+    event.Close();
+  }
+
+  template<typename P>
+  void Send(const P &packet) noexcept {
+    if (event.GetSocket().WriteNoWait(ReferenceAsBytes(packet)) < 0)
+      ++counters.send_errors;
+    else
+      ++counters.sent_packets;
+  }
+
+private:
+  void OnSocketReady(unsigned) noexcept {
+    std::byte buffer[4096];
+
+    while (true) {
+      const auto nbytes = event.GetSocket().ReadNoWait(buffer);
+      if (nbytes < 0)
+        break;
+
+      ++counters.received_packets;
+      counters.received_bytes += nbytes;
+
+      const auto &packet =
+        *(const SkyLinesTracking::TrafficResponsePacket *)buffer;
+      if (std::size_t(nbytes) >= sizeof(packet) &&
+          (SkyLinesTracking::Type)FromBE16(packet.header.type) ==
+          SkyLinesTracking::Type::TRAFFIC_RESPONSE)
+        counters.received_traffic += packet.traffic_count;
+    }
+  }
+};
+
+class LoadGenerator {
+  EventLoop &event_loop;
+
+  Counters current, total;
+
+  std::list<LoadSocket> sockets;
+
+  FineTimerEvent tick_timer{event_loop, BIND_THIS_METHOD(OnTick)};
+  FineTimerEvent report_timer{event_loop, BIND_THIS_METHOD(OnReport)};
+
+  std::vector<SimulatedClient> clients;
+
+  const steady_clock::duration fix_interval;
+
+  std::minstd_rand random;
+
+  unsigned remaining_seconds;
+
+public:
+  LoadGenerator(EventLoop &_event_loop, SocketAddress address,
+                unsigned n_clients, unsigned fixes_per_second,
+                unsigned n_seconds)
+    :event_loop(_event_loop),
+     fix_interval(duration_cast<steady_clock::duration>(seconds{1}) /
+                  fixes_per_second),
+     remaining_seconds(n_seconds)
+  {
+    const GeoPoint center(Angle::Degrees(11.5), Angle::Degrees(48.5));
+    std::uniform_real_distribution<double> offset(-0.2, 0.2);
+    std::uniform_int_distribution<steady_clock::rep> phase(0, fix_interval.count());
+
+    for (unsigned i = 0; i < std::min(n_clients, MAX_SOCKETS); ++i)
+      sockets.emplace_back(event_loop, address, current);
+
+    const auto now = event_loop.SteadyNow();
+
+    auto socket = sockets.begin();
+
+    clients.reserve(n_clients);
+    for (unsigned i = 0; i < n_clients; ++i) {
+      const GeoPoint location(center.longitude + Angle::Degrees(offset(random)),
+                              center.latitude + Angle::Degrees(offset(random)));
+
+      /* spread the fixes evenly over the interval; the first fix
+         registers the client, the traffic request follows */
+      const auto first = now + steady_clock::duration(phase(random));
+      clients.push_back({&*socket, 0x10000 + i, location,
+                         first, first + fix_interval});
+
+      if (++socket == sockets.end())
+        socket = sockets.begin();
+    }
+
+    tick_timer.Schedule({});
+    report_timer.Schedule(seconds{1});
+  }
+
+  const Counters &GetTotal() const noexcept {
+    return total;
+  }
+
+private:
+  void SendFix(SimulatedClient &client, steady_clock::time_point now) noexcept {
+    /* drift a little so the server has to update its index */
+    std::uniform_real_distribution<double> drift(-0.0005, 0.0005);
+    client.location.longitude += Angle::Degrees(drift(random));
+    client.location.latitude += Angle::Degrees(drift(random));
+
+    const auto time_of_day =
+      duration_cast<milliseconds>(now.time_since_epoch()).count() % 86400000;
+
+    client.socket->Send(SkyLinesTracking::MakeFix(client.key,
+                                                  SkyLinesTracking::FixPacket::FLAG_LOCATION |
+                                                  SkyLinesTracking::FixPacket::FLAG_ALTITUDE,
+                                                  time_of_day, client.location,
+                                                  Angle::Zero(), 25, 25, 1000, 0, 0));
+  }
+
+  void OnTick() noexcept {
+    const auto now = event_loop.SteadyNow();
+
+    for (auto &client : clients) {
+      if (now >= client.next_fix) {
+        SendFix(client, now);
+        client.next_fix += fix_interval;
+      }
+
+      if (now >= client.next_traffic_request) {
+        client.socket->Send(SkyLinesTracking::MakeTrafficRequest(client.key,
+                                                                 false, false, true));
+        client.next_traffic_request = now + TRAFFIC_REQUEST_INTERVAL;
+      }
+    }
+
+    tick_timer.Schedule(milliseconds(5));
+  }
+
+  void OnReport() noexcept {
+    printf("sent %u pkt/s (%u errors)  received %u pkt/s, %zu bytes/s, %u traffic/s\n",
+           current.sent_packets, current.send_errors,
+           current.received_packets, current.received_bytes,
+           current.received_traffic);
+    fflush(stdout);
+
+    total += current;
+    current = {};
+
+    if (--remaining_seconds == 0)
+      event_loop.Break();
+    else
+      report_timer.Schedule(seconds{1});
+  }
+};
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "HOST [CLIENTS [FIXES_PER_SECOND [SECONDS]]]");
+  const char *host = args.ExpectNext();
+  const unsigned n_clients = args.IsEmpty()
+    ? 100 : ParseUnsigned(args.ExpectNext());
+  const unsigned fixes_per_second = args.IsEmpty()
+    ? 1 : ParseUnsigned(args.ExpectNext());
+  const unsigned n_seconds = args.IsEmpty()
+    ? 10 : ParseUnsigned(args.ExpectNext());
+  args.ExpectEnd();
+
+  if (n_clients == 0 || fixes_per_second == 0 || n_seconds == 0) {
+    fprintf(stderr, "Invalid parameters\n");
+    return EXIT_FAILURE;
+  }
+
+  const auto address_list =
+    Resolve(host, SkyLinesTracking::Server::GetDefaultPort(),
+            0, SOCK_DGRAM);
+  const auto &address = address_list.GetBest();
+
+  EventLoop event_loop;
+  LoadGenerator generator(event_loop, address,
+                          n_clients, fixes_per_second, n_seconds);
+  event_loop.Run();
+
+  const auto &total = generator.GetTotal();
+  printf("average: sent %u pkt/s (%u errors)  received %u pkt/s, %zu bytes/s, %u traffic/s\n",
+         total.sent_packets / n_seconds, total.send_errors / n_seconds,
+         total.received_packets / n_seconds,
+         total.received_bytes / n_seconds,
+         total.received_traffic / n_seconds);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
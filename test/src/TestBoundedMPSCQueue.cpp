@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "thread/BoundedMPSCQueue.hpp"
+#include "thread/Thread.hpp"
+#include "TestUtil.hpp"
+
+#include <atomic>
+
+struct Item {
+  unsigned producer, sequence;
+};
+
+static void
+TestSingleThread()
+{
+  BoundedMPSCQueue<Item, 4> queue;
+
+  unsigned value = 0;
+  ok1(!queue.TryPop([](Item &){}));
+
+  for (unsigned i = 0; i < 4; ++i)
+    ok1(queue.TryPush([i](Item &item){ item = {0, i}; }));
+
+  /* full */
+  ok1(!queue.TryPush([](Item &){}));
+
+  ok1(queue.TryPop([&value](Item &item){ value = item.sequence; }));
+  ok1(value == 0);
+
+  /* there is room for one more */
+  ok1(queue.TryPush([](Item &item){ item = {0, 4}; }));
+  ok1(!queue.TryPush([](Item &){}));
+
+  unsigned expected = 1;
+  bool in_order = true;
+  while (queue.TryPop([&](Item &item){
+    in_order &= item.sequence == expected++;
+  })) {}
+
+  ok1(in_order);
+  ok1(expected == 5);
+}
+
+class Producer final : public Thread {
+  BoundedMPSCQueue<Item, 64> &queue;
+  const unsigned id, n;
+
+public:
+  unsigned dropped = 0;
+  std::atomic_bool done = false;
+
+  Producer(BoundedMPSCQueue<Item, 64> &_queue,
+           unsigned _id, unsigned _n) noexcept
+    :queue(_queue), id(_id), n(_n) {}
+
+protected:
+  void Run() noexcept override {
+    for (unsigned i = 0; i < n; ++i)
+      if (!queue.TryPush([this, i](Item &item){ item = {id, i}; }))
+        ++dropped;
+
+    done = true;
+  }
+};
+
+static void
+TestConcurrent()
+{
+  static constexpr unsigned N_PRODUCERS = 4;
+  static constexpr unsigned N_ITEMS = 100000;
+
+  BoundedMPSCQueue<Item, 64> queue;
+
+  Producer producers[N_PRODUCERS] = {
+    {queue, 0, N_ITEMS},
+    {queue, 1, N_ITEMS},
+    {queue, 2, N_ITEMS},
+    {queue, 3, N_ITEMS},
+  };
+
+  for (auto &p : producers)
+    p.Start();
+
+  /* each producer's items must arrive in order (with gaps for the
+     dropped ones) */
+  int last[N_PRODUCERS] = {-1, -1, -1, -1};
+  unsigned received = 0;
+  bool in_order = true;
+
+  const auto consume = [&](Item &item){
+    in_order &= item.producer < N_PRODUCERS &&
+      int(item.sequence) > last[item.producer];
+    last[item.producer] = item.sequence;
+    ++received;
+  };
+
+  bool running = true;
+  while (running) {
+    running = false;
+    for (const auto &p : producers)
+      running |= !p.done;
+
+    while (queue.TryPop(consume)) {}
+  }
+
+  for (auto &p : producers)
+    p.Join();
+
+  while (queue.TryPop(consume)) {}
+
+  unsigned dropped = 0;
+  for (const auto &p : producers)
+    dropped += p.dropped;
+
+  ok1(in_order);
+  ok1(received + dropped == N_PRODUCERS * N_ITEMS);
+}
+
+int
+main()
+{
+  plan_tests(12 + 2);
+
+  TestSingleThread();
+  TestConcurrent();
+
+  return exit_status();
+}
@@ -5,12 +5,60 @@
 #include "FLARM/FlarmNetReader.hpp"
 #include "FLARM/FlarmNetRecord.hpp"
 #include "FLARM/Id.hpp"
+#include "io/FileCache.hpp"
 #include "system/Path.hpp"
 #include "TestUtil.hpp"
 
+static void
+TestCallSignPrefix(const FlarmNetDatabase &db)
+{
+  const FlarmNetRecord *array[8];
+  ok1(db.FindRecordsByCallSignPrefix(_T("T"), array, 8) == 2);
+  ok1(StringIsEqual(array[0]->callsign, _T("TH")));
+  ok1(db.FindRecordsByCallSignPrefix(_T("TH"), array, 8) == 2);
+  ok1(db.FindRecordsByCallSignPrefix(_T("THX"), array, 8) == 0);
+  ok1(db.FindRecordsByCallSignPrefix(_T("L"), array, 8) == 1);
+  ok1(StringIsEqual(array[0]->registration, _T("D-3450")));
+
+  /* the empty prefix matches all records, sorted by callsign */
+  ok1(db.FindRecordsByCallSignPrefix(_T(""), array, 8) == 6);
+  ok1(array[0]->callsign.empty());
+  ok1(StringIsEqual(array[1]->callsign, _T("1A")));
+  ok1(StringIsEqual(array[5]->callsign, _T("TH")));
+
+  /* the result is limited by the array size */
+  ok1(db.FindRecordsByCallSignPrefix(_T(""), array, 3) == 3);
+  ok1(db.FindRecordsByCallSign(_T("TH"), array, 1) == 1);
+}
+
+static void
+TestCache(const FlarmNetDatabase &db, Path path)
+{
+  FileCache cache(AllocatedPath(_T("output/test/flarmnet-cache")));
+  cache.Flush(_T("flarmnet"));
+
+  FlarmNetDatabase cached;
+  ok1(!cached.LoadCache(cache, path));
+
+  db.SaveCache(cache, path);
+  ok1(cached.LoadCache(cache, path));
+  ok1(cached.size() == db.size());
+
+  const FlarmNetRecord *record =
+    cached.FindRecordById(FlarmId::Parse("DDA896", NULL));
+  ok1(record != NULL);
+  ok1(StringIsEqual(record->registration, _T("D-5799")));
+  ok1(cached.FindRecordById(FlarmId::Parse("DDA897", NULL)) == NULL);
+
+  FlarmId ids[3];
+  ok1(cached.FindIdsByCallSign(_T("TH"), ids, 3) == 2);
+
+  TestCallSignPrefix(cached);
+}
+
 int main()
 {
-  plan_tests(15);
+  plan_tests(15 + 12 + 7 + 12);
 
   FlarmNetDatabase db;
   int count = FlarmNetReader::LoadFile(Path(_T("test/data/flarmnet/data.fln")),
@@ -59,5 +107,8 @@ int main()
   ok1(foundDDA85C);
   ok1(foundDDA896);
 
+  TestCallSignPrefix(db);
+  TestCache(db, Path(_T("test/data/flarmnet/data.fln")));
+
   return exit_status();
 }
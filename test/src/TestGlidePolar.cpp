@@ -3,8 +3,15 @@
 
 #include "TestUtil.hpp"
 #include "GlideSolvers/GlidePolar.hpp"
+#include "GlideSolvers/GlideSettings.hpp"
+#include "GlideSolvers/GlideState.hpp"
+#include "GlideSolvers/GlideResult.hpp"
+#include "GlideSolvers/MacCready.hpp"
+#include "Math/ZeroFinder.hpp"
 #include "Units/System.hpp"
 
+#include <algorithm>
+
 #include <cstdio>
 
 class GlidePolarTest
@@ -20,6 +27,32 @@ private:
   void TestBallast();
   void TestBugs();
   void TestMC();
+  void TestGlideSpeedTable();
+  void TestGlideSpeedTable(const GlidePolar &polar);
+};
+
+/**
+ * The search MacCready::OptimiseGlide() performs for winds outside
+ * the glide speed table.
+ */
+class GlideSpeedSearch final : public ZeroFinder
+{
+  const MacCready &mac;
+  const GlideState &task;
+
+public:
+  GlideSpeedSearch(const MacCready &_mac, const GlideState &_task,
+                   const GlidePolar &polar)
+    :ZeroFinder(polar.GetVMin(), polar.GetVMax(), 0.001),
+     mac(_mac), task(_task) {}
+
+  double f(const double v) noexcept override {
+    const auto res = mac.SolveGlide(task, v, false);
+    if (!res.IsOk() || res.vector.distance <= 0)
+      return 1000000;
+
+    return res.height_glide * 1024 / res.vector.distance;
+  }
 };
 
 void
@@ -145,6 +178,69 @@ GlidePolarTest::TestMC()
   ok1(equals(polar.GetVBestLD(), 25.830434162));
 }
 
+void
+GlidePolarTest::TestGlideSpeedTable(const GlidePolar &gp)
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+  const MacCready mac(settings, gp);
+
+  const auto max_wind = 0.4 * gp.GetVMax();
+
+  double max_error = 0;
+  bool all_found = true;
+  for (double norm = 0.7; norm < max_wind; norm += 1.3) {
+    for (unsigned angle = 0; angle <= 180; angle += 15) {
+      const SpeedVector wind(Angle::Degrees(angle), norm);
+      const GlideState task(GeoVector(10000, Angle::Zero()), 0, 2000, wind);
+
+      GlideSpeedSearch search(mac, task, gp);
+      const auto reference = mac.SolveGlide(task, search.find_min(gp.GetVMin()),
+                                            false);
+      if (!reference.IsOk())
+        continue;
+
+      if (gp.LookupGlideSpeed(task.head_wind, task.GetCrossWind()) <= 0)
+        all_found = false;
+
+      /* MacCready::Solve() uses the table at MacCready zero */
+      const auto result = MacCready::Solve(settings, gp, task);
+      max_error = std::max(max_error,
+                           (result.height_glide - reference.height_glide) /
+                           reference.height_glide);
+    }
+  }
+
+  printf("# glide speed table: max relative height error %g\n", max_error);
+  ok1(all_found);
+  ok1(max_error < 0.001);
+}
+
+void
+GlidePolarTest::TestGlideSpeedTable()
+{
+  polar.SetMC(0);
+  TestGlideSpeedTable(polar);
+
+  /* the table is rebuilt when the polar changes */
+  polar.SetBallast(0.5);
+  TestGlideSpeedTable(polar);
+  polar.SetBallast(0);
+
+  polar.SetBugs(0.75);
+  TestGlideSpeedTable(polar);
+  polar.SetBugs(1);
+
+  /* the default polar, with a different maximum speed */
+  GlidePolar gp(0);
+  gp.SetVMax(50);
+  TestGlideSpeedTable(gp);
+
+  /* strong wind is left to the search */
+  ok1(polar.LookupGlideSpeed(polar.GetVMax(), 0) < 0);
+  ok1(polar.LookupGlideSpeed(0, polar.GetVMax()) < 0);
+}
+
 void
 GlidePolarTest::Run()
 {
@@ -153,11 +249,12 @@ GlidePolarTest::Run()
   TestBallast();
   TestBugs();
   TestMC();
+  TestGlideSpeedTable();
 }
 
 int main()
 {
-  plan_tests(46);
+  plan_tests(56);
 
   GlidePolarTest test;
   test.Run();
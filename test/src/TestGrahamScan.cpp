@@ -2,8 +2,14 @@
 // Copyright The XCSoar Project
 
 #include "Geo/SearchPointVector.hpp"
+#include "Geo/ConvexHull/GrahamScan.hpp"
+#include "Geo/ConvexHull/IncrementalConvexHull.hpp"
 #include "TestUtil.hpp"
 
+#include <algorithm>
+
+#include <stdlib.h>
+
 static constexpr GeoPoint
 GP(double longitude, double latitude) noexcept
 {
@@ -70,12 +76,54 @@ TestPruned2()
   ok1(!v.PruneInterior());
 }
 
+static bool
+Equals(const SearchPointVector &a, const SearchPointVector &b) noexcept
+{
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                    [](const SearchPoint &x, const SearchPoint &y){
+                      return x.GetLocation() == y.GetLocation();
+                    });
+}
+
+/**
+ * Add random points (with many duplicates) with
+ * #IncrementalConvexHull, and compare each step with appending the
+ * point and calling PruneInterior().
+ */
+static void
+TestIncremental(double tolerance)
+{
+  srand(42);
+
+  bool same = true;
+  for (unsigned n = 0; n < 1000; ++n) {
+    IncrementalConvexHull hull(tolerance);
+    SearchPointVector v, reference;
+
+    const unsigned size = 3 + rand() % 40;
+    for (unsigned i = 0; i < size; ++i) {
+      const auto sp = SP(10 + (rand() % 100) / 1000.,
+                         50 + (rand() % 100) / 1000.);
+
+      reference.push_back(sp);
+      const bool pruned = PruneInterior(reference, tolerance);
+
+      if (hull.Add(v, sp) != pruned || !Equals(v, reference))
+        same = false;
+    }
+  }
+
+  ok1(same);
+}
+
 int
 main()
 {
-  plan_tests(6);
+  plan_tests(8);
 
   TestNotPruned();
   TestPruned1();
   TestPruned2();
+  TestIncremental(-1);
+  TestIncremental(0);
 }
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "thread/JobGraph.hpp"
+#include "TestUtil.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include <string.h>
+
+using namespace std::chrono;
+
+/**
+ * A job must not start before its dependencies have finished, even
+ * if they take longer than the independent jobs.
+ */
+static void
+TestDependencies()
+{
+  std::atomic_bool a_done = false, b_done = false;
+  bool a_done_before_c = false, b_done_before_c = false;
+  bool c_done_before_d = false;
+  std::atomic_bool c_done = false;
+
+  JobGraph graph;
+  const auto a = graph.Add("a", [&]{
+    std::this_thread::sleep_for(milliseconds(50));
+    a_done = true;
+  });
+  const auto b = graph.Add("b", [&]{
+    std::this_thread::sleep_for(milliseconds(20));
+    b_done = true;
+  });
+  graph.Add("independent", []{});
+  const auto c = graph.Add("c", [&]{
+    a_done_before_c = a_done;
+    b_done_before_c = b_done;
+    c_done = true;
+  }, {a, b});
+  const auto d = graph.Add("d", [&]{
+    c_done_before_d = c_done;
+  }, {c});
+
+  graph.Start();
+  graph.Wait(d);
+
+  ok1(a_done_before_c);
+  ok1(b_done_before_c);
+  ok1(c_done_before_d);
+
+  /* the timing of a dependent job starts after its dependencies */
+  graph.Wait(a);
+  ok1(graph.GetTiming(c).start >= graph.GetTiming(a).end);
+  ok1(graph.GetTiming(a).GetDuration() >= milliseconds(50));
+  ok1(strcmp(graph.GetName(c), "c") == 0);
+
+  /* the destructor waits for the job which was not waited for */
+}
+
+/**
+ * An exception is passed to Wait(), and the dependent jobs are run
+ * anyway.
+ */
+static void
+TestError()
+{
+  bool dependent_run = false;
+
+  JobGraph graph;
+  const auto a = graph.Add("a", []{
+    throw std::runtime_error("failed");
+  });
+  const auto b = graph.Add("b", [&]{ dependent_run = true; }, {a});
+  graph.Start();
+
+  bool thrown = false;
+  try {
+    graph.Wait(a);
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+
+  ok1(thrown);
+
+  graph.Wait(b);
+  ok1(dependent_run);
+}
+
+int main()
+{
+  plan_tests(8);
+
+  TestDependencies();
+  TestError();
+
+  return exit_status();
+}
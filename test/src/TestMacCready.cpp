@@ -3,6 +3,7 @@
 
 #include "Geo/SpeedVector.hpp"
 #include "Engine/GlideSolvers/GlideSettings.hpp"
+#include "Engine/GlideSolvers/GlideBatch.hpp"
 #include "Engine/GlideSolvers/GlidePolar.hpp"
 #include "Engine/GlideSolvers/GlideState.hpp"
 #include "Engine/GlideSolvers/GlideResult.hpp"
@@ -10,6 +11,8 @@
 
 #include "TestUtil.hpp"
 
+#include <vector>
+
 static GlideSettings glide_settings;
 static GlidePolar glide_polar(0);
 
@@ -120,25 +123,104 @@ TestAll()
   TestWind(SpeedVector(Angle::Zero(), 30));
 }
 
+[[gnu::pure]]
+static bool
+Equals(const GlideResult &a, const GlideResult &b)
+{
+  if (a.validity != b.validity)
+    return false;
+
+  if (!a.IsOk())
+    /* the other attributes are undefined */
+    return true;
+
+  return a.vector.distance == b.vector.distance &&
+    a.head_wind == b.head_wind &&
+    a.v_opt == b.v_opt &&
+    a.min_arrival_altitude == b.min_arrival_altitude &&
+    a.height_climb == b.height_climb &&
+    a.height_glide == b.height_glide &&
+    a.pure_glide_height == b.pure_glide_height &&
+    a.altitude_difference == b.altitude_difference &&
+    a.pure_glide_altitude_difference == b.pure_glide_altitude_difference &&
+    a.time_elapsed == b.time_elapsed &&
+    a.time_virtual == b.time_virtual;
+}
+
+/**
+ * Check that the batch solvers return the same results as solving
+ * each #GlideState.
+ */
+static void
+TestBatch(const SpeedVector wind)
+{
+  static constexpr double altitude = 3000;
+  static constexpr double distances[] = { 0, 1000, 10000, 100000 };
+  static constexpr double heights[] = { -1000, -200, 0, 100, 4000 };
+
+  const MacCready mac_cready(glide_settings, glide_polar);
+
+  GlideBatch batch(altitude, wind);
+  std::vector<GlideState> states;
+
+  for (const double distance : distances) {
+    for (unsigned bearing = 0; bearing < 360; bearing += 30) {
+      for (const double height : heights) {
+        const GeoVector vector(distance, Angle::Degrees(bearing));
+        batch.Add(vector, altitude - height);
+        states.emplace_back(vector, altitude - height, altitude, wind);
+      }
+    }
+  }
+
+  std::vector<GlideResult> results(batch.size());
+
+  MacCready::Solve(glide_settings, glide_polar, batch, results);
+  bool equal = true;
+  for (std::size_t i = 0; i < states.size(); ++i)
+    equal &= Equals(results[i], MacCready::Solve(glide_settings, glide_polar,
+                                                 states[i]));
+  ok1(equal);
+
+  mac_cready.SolveStraight(batch, results);
+  equal = true;
+  for (std::size_t i = 0; i < states.size(); ++i)
+    equal &= Equals(results[i], mac_cready.SolveStraight(states[i]));
+  ok1(equal);
+}
+
+static void
+TestBatch()
+{
+  TestBatch(SpeedVector(Angle::Zero(), 0));
+  TestBatch(SpeedVector(Angle::Degrees(70), 5));
+  TestBatch(SpeedVector(Angle::Degrees(200), 20));
+}
+
 int main()
 {
-  plan_tests(2103);
+  plan_tests(2133);
 
   glide_settings.SetDefaults();
 
   TestAll();
+  TestBatch();
 
   glide_polar.SetMC(0.1);
   TestAll();
+  TestBatch();
 
   glide_polar.SetMC(1);
   TestAll();
+  TestBatch();
 
   glide_polar.SetMC(4);
   TestAll();
+  TestBatch();
 
   glide_polar.SetMC(10);
   TestAll();
+  TestBatch();
 
   return exit_status();
 }
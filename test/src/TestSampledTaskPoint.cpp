@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Task/Points/SampledTaskPoint.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "Geo/GeoVector.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+
+#include <stdlib.h>
+
+class TestPoint : public SampledTaskPoint {
+public:
+  using SampledTaskPoint::SampledTaskPoint;
+  using SampledTaskPoint::AddInsideSample;
+};
+
+/**
+ * The interior sample algorithm which was used before
+ * #IncrementalConvexHull: recalculate the whole hull with
+ * PruneInterior() for each sample outside of it.
+ */
+static void
+AddSampleReference(SearchPointVector &v, const GeoPoint &location,
+                   const FlatProjection &projection)
+{
+  if (v.IsInside(location))
+    return;
+
+  v.push_back(SearchPoint(location, projection));
+  v.PruneInterior();
+  v.ThinToSize(64);
+}
+
+/**
+ * The maximum task distance through one of the given points, i.e. what
+ * TaskDijkstraMax finds for a single intermediate point.
+ */
+static double
+ScoredDistance(const SearchPointVector &v, const GeoPoint &previous,
+               const GeoPoint &next)
+{
+  double result = 0;
+  for (const auto &i : v)
+    result = std::max(result, previous.Distance(i.GetLocation()) +
+                      i.GetLocation().Distance(next));
+  return result;
+}
+
+static double
+Random(double max)
+{
+  return max * rand() / RAND_MAX;
+}
+
+/**
+ * Simulate thermalling in an AAT area: drifting circles with random
+ * radius, connected by straight legs.
+ */
+static void
+TestFlight(unsigned seed)
+{
+  srand(seed);
+
+  const GeoPoint center(Angle::Degrees(10), Angle::Degrees(50));
+  const FlatProjection projection(center);
+
+  TestPoint point(center, true);
+  SearchPointVector reference;
+  SearchPointVector all;
+
+  GeoPoint location = center;
+  Angle heading = Angle::Degrees(Random(360));
+
+  const auto add = [&](const GeoPoint &_location){
+    AircraftState state;
+    state.location = _location;
+    point.AddInsideSample(state, projection);
+    AddSampleReference(reference, _location, projection);
+    all.push_back(SearchPoint(_location, projection));
+  };
+
+  for (unsigned thermal = 0; thermal < 20; ++thermal) {
+    /* cruise to the next thermal */
+    const unsigned cruise = 10 + rand() % 60;
+    for (unsigned i = 0; i < cruise; ++i) {
+      location = GeoVector(40, heading).EndPoint(location);
+      add(location);
+    }
+
+    /* circle, drifting with the wind */
+    const double radius = 80 + Random(120);
+    const unsigned circles = 1 + rand() % 5;
+    for (unsigned i = 0; i < circles * 20; ++i) {
+      heading += Angle::FullCircle() / 20;
+      location = GeoVector(2 * M_PI * radius / 20, heading).EndPoint(location);
+      location = GeoVector(5, Angle::Degrees(270)).EndPoint(location);
+      add(location);
+    }
+
+    heading = heading.Fraction(Angle::Degrees(Random(360)), 0.5);
+  }
+
+  const auto &sampled = point.GetSampledPoints();
+  ok1(!sampled.empty() && sampled.size() <= 64);
+
+  /* the same points in the same order as the old algorithm */
+  ok1(std::equal(sampled.begin(), sampled.end(),
+                 reference.begin(), reference.end(),
+                 [](const SearchPoint &a, const SearchPoint &b){
+                   return a.GetLocation() == b.GetLocation();
+                 }));
+
+  /* and therefore the same scored distance, whichever direction the
+     task continues; never more than the best sample */
+  bool same = true, not_more = true;
+  for (unsigned i = 0; i < 8; ++i) {
+    const Angle direction = Angle::FullCircle() * (i / 8.);
+    const GeoPoint previous =
+      GeoVector(50000, direction).EndPoint(center);
+    const GeoPoint next =
+      GeoVector(50000, direction + Angle::Degrees(100)).EndPoint(center);
+
+    const auto scored = ScoredDistance(sampled, previous, next);
+    if (scored != ScoredDistance(reference, previous, next))
+      same = false;
+    if (scored > ScoredDistance(all, previous, next) + 1)
+      not_more = false;
+  }
+
+  ok1(same);
+  ok1(not_more);
+}
+
+int main()
+{
+  plan_tests(40);
+
+  for (unsigned seed = 1; seed <= 10; ++seed)
+    TestFlight(seed);
+
+  return exit_status();
+}
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Task/PathSolvers/TaskDijkstraMin.hpp"
+#include "Engine/Task/PathSolvers/TaskDijkstraMax.hpp"
+#include "Geo/SearchPointVector.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "Geo/GeoVector.hpp"
+#include "TestUtil.hpp"
+
+#include <stdlib.h>
+
+static constexpr unsigned NUM_STAGES = 8;
+
+static const GeoPoint center(Angle::Degrees(10), Angle::Degrees(50));
+static const FlatProjection projection(center);
+
+static double
+Random(double max)
+{
+  return max * rand() / RAND_MAX;
+}
+
+static GeoPoint
+RandomPoint(const GeoPoint &origin, double radius)
+{
+  return GeoVector(Random(radius), Angle::Degrees(Random(360)))
+    .EndPoint(origin);
+}
+
+/**
+ * Fill each stage with a random cloud of points around a turn point,
+ * similar to the sampled hull of an AAT area.
+ */
+static void
+MakeStages(SearchPointVector *stages, unsigned num_stages)
+{
+  for (unsigned stage = 0; stage < num_stages; ++stage) {
+    const GeoPoint tp = RandomPoint(center, 100000);
+
+    auto &v = stages[stage];
+    v.clear();
+    for (unsigned i = 1 + rand() % 40; i > 0; --i)
+      v.push_back(SearchPoint(RandomPoint(tp, 20000), projection));
+  }
+}
+
+/**
+ * The distance of the solution, rounded the same way as the solver
+ * does.
+ */
+static unsigned
+SolutionDistance(const TaskDijkstra &dijkstra, unsigned num_stages,
+                 const GeoPoint &location)
+{
+  unsigned distance = (unsigned)location.Distance(dijkstra.GetSolution(0).GetLocation());
+  for (unsigned stage = 1; stage < num_stages; ++stage)
+    distance += (unsigned)dijkstra.GetSolution(stage - 1).GetLocation()
+      .Distance(dijkstra.GetSolution(stage).GetLocation());
+  return distance;
+}
+
+static void
+TestIncremental(unsigned num_stages)
+{
+  SearchPointVector stages[NUM_STAGES];
+  MakeStages(stages, num_stages);
+
+  TaskDijkstraMin full, incremental;
+  full.SetTaskSize(num_stages);
+  incremental.SetTaskSize(num_stages);
+  for (unsigned stage = 0; stage < num_stages; ++stage) {
+    full.SetBoundary(stage, stages[stage]);
+    incremental.SetBoundary(stage, stages[stage]);
+  }
+
+  SearchPoint location(RandomPoint(center, 50000), projection);
+
+  /* no previous calculation */
+  ok1(!incremental.DistanceMinIncremental(stages[0], location));
+
+  ok1(incremental.DistanceMin(location));
+
+  bool ok = true;
+  SearchPointVector first = stages[0];
+  for (unsigned i = 0; i < 20; ++i) {
+    location = SearchPoint(RandomPoint(center, 50000), projection);
+
+    /* the aircraft has left more samples in the active area */
+    first.push_back(SearchPoint(RandomPoint(first.front().GetLocation(),
+                                            20000),
+                                projection));
+    full.SetBoundary(0, first);
+
+    if (!full.DistanceMin(location) ||
+        !incremental.DistanceMinIncremental(first, location) ||
+        SolutionDistance(incremental, num_stages, location.GetLocation()) !=
+        SolutionDistance(full, num_stages, location.GetLocation()))
+      ok = false;
+  }
+
+  ok1(ok);
+}
+
+/**
+ * The edge map is reused; solving a smaller task after a bigger one
+ * must not see stale edges.
+ */
+static void
+TestReuse()
+{
+  SearchPointVector stages[NUM_STAGES];
+  MakeStages(stages, NUM_STAGES);
+
+  TaskDijkstraMax dijkstra;
+  dijkstra.SetTaskSize(NUM_STAGES);
+  for (unsigned stage = 0; stage < NUM_STAGES; ++stage)
+    dijkstra.SetBoundary(stage, stages[stage]);
+  ok1(dijkstra.DistanceMax());
+
+  /* a single point per stage: there is only one solution */
+  SearchPointVector single[2];
+  single[0].push_back(stages[0].front());
+  single[1].push_back(stages[1].back());
+
+  dijkstra.SetTaskSize(2);
+  dijkstra.SetBoundary(0, single[0]);
+  dijkstra.SetBoundary(1, single[1]);
+  ok1(dijkstra.DistanceMax());
+  ok1(dijkstra.GetSolution(0).GetLocation() == single[0].front().GetLocation());
+  ok1(dijkstra.GetSolution(1).GetLocation() == single[1].front().GetLocation());
+}
+
+int main()
+{
+  plan_tests(3 * NUM_STAGES + 4);
+
+  srand(42);
+
+  for (unsigned num_stages = 1; num_stages <= NUM_STAGES; ++num_stages)
+    TestIncremental(num_stages);
+
+  TestReuse();
+
+  return exit_status();
+}
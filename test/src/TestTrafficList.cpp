@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FLARM/TrafficStore.hpp"
+#include "TestUtil.hpp"
+
+#include <stdio.h>
+
+using namespace std::chrono;
+
+static FlarmId
+MakeId(unsigned i) noexcept
+{
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%06X", 0xDD0000 + i);
+  return FlarmId::Parse(buffer, nullptr);
+}
+
+static bool
+CheckAll(const TrafficStore &list, unsigned step, unsigned offset) noexcept
+{
+  for (unsigned i = 0; i < TrafficStore::MAX_COUNT; ++i) {
+    const auto id = MakeId(i);
+    const auto *traffic = list.FindTraffic(id);
+    const bool expected = i % step == offset;
+    if ((traffic != nullptr) != expected ||
+        (traffic != nullptr && traffic->id != id))
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * Publishing a full #TrafficStore in a #TrafficList keeps the alarms
+ * and the nearest targets.
+ */
+static void
+TestCopyNearest() noexcept
+{
+  const TimeStamp t0{FloatDuration{100}};
+
+  TrafficStore store;
+  store.Clear();
+  store.modified.Update(t0);
+
+  /* the distance grows with the index, except for target 0, which
+     is far away but raises an alarm */
+  for (unsigned i = 0; i < TrafficStore::MAX_COUNT; ++i) {
+    auto &traffic = *store.AllocateTraffic(MakeId(i));
+    traffic.valid.Update(t0);
+    traffic.relative_north = i == 0 ? 100000 : 10. * i;
+    traffic.relative_east = i == 0 ? 0 : -5. * i;
+    traffic.alarm_level = i == 0
+      ? FlarmTraffic::AlarmType::URGENT
+      : FlarmTraffic::AlarmType::NONE;
+  }
+
+  TrafficList list;
+  list.Clear();
+  store.CopyNearest(list);
+
+  ok1(list.modified);
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+  ok1(list.FindTraffic(MakeId(0)) != nullptr);
+  ok1(list.FindTraffic(MakeId(TrafficList::MAX_COUNT - 1)) != nullptr);
+  ok1(list.FindTraffic(MakeId(TrafficList::MAX_COUNT)) == nullptr);
+
+  /* the targets keep the order of the store */
+  bool ordered = true;
+  for (unsigned i = 0; i < TrafficList::MAX_COUNT; ++i)
+    if (list.list[i].id != MakeId(i))
+      ordered = false;
+  ok1(ordered);
+}
+
+int
+main()
+{
+  plan_tests(19);
+
+  const TimeStamp t0{FloatDuration{100}};
+
+  TrafficStore list;
+  list.Clear();
+
+  /* fill the list; odd targets are one second newer */
+  bool allocated = true;
+  for (unsigned i = 0; i < TrafficStore::MAX_COUNT; ++i) {
+    auto *traffic = list.AllocateTraffic(MakeId(i));
+    if (traffic == nullptr) {
+      allocated = false;
+      break;
+    }
+
+    traffic->valid.Update(i % 2 == 0 ? t0 : t0 + seconds{1});
+  }
+
+  ok1(allocated);
+  ok1(list.GetActiveTrafficCount() == TrafficStore::MAX_COUNT);
+  ok1(list.AllocateTraffic(MakeId(TrafficStore::MAX_COUNT)) == nullptr);
+  ok1(CheckAll(list, 1, 0));
+  ok1(list.FindTraffic(MakeId(TrafficStore::MAX_COUNT)) == nullptr);
+
+  /* the even targets expire; the index must still find the others */
+  list.Expire(t0 + seconds{3});
+  ok1(list.GetActiveTrafficCount() == TrafficStore::MAX_COUNT / 2);
+  ok1(CheckAll(list, 2, 1));
+
+  /* merge into an empty list */
+  TrafficStore copy;
+  copy.Clear();
+  copy.Complement(list);
+  ok1(copy.GetActiveTrafficCount() == TrafficStore::MAX_COUNT / 2);
+  ok1(CheckAll(copy, 2, 1));
+
+  /* merge into a non-empty list; id 1 is already there */
+  TrafficStore other;
+  other.Clear();
+  other.AllocateTraffic(MakeId(0));
+  other.AllocateTraffic(MakeId(1));
+  other.Complement(list);
+  ok1(other.GetActiveTrafficCount() == 1 + TrafficStore::MAX_COUNT / 2);
+  ok1(other.FindTraffic(MakeId(0)) != nullptr);
+  ok1(other.FindTraffic(MakeId(3)) != nullptr);
+  ok1(other.FindTraffic(MakeId(4)) == nullptr);
+
+  TestCopyNearest();
+
+  return exit_status();
+}
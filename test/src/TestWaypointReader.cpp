@@ -4,6 +4,7 @@
 #include "Waypoint/WaypointReader.hpp"
 #include "Waypoint/WaypointReaderBase.hpp"
 #include "Waypoint/CupWriter.hpp"
+#include "Waypoint/WaypointCache.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "Units/System.hpp"
@@ -11,6 +12,9 @@
 #include "system/Path.hpp"
 #include "io/BufferedOutputStream.hxx"
 #include "io/StringOutputStream.hxx"
+#include "io/MemoryReader.hxx"
+#include "io/BufferedReader.hxx"
+#include "util/SpanCast.hxx"
 #include "util/tstring.hpp"
 #include "util/StringAPI.hxx"
 #include "util/StringStrip.hxx"
@@ -318,6 +322,65 @@ TestCupWriter(const wp_vector &org_wp)
 )cup"sv);
 }
 
+static void
+TestCache(const wp_vector &org_wp)
+{
+  Waypoints way_points;
+  if (!TestWaypointFile(Path(_T("test/data/waypoints.cup")), way_points,
+                        org_wp.size())) {
+    skip(3 + 12 * org_wp.size(), 0, "opening waypoints.cup failed");
+    return;
+  }
+
+  StringOutputStream sos;
+  WithBufferedOutputStream(sos, [&](BufferedOutputStream &bos){
+    SaveWaypointCache(bos, way_points);
+  });
+  const auto s = std::move(sos).GetValue();
+
+  Waypoints cached;
+  MemoryReader mr{AsBytes(s)};
+  BufferedReader br{mr};
+  LoadWaypointCache(br, cached, WaypointOrigin::PRIMARY);
+  cached.Optimise();
+
+  ok1(cached.size() == way_points.size());
+
+  for (const auto &i : org_wp) {
+    const auto wp = GetWaypoint(i, cached);
+    TestSeeYouWaypoint(i, wp.get());
+  }
+
+  /* a truncated cache must be rejected */
+  Waypoints truncated;
+  MemoryReader mr2{AsBytes(s).first(s.size() / 2)};
+  BufferedReader br2{mr2};
+  try {
+    LoadWaypointCache(br2, truncated, WaypointOrigin::PRIMARY);
+    ok1(false);
+  } catch (...) {
+    ok1(true);
+  }
+
+  /* a waypoint with more files than the cache can count must not be
+     written with a truncated file list */
+  Waypoints many_files;
+  Waypoint wp = org_wp.front();
+  for (unsigned i = 0; i < 256; ++i)
+    wp.files_embed.emplace_front(_T("x.txt"));
+  many_files.Append(std::move(wp));
+
+  StringOutputStream sos2;
+  try {
+    WithBufferedOutputStream(sos2, [&](BufferedOutputStream &bos){
+      SaveWaypointCache(bos, many_files);
+    });
+    ok1(false);
+  } catch (...) {
+    ok1(true);
+  }
+}
+
 static wp_vector
 CreateOriginalWaypoints()
 {
@@ -420,7 +483,7 @@ int main()
 {
   wp_vector org_wp = CreateOriginalWaypoints();
 
-  plan_tests(451);
+  plan_tests(451 + 6 + 12 * 5);
 
   TestWinPilot(org_wp);
   TestSeeYou(org_wp);
@@ -431,6 +494,7 @@ int main()
   TestCompeGPS(org_wp);
   TestCompeGPS_UTM(org_wp);
   TestCupWriter(org_wp);
+  TestCache(org_wp);
 
   return exit_status();
 }
@@ -5,7 +5,9 @@
 #include "Geo/GeoVector.hpp"
 #include "test_debug.hpp"
 
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 #include <stdio.h>
 #include <tchar.h>
@@ -218,6 +220,68 @@ TestGetNearest(const Waypoints &waypoints, const GeoPoint &center)
   ok1(waypoint->original_id == 6);
 }
 
+static void
+TestVisitNearest(const Waypoints &waypoints, const GeoPoint &center,
+                 double range, unsigned n,
+                 bool (*predicate)(const Waypoint &),
+                 std::initializer_list<unsigned> expected)
+{
+  std::vector<unsigned> found;
+  waypoints.VisitNearest(center, range, n, predicate,
+                         [&found](const WaypointPtr &wp){
+                           found.push_back(wp->original_id);
+                         });
+  ok1(std::equal(found.begin(), found.end(),
+                 expected.begin(), expected.end()));
+}
+
+static constexpr bool
+AlwaysTrue(const Waypoint &) noexcept
+{
+  return true;
+}
+
+static constexpr bool
+IsLandable(const Waypoint &waypoint) noexcept
+{
+  return waypoint.IsLandable();
+}
+
+static void
+TestVisitNearest(const Waypoints &waypoints, const GeoPoint &center)
+{
+  TestVisitNearest(waypoints, center, 10500, 5, AlwaysTrue, {0, 1, 2, 3, 4});
+  TestVisitNearest(waypoints, center, 2500, 10, AlwaysTrue, {0, 1, 2});
+  TestVisitNearest(waypoints, center, 10500, 0, AlwaysTrue, {});
+  TestVisitNearest(waypoints, center, 100000, 5, IsLandable, {0, 3, 6, 7, 9});
+  TestVisitNearest(waypoints, center, 100000, 3, OriginalIDAbove5, {6, 7, 8});
+
+  /* the same results as a full range scan, sorted by distance */
+  const GeoPoint location = GeoVector(42000, Angle::Degrees(123)).EndPoint(center);
+  std::vector<WaypointPtr> all;
+  waypoints.VisitWithinRange(location, 1000000, [&all](const WaypointPtr &wp){
+    all.push_back(wp);
+  });
+  std::sort(all.begin(), all.end(), [location](const WaypointPtr &a, const WaypointPtr &b){
+    return a->location.DistanceS(location) < b->location.DistanceS(location);
+  });
+
+  std::vector<WaypointPtr> nearest;
+  waypoints.VisitNearest(location, 1000000, 20, AlwaysTrue,
+                         [&nearest](const WaypointPtr &wp){
+                           nearest.push_back(wp);
+                         });
+  ok1(nearest.size() == 20);
+
+  /* the search is done on the flat projection, so allow a small
+     error when comparing with the geodesic distances */
+  ok1(std::equal(nearest.begin(), nearest.end(), all.begin(),
+                 [location](const WaypointPtr &a, const WaypointPtr &b){
+                   return fabs(a->location.DistanceS(location) -
+                               b->location.DistanceS(location)) < 100;
+                 }));
+}
+
 static void
 TestIterator(const Waypoints &waypoints)
 {
@@ -285,7 +349,7 @@ main(int argc, char** argv)
   if (!ParseArgs(argc, argv))
     return 0;
 
-  plan_tests(52);
+  plan_tests(59);
 
   Waypoints waypoints;
   GeoPoint center(Angle::Degrees(51.4), Angle::Degrees(7.85));
@@ -301,6 +365,7 @@ main(int argc, char** argv)
   TestNamePrefixVisitor(waypoints);
   TestRangeVisitor(waypoints, center);
   TestGetNearest(waypoints, center);
+  TestVisitNearest(waypoints, center);
   TestIterator(waypoints);
 
   ok(TestCopy(waypoints), "waypoint copy", 0);
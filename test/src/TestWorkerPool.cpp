@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "thread/WorkerPool.hpp"
+#include "TestUtil.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * Each item must be processed exactly once, and the result must be
+ * stored at its index.
+ */
+static void
+TestCoverage(WorkerPool &pool, std::size_t size, std::size_t min_chunk)
+{
+  std::vector<std::atomic_uint> count(size);
+  std::vector<std::size_t> result(size);
+
+  pool.ForEachChunk(size, min_chunk, [&](std::size_t begin, std::size_t end){
+    for (std::size_t i = begin; i < end; ++i) {
+      ++count[i];
+      result[i] = i * i;
+    }
+  });
+
+  bool ok = true;
+  for (std::size_t i = 0; i < size; ++i)
+    if (count[i] != 1 || result[i] != i * i)
+      ok = false;
+
+  ok1(ok);
+}
+
+/**
+ * Small ranges are processed by the calling thread.
+ */
+static void
+TestSmall(WorkerPool &pool)
+{
+  const auto caller = std::this_thread::get_id();
+  bool inline_only = true;
+  unsigned n_chunks = 0;
+
+  pool.ForEachChunk(31, 16, [&](std::size_t, std::size_t){
+    ++n_chunks;
+    if (std::this_thread::get_id() != caller)
+      inline_only = false;
+  });
+
+  ok1(inline_only);
+  ok1(n_chunks == 1);
+}
+
+int main()
+{
+  plan_tests(10);
+
+  const unsigned n_cpus = WorkerPool::GetDefaultConcurrency(64);
+  ok1(n_cpus >= 1 && n_cpus <= 64);
+
+  /* more threads than CPUs, so they interleave even on a single
+     CPU */
+  WorkerPool pool("Test", 4);
+
+  TestCoverage(pool, 0, 16);
+  TestCoverage(pool, 1, 16);
+  TestCoverage(pool, 100, 16);
+  TestCoverage(pool, 1000, 1);
+
+  /* the threads are reused for the next job */
+  for (unsigned i = 0; i < 2; ++i)
+    TestCoverage(pool, 1001, 8);
+
+  TestSmall(pool);
+
+  ok1(pool.GetConcurrency() == 4);
+
+  return exit_status();
+}
@@ -10,6 +10,11 @@ class ZeroFinderTest: public ZeroFinder
   unsigned func;
 
 public:
+  /**
+   * The x value f() was last called with.
+   */
+  double last_x;
+
   ZeroFinderTest(double x_min, double x_max, unsigned _func = 0) :
     ZeroFinder(x_min, x_max, 0.0001), func(_func) {}
 
@@ -19,6 +24,8 @@ public:
 double
 ZeroFinderTest::f(const double x) noexcept
 {
+  last_x = x;
+
   if (func == 0)
     return 2 * x * x - 3 * x - 5;
 
@@ -35,7 +42,7 @@ ZeroFinderTest::f(const double x) noexcept
 
 int main()
 {
-  plan_tests(18);
+  plan_tests(29);
 
   ZeroFinderTest zf(-100, 100, 0);
   ok1(equals(zf.find_zero(-150), -1));
@@ -43,6 +50,9 @@ int main()
   // ok1(equals(zf.find_zero(140), 2.5)); ???
   ok1(equals(zf.find_zero(140), -1));
 
+  ok1(equals(zf.find_zero_near(-1.2, 0.1), -1));
+  ok1(equals(zf.find_zero_near(2, 0.1), 2.5));
+
   ok1(equals(zf.find_min(-150), 0.75));
   ok1(equals(zf.find_min(0), 0.75));
   ok1(equals(zf.find_min(150), 0.75));
@@ -51,11 +61,28 @@ int main()
   ok1(equals(zf2.find_zero(-150), 2.5));
   ok1(equals(zf2.find_zero(0), 2.5));
   ok1(equals(zf2.find_zero(140), 2.5));
+  ok1(equals(zf2.find_zero_near(2.4, 0.01), 2.5));
+  ok1(equals(zf2.find_zero_near(90, 0.01), 2.5));
+
+  /* the upper end is clamped and close enough to the zero, while only
+     the lower end is widened; f() must be called with the result
+     last, because callers rely on its side effects */
+  ZeroFinderTest zf6(-100, 2.5 - 1e-10, 0);
+  ok1(equals(zf6.find_zero_near(2.45, 0.1), 2.5));
+  ok1(zf6.last_x == 2.5 - 1e-10);
 
   ZeroFinderTest zf3(0, 10, 1);
   ok1(equals(zf3.find_zero(-150), 1.584963));
   ok1(equals(zf3.find_zero(1), 1.584963));
   ok1(equals(zf3.find_zero(140), 1.584963));
+  ok1(equals(zf3.find_zero_near(0, 0.1), 1.584963));
+  ok1(equals(zf3.find_zero_near(1.58, 0.001), 1.584963));
+
+  // no zero in the range
+  ZeroFinderTest zf5(3, 10, 1);
+  ok1(equals(zf5.find_zero(5), 3));
+  ok1(equals(zf5.find_zero_near(5, 0.1), 3));
+  ok1(equals(zf5.find_zero_near(10, 0.1), 3));
 
   ZeroFinderTest zf4(0, M_PI + 1, 2);
   ok1(equals(zf4.find_zero(-150), M_PI_2));